@@ -124,6 +124,13 @@ typedef enum {
     SHARE_MEMORY_MODE_SET_FROM_EXTERNAL = 2
 } ShareMemoryMode;
 
+typedef enum {
+    // default, reuse blob memory greedily in layer order
+    MEMORY_PLAN_MODE_DEFAULT = 0,
+    // pack all blobs into one arena by their lifetime and size, needs less forward memory
+    MEMORY_PLAN_MODE_INTERVAL = 1
+} MemoryPlanMode;
+
 typedef enum {
     MODEL_TYPE_TNN      = 0x0001,
     MODEL_TYPE_NCNN     = 0x0100,
@@ -155,6 +162,9 @@ struct PUBLIC NetworkConfig {
     // raidnet instances not share memory with others
     ShareMemoryMode share_memory_mode = SHARE_MEMORY_MODE_DEFAULT;
 
+    // how blob memory is planned, works with all share memory modes
+    MemoryPlanMode memory_plan_mode = MEMORY_PLAN_MODE_DEFAULT;
+
     // dependent library path
     std::vector<std::string> library_path = {};
 
@@ -167,6 +177,21 @@ struct PUBLIC NetworkConfig {
     // network init or reshape may cost more time to select opt kernel implement if enable tune kernel
     // cache_path can set to store tune kernel info.
     bool enable_tune_kernel = false;
+
+    // run independent layers concurrently on x86, arm and naive devices, the cpu threads
+    // are split between the running layers. It helps branchy models with small layers.
+    bool enable_parallel_layers = false;
+
+    // recurrent layers without initial state inputs carry their hidden and cell state over to
+    // the next Forward instead of starting from zero, for streaming a sequence chunk by chunk.
+    // call Instance::ResetRecurrentState to start a new sequence. Supported by x86 LSTMONNX.
+    bool enable_stateful_recurrence = false;
+
+    // number of input shapes whose reshaped blob dims and layer params are kept, a Reshape back to
+    // a kept shape restores them instead of inferring the shape of every layer. The least recently
+    // used shape is dropped when the cache is full, 0 disables the cache.
+    // see Instance::GetReshapeCacheStats for the hit and miss counters.
+    int reshape_cache_capacity = 0;
 };
 
 struct PUBLIC ModelConfig {
@@ -181,6 +206,10 @@ struct PUBLIC ModelConfig {
     // atlas model need one param: config string.
     std::vector<std::string> params = {};
 
+    // tnn model only: if true, params[1] is the path of the model file instead of its content.
+    // the file is mapped into memory and the weights are used in place without copying them.
+    bool map_model_file = false;
+
     // params can also add extra config for specific layer
     // tnn model use [layer_name:string] as key-value pair,
     // to add extra config for some layer.
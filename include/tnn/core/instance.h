@@ -35,6 +35,17 @@ class AbstractModelInterpreter;
 
 struct LayerInfo;
 
+// hit and miss counters of the reshape cache for one set of input shapes
+struct PUBLIC ReshapeCacheStat {
+    InputShapesMap shapes;
+    // reshapes to these shapes served from the cache
+    int hits = 0;
+    // reshapes to these shapes that inferred the shape of every layer
+    int misses = 0;
+    // true if the reshaped state of these shapes is still kept
+    bool cached = false;
+};
+
 #ifdef FORWARD_CALLBACK_ENABLE
 typedef std::function<void(std::vector<Blob*>& blobs, LayerInfo* info)> BlobStatisticCallback;
 #endif  // end of FORWARD_CALLBACK_ENABLE
@@ -100,6 +111,12 @@ public:
     // set threads run on cpu
     Status SetCpuNumThreads(int num_threads);
 
+    // drop the recurrent state kept across Forward calls, see NetworkConfig::enable_stateful_recurrence
+    Status ResetRecurrentState();
+
+    // get the hit and miss counters of every input shapes seen, see NetworkConfig::reshape_cache_capacity
+    Status GetReshapeCacheStats(std::vector<ReshapeCacheStat>& stats);
+
 #if TNN_PROFILE
 public:
     /**start to profile each layer, dont call this func if you only want to profile the whole mode*/
@@ -23,6 +23,7 @@
 #include "tnn/core/mat.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
+#include "tnn/utils/mat_utils.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -38,6 +39,13 @@ struct PUBLIC MatConvertParam {
 
 bool NeedDoScaleBias(const MatConvertParam& param);
 
+// crop and resize applied to the image before it is converted to the blob, the crop
+// region is resized to the blob height and width. width or height 0 means the whole image.
+struct PUBLIC MatPreprocessParam {
+    CropParam crop;
+    InterpType interp_type = INTERP_TYPE_LINEAR;
+};
+
 class BlobConverterAcc;
 class PUBLIC BlobConverter {
 public:
@@ -48,11 +56,23 @@ public:
     Status ConvertToMatAsync(Mat& image, MatConvertParam param, void* command_queue);
     Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue);
 
+    // @brief color convert (nv12/nv21 to bgr), crop, resize and scale the image into the blob.
+    // x86 and arm do it in one pass without intermediate mats.
+    Status ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                        void* command_queue);
+
+    // @brief crop every box of the image, resize it to the blob height and width and scale it into
+    // blob batch i. the blob batch must equal the box count, box i reads image batch i unless the
+    // image has one batch.
+    Status ConvertFromMatWithBoxes(Mat& image, std::vector<CropParam> boxes, InterpType interp_type,
+                                   MatConvertParam param, void* command_queue);
+
 private:
     Blob* blob_ = nullptr;
     std::shared_ptr<BlobConverterAcc> impl_ = nullptr;
 
     Status CheckScaleBiasInParam(Mat& image, MatConvertParam& param, bool convert_to_mat);
+    Status CheckCropParam(Mat& image, const CropParam& crop);
     
 };
 
@@ -94,6 +94,12 @@ public:
 
     //src and dst device type must be same. param top, bottom, left and right must be non-negative.
     static Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue);
+
+    //src and dst device type must be same. crop every box of src and resize it to dst.GetWidth() x dst.GetHeight(),
+    //box i is written to dst batch i. src batch must be 1 or equal to the box count, box i reads src batch i in the
+    //latter case. dst mat type is the src mat type, except nv12 and nv21 which are resized to N8UC3.
+    static Status CropAndResize(Mat& src, Mat& dst, std::vector<CropParam> boxes, InterpType type,
+                                void* command_queue);
 };
 
 }  // namespace TNN_NS
@@ -33,6 +33,15 @@ Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+Status AbstractNetwork::ResetRecurrentState() {
+    return TNN_OK;
+}
+
+Status AbstractNetwork::GetReshapeCacheStats(std::vector<ReshapeCacheStat> &stats) {
+    stats.clear();
+    return TNN_OK;
+}
+
 #if TNN_PROFILE
 void AbstractNetwork::StartProfile() {
     LOGI("warning: to make profiling work, subclass should implement the func: StartProfile\n");
@@ -93,6 +93,12 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief drop the recurrent state kept across forward calls
+    virtual Status ResetRecurrentState();
+
+    // @brief get the hit and miss counters of the reshape cache
+    virtual Status GetReshapeCacheStats(std::vector<ReshapeCacheStat> &stats);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
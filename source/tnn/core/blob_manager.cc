@@ -15,6 +15,7 @@
 #include "tnn/core/blob_manager.h"
 
 #include <algorithm>
+#include <climits>
 #include <cstring>
 #include <set>
 
@@ -172,6 +173,13 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         BlobMemory *blob_memory = NULL;
         blob_memory             = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, true);
         blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+        if (UseIntervalMemoryPlan(info)) {
+            // input blob memory is never reused
+            BlobMemoryLifetime lifetime;
+            lifetime.begin                     = INT_MIN;
+            lifetime.end                       = INT_MAX;
+            blob_memory_lifetime_[blob_memory] = lifetime;
+        }
     }
 
     /*
@@ -199,6 +207,16 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 int use_count = GetBlobUseCount(layer_index, current_blob_name);
 
                 BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+                if (UseIntervalMemoryPlan(info)) {
+                    // every blob gets its own memory, the offset is planned by lifetime later
+                    BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, true);
+                    blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                    BlobMemoryLifetime lifetime;
+                    lifetime.begin                     = (int)layer_index;
+                    lifetime.end                       = GetBlobLastUseIndex((int)layer_index, current_blob_name);
+                    blob_memory_lifetime_[blob_memory] = lifetime;
+                    continue;
+                }
                 // find an available BlobMemory
                 BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
                 blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
@@ -216,6 +234,9 @@ Status BlobManager::AllocateBlobMemory(int flag) {
             if (input_shapes_map.count(current_blob_name) == 0) {
                 std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
                     blob_memory_mapping_.find(current_blob);
+                if (blob_memory_lifetime_.count(blob_memory_iter->second) > 0) {
+                    continue;
+                }
                 ASSERT(blob_memory_iter->second->GetUseCount() > 0);
                 blob_memory_iter->second->DecrementUseCount();
                 if (blob_memory_iter->second->GetUseCount() == 0) {
@@ -228,12 +249,36 @@ Status BlobManager::AllocateBlobMemory(int flag) {
 
     Status status = TNN_OK;
 
+    if (!blob_memory_lifetime_.empty()) {
+        std::set<BlobMemory *> interval_blob_memory;
+        for (auto iter : blob_memory_lifetime_) {
+            interval_blob_memory.insert(iter.first);
+        }
+        MemoryIntervalAssignStrategy::PlanBlobMemoryOffset(interval_blob_memory, blob_memory_lifetime_,
+                                                           blob_memory_offset_);
+    }
+
     do {
         if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT) {
             // The default strategy allocated the blob memory separately.
             MemorySeperateAssignStrategy strategy;
             for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-                status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+                if (blob_memory_pool_iter.first == 1 && !blob_memory_lifetime_.empty()) {
+                    // The interval plan puts all 1d blob memory in one arena.
+                    if (interval_memory_ != nullptr) {
+                        device_->Free(interval_memory_);
+                        interval_memory_ = nullptr;
+                    }
+                    BlobMemorySizeInfo info;
+                    info.data_type = DATA_TYPE_INT8;
+                    info.dims.push_back(GetBlobMemoryPoolSize(1));
+                    status = device_->Allocate(&interval_memory_, info);
+                    BREAK_IF(status != TNN_OK);
+                    auto interval_strategy = CreateUnifyAssignStrategy(1, interval_memory_);
+                    status = blob_memory_pool_iter.second->AssignAllBlobMemory(*interval_strategy);
+                } else {
+                    status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+                }
                 BREAK_IF(status != TNN_OK);
             }
             BREAK_IF(status != TNN_OK);
@@ -242,14 +287,14 @@ Status BlobManager::AllocateBlobMemory(int flag) {
             // The share_on_thread strategy may share memory of different models-
             // within the same thread.
             for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-                int forward_memory_size   = blob_memory_pool_iter.second->GetAllBlobMemorySize();
+                int forward_memory_size   = GetBlobMemoryPoolSize(blob_memory_pool_iter.first);
                 SharedMemory share_memory = SharedMemoryManager::GetSharedMemory(
                         forward_memory_size, init_thread_id_, device_,
                         config_.device_id, this, status);
                 BREAK_IF(status != TNN_OK);
 		shared_memory_allocated_ = true;
-                MemoryUnifyAssignStrategy strategy(share_memory.shared_memory_data);
-                status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+                auto strategy = CreateUnifyAssignStrategy(blob_memory_pool_iter.first, share_memory.shared_memory_data);
+                status = blob_memory_pool_iter.second->AssignAllBlobMemory(*strategy);
                 BREAK_IF(status != TNN_OK);
             }
             BREAK_IF(status != TNN_OK);
@@ -264,6 +309,25 @@ Status BlobManager::AllocateBlobMemory(int flag) {
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
  */
+/*
+ * Index of the last layer reading the blob, output blobs are kept alive all the time.
+ */
+int BlobManager::GetBlobLastUseIndex(int layer_index, std::string current_blob_name) {
+    if (net_structure_->outputs.count(current_blob_name) > 0) {
+        return INT_MAX;
+    }
+    int last_use_index = layer_index;
+    for (size_t next_layer_id = layer_index + 1; next_layer_id < net_structure_->layers.size(); ++next_layer_id) {
+        LayerInfo *next_layer_info = net_structure_->layers[next_layer_id].get();
+        for (auto blob_name : next_layer_info->inputs) {
+            if (blob_name == current_blob_name) {
+                last_use_index = (int)next_layer_id;
+            }
+        }
+    }
+    return last_use_index;
+}
+
 int BlobManager::GetBlobUseCount(int layer_index, std::string current_blob_name) {
     int use_count                            = 0;
     std::set<std::string> &output_blob_names = net_structure_->outputs;
@@ -296,13 +360,18 @@ Status BlobManager::DeInit() {
         delete memory_mode_state_;
         memory_mode_state_ = NULL;
     }
+
+    if (interval_memory_ != nullptr) {
+        device_->Free(interval_memory_);
+        interval_memory_ = nullptr;
+    }
     return TNN_OK;
 }
 
 void BlobManager::OnSharedForwardMemoryChanged(void *memory) {
-    MemoryUnifyAssignStrategy strategy(memory);
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-        blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+        auto strategy = CreateUnifyAssignStrategy(blob_memory_pool_iter.first, memory);
+        blob_memory_pool_iter.second->AssignAllBlobMemory(*strategy);
     }
     BindBlobMemory();
 }
@@ -315,10 +384,10 @@ Status BlobManager::SetForwardMemory(void *memory) {
     if (config_.share_memory_mode != SHARE_MEMORY_MODE_SET_FROM_EXTERNAL) {
         return Status(TNNERR_NOT_SUPPORT_SET_FORWARD_MEM, "set memory from external is unsupported");
     }
-    MemoryUnifyAssignStrategy strategy(memory);
     Status status = TNN_OK;
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-        status = blob_memory_pool_iter.second->AssignAllBlobMemory(strategy);
+        auto strategy = CreateUnifyAssignStrategy(blob_memory_pool_iter.first, memory);
+        status = blob_memory_pool_iter.second->AssignAllBlobMemory(*strategy);
     }
     if (status == TNN_OK) {
         BindBlobMemory();
@@ -344,11 +413,60 @@ void BlobManager::BindBlobMemory() {
 int BlobManager::GetAllBlobMemorySize() {
     int mem_size_all_blob = 0;
     for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
-        mem_size_all_blob += blob_memory_pool_iter.second->GetAllBlobMemorySize();
+        mem_size_all_blob += GetBlobMemoryPoolSize(blob_memory_pool_iter.first);
     }
     return mem_size_all_blob;
 }
 
+/*
+ * The interval plan only works for 1d blob memory, which can be addressed by
+ * bytes offset in one arena. 2d blob memory such as opencl image keeps the
+ * greedy reuse plan.
+ */
+bool BlobManager::UseIntervalMemoryPlan(BlobMemorySizeInfo &info) {
+    return config_.memory_plan_mode == MEMORY_PLAN_MODE_INTERVAL && info.dims.size() == 1;
+}
+
+std::shared_ptr<MemoryAssignStrategy> BlobManager::CreateUnifyAssignStrategy(int dims, void *memory) {
+    if (dims == 1 && !blob_memory_lifetime_.empty()) {
+        return std::make_shared<MemoryIntervalAssignStrategy>(memory, blob_memory_lifetime_);
+    }
+    return std::make_shared<MemoryUnifyAssignStrategy>(memory);
+}
+
+int BlobManager::GetBlobMemoryPoolSize(int dims) {
+    auto blob_memory_pool = blob_memory_pool_map_[dims];
+    if (dims == 1 && !blob_memory_lifetime_.empty()) {
+        MemoryIntervalAssignStrategy strategy(nullptr, blob_memory_lifetime_);
+        return blob_memory_pool->GetAllBlobMemorySize(strategy);
+    }
+    return blob_memory_pool->GetAllBlobMemorySize();
+}
+
+bool BlobManager::IsBlobMemoryOverlapped(Blob *blob_a, Blob *blob_b) {
+    auto iter_a = blob_memory_mapping_.find(blob_a);
+    auto iter_b = blob_memory_mapping_.find(blob_b);
+    if (iter_a == blob_memory_mapping_.end() || iter_b == blob_memory_mapping_.end()) {
+        return false;
+    }
+    BlobMemory *memory_a = iter_a->second;
+    BlobMemory *memory_b = iter_b->second;
+    if (memory_a == memory_b) {
+        return true;
+    }
+
+    auto offset_a = blob_memory_offset_.find(memory_a);
+    auto offset_b = blob_memory_offset_.find(memory_b);
+    if (offset_a == blob_memory_offset_.end() || offset_b == blob_memory_offset_.end()) {
+        return false;
+    }
+    auto info_a  = memory_a->GetBlobMemorySizeInfo();
+    auto info_b  = memory_b->GetBlobMemorySizeInfo();
+    int64_t end_a = offset_a->second + GetBlobMemoryBytesSize(info_a);
+    int64_t end_b = offset_b->second + GetBlobMemoryBytesSize(info_b);
+    return offset_a->second < end_b && offset_b->second < end_a;
+}
+
 Status BlobManager::GetAllInputBlobs(BlobMap &blobs) {
     blobs = input_blobs_;
     return TNN_OK;
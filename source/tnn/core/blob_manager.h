@@ -27,6 +27,7 @@
 #include "tnn/interpreter/net_structure.h"
 #include "tnn/memory_manager/blob_memory.h"
 #include "tnn/memory_manager/blob_memory_pool.h"
+#include "tnn/memory_manager/memory_interval_assign_strategy.h"
 #include "tnn/memory_manager/memory_assign_strategy.h"
 #include "tnn/memory_manager/memory_mode_state.h"
 #include "tnn/memory_manager/shared_memory_manager.h"
@@ -53,6 +54,9 @@ public:
     // @param name blob name
     Blob *GetBlob(std::string name);
 
+    // @brief check whether the memory planned for two blobs overlaps
+    bool IsBlobMemoryOverlapped(Blob *blob_a, Blob *blob_b);
+
     // @brief check blob memory state for different share memory mode
     Status CheckBlobMemoryState();
 
@@ -82,6 +86,10 @@ public:
 protected:
     void BindBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    int GetBlobLastUseIndex(int layer_index, std::string current_blob_name);
+    bool UseIntervalMemoryPlan(BlobMemorySizeInfo &info);
+    std::shared_ptr<MemoryAssignStrategy> CreateUnifyAssignStrategy(int dims, void *memory);
+    int GetBlobMemoryPoolSize(int dims);
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -93,6 +101,10 @@ protected:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    // lifetime and planned offset of blob memory for MEMORY_PLAN_MODE_INTERVAL
+    BlobMemoryLifetimeMap blob_memory_lifetime_;
+    std::map<BlobMemory *, int> blob_memory_offset_;
+    void *interval_memory_ = nullptr;
     bool shared_memory_allocated_;
 
     std::thread::id init_thread_id_;
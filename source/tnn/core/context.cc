@@ -46,6 +46,10 @@ Status Context::SetNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+int Context::GetNumThreads() {
+    return 1;
+}
+
 void Context::SetPrecision(Precision precision) {
     precision_ = precision;
 }
@@ -62,6 +66,22 @@ bool Context::GetEnableTuneKernel() {
     return enable_tune_kernel_;
 }
 
+void Context::SetEnableStatefulRecurrence(bool enable_stateful_recurrence) {
+    enable_stateful_recurrence_ = enable_stateful_recurrence;
+}
+
+bool Context::GetEnableStatefulRecurrence() {
+    return enable_stateful_recurrence_;
+}
+
+void Context::ResetRecurrentState() {
+    recurrent_state_version_++;
+}
+
+int Context::GetRecurrentStateVersion() {
+    return recurrent_state_version_;
+}
+
 void Context::SetCachePath(std::string cache_path) {
     cache_path_ = cache_path;
 }
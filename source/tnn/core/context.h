@@ -59,6 +59,9 @@ public:
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads);
 
+    // @brief get threads run on device
+    virtual int GetNumThreads();
+
     void SetPrecision(Precision precision);
 
     Precision GetPrecision();
@@ -67,6 +70,15 @@ public:
 
     bool GetEnableTuneKernel();
 
+    void SetEnableStatefulRecurrence(bool enable_stateful_recurrence);
+
+    bool GetEnableStatefulRecurrence();
+
+    // @brief recurrent layers drop the state they kept once the version changes
+    void ResetRecurrentState();
+
+    int GetRecurrentStateVersion();
+
     void SetCachePath(std::string cache_path);
 
     std::string GetCachePath();
@@ -90,6 +102,8 @@ protected:
 protected:
     Precision precision_ = PRECISION_AUTO;
     bool enable_tune_kernel_ = true;
+    bool enable_stateful_recurrence_ = false;
+    int recurrent_state_version_ = 0;
     std::string cache_path_ = ""; // dir to save cache files
     std::string cache_file_path_ = "";
 };
@@ -16,6 +16,7 @@
 
 #include <string.h>
 
+#include "tnn/core/abstract_layer_acc.h"
 #include "tnn/core/blob_int8.h"
 #include "tnn/core/profile.h"
 #include "tnn/interpreter/default_model_interpreter.h"
@@ -55,6 +56,22 @@ Status DefaultNetwork::SetCpuNumThreads(int num_threads) {
         return Status(TNNERR_CONTEXT_ERR, "context is nil");
 }
 
+Status DefaultNetwork::ResetRecurrentState() {
+    if (!context_) {
+        return Status(TNNERR_CONTEXT_ERR, "context is nil");
+    }
+    context_->ResetRecurrentState();
+    return TNN_OK;
+}
+
+Status DefaultNetwork::GetReshapeCacheStats(std::vector<ReshapeCacheStat> &stats) {
+    stats.clear();
+    if (reshape_plan_cache_) {
+        reshape_plan_cache_->GetStats(stats);
+    }
+    return TNN_OK;
+}
+
 /*
  * The Network holds blob, blobmanager, layers etc.
  * Those object is initialized in this function.
@@ -88,6 +105,7 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
 #endif
     context_->SetPrecision(net_config.precision);
     context_->SetEnableTuneKernel(net_config.enable_tune_kernel);
+    context_->SetEnableStatefulRecurrence(net_config.enable_stateful_recurrence);
 
     if(!net_config.cache_path.empty()) {
         auto params_md5 = default_interpreter->GetParamsMd5();
@@ -126,6 +144,15 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
 
     net_structure_ = net_structure;
     net_resource_ = net_resource;
+
+    // constant folding infers shapes in forward, only cache the reshape of normal runtime
+    if (runtime_model_ == RUNTIME_MODE_NORMAL && net_config.reshape_cache_capacity > 0) {
+        BlobMap input_blobs;
+        blob_manager_->GetAllInputBlobs(input_blobs);
+        reshape_plan_cache_ = std::make_shared<ReshapePlanCache>(net_config.reshape_cache_capacity);
+        ret = reshape_plan_cache_->Init(layers_, input_blobs);
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
     
     ret = context_->OnInstanceReshapeBegin();
     RETURN_ON_NEQ(ret, TNN_OK);
@@ -134,9 +161,58 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     RETURN_ON_NEQ(ret, TNN_OK);
 
     ret = context_->OnInstanceReshapeEnd();
+    RETURN_ON_NEQ(ret, TNN_OK);
+
+    BuildForwardPlan();
+
+    if (net_config.enable_parallel_layers) {
+        ret = InitParallelExecutor();
+    }
     return ret;
 }
 
+/*
+ * The parallel executor runs independent layers at the same time. It is only used
+ * on cpu devices, and falls back to sequential forward if some blob is allocated
+ * in forward, because that memory is not covered by the blob memory reuse plan.
+ */
+Status DefaultNetwork::InitParallelExecutor() {
+    parallel_executor_ = nullptr;
+
+    auto device_type = config_.device_type;
+    if (runtime_model_ != RUNTIME_MODE_NORMAL ||
+        (device_type != DEVICE_X86 && device_type != DEVICE_ARM && device_type != DEVICE_NAIVE)) {
+        LOGD("parallel layers is not supported, use sequential forward\n");
+        return TNN_OK;
+    }
+
+    for (auto layer : layers_) {
+        for (auto blob : layer->GetInputBlobs()) {
+            if (blob->NeedAllocateInForward()) {
+                LOGD("blob %s is allocated in forward, use sequential forward\n", blob->GetBlobDesc().name.c_str());
+                return TNN_OK;
+            }
+        }
+        for (auto blob : layer->GetOutputBlobs()) {
+            if (blob->NeedAllocateInForward()) {
+                LOGD("blob %s is allocated in forward, use sequential forward\n", blob->GetBlobDesc().name.c_str());
+                return TNN_OK;
+            }
+        }
+    }
+
+    auto executor = std::make_shared<ParallelLayerExecutor>();
+    auto status   = executor->Init(layers_, blob_manager_);
+    if (status != TNN_OK) {
+        LOGE("init parallel layer executor failed: %s, use sequential forward\n", status.description().c_str());
+        return TNN_OK;
+    }
+    if (executor->GetMaxParallelism() > 1) {
+        parallel_executor_ = executor;
+    }
+    return TNN_OK;
+}
+
 static inline bool IsLayoutReformatLayer(std::shared_ptr<LayerInfo> layer) {
     if (layer->type == LAYER_REFORMAT) {
         auto param = dynamic_cast<ReformatLayerParam *>(layer->param.get());
@@ -495,11 +571,19 @@ Status DefaultNetwork::DoReshape() {
     }
 
     ret = context_->OnInstanceReshapeEnd();
+    if (ret != TNN_OK) {
+        return ret;
+    }
 
+    BuildForwardPlan();
     return ret;
 }
 
 Status DefaultNetwork::DeInit() {
+    parallel_executor_ = nullptr;
+    reshape_plan_cache_ = nullptr;
+    forward_plan_.clear();
+
     for (size_t i = 0; i < layers_.size(); i++) {
         if (layers_[i] != NULL) {
             delete layers_[i];
@@ -566,7 +650,21 @@ Status DefaultNetwork::Forward() {
     
     status = context_->OnInstanceForwardBegin();
     RETURN_ON_NEQ(status, TNN_OK);
-    
+
+#if !(DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB || TNN_PROFILE)
+    if (parallel_executor_ && context_->GetNumThreads() > 1) {
+        status = parallel_executor_->Forward(context_->GetNumThreads());
+        RETURN_ON_NEQ(status, TNN_OK);
+        context_->OnInstanceForwardEnd();
+        context_->Synchronize();
+        return status;
+    }
+#endif
+
+#if !(DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
+    status = ForwardPlan();
+    RETURN_ON_NEQ(status, TNN_OK);
+#else
     int cnt = 0;
     for (auto layer : layers_) {
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
@@ -629,11 +727,43 @@ Status DefaultNetwork::Forward() {
         
         cnt++;
     }
+#endif  // !(DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
     context_->OnInstanceForwardEnd();
     context_->Synchronize();
     return status;
 }
 
+void DefaultNetwork::BuildForwardPlan() {
+    forward_plan_.clear();
+    forward_plan_.reserve(layers_.size());
+    for (auto layer : layers_) {
+        forward_plan_.push_back(layer->GetForwardStep());
+    }
+}
+
+Status DefaultNetwork::ForwardPlan() {
+    Status status = TNN_OK;
+    for (const auto &step : forward_plan_) {
+        if (step.acc == nullptr) {
+            status = step.layer->Forward();
+        } else {
+            status = step.acc->BeforeForward(*step.inputs, *step.outputs);
+            if (status == TNN_OK && step.run_acc) {
+                status = step.acc->Forward(*step.inputs, *step.outputs);
+            }
+            if (status == TNN_OK) {
+                status = step.acc->AfterForward(*step.inputs, *step.outputs);
+            }
+        }
+        LOGD("layer name: %s, forward result: %d \n", step.layer->GetLayerName().c_str(), (int)status);
+        if (status != TNN_OK) {
+            LOGE("Forward error %s, exit\n", status.description().c_str());
+            return status;
+        }
+    }
+    return status;
+}
+
 #ifdef FORWARD_CALLBACK_ENABLE
 Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
     Status result = TNN_OK;
@@ -679,10 +809,8 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
     }
 
     context_->OnInstanceForwardBegin();
-    for (auto layer : layers_) {
-        result = layer->Forward();
-        RETURN_ON_NEQ(result, TNN_OK);
-    }
+    result = ForwardPlan();
+    RETURN_ON_NEQ(result, TNN_OK);
     context_->OnInstanceForwardEnd();
     return result;
 }
@@ -704,12 +832,28 @@ std::string DefaultNetwork::GenerateCacheFileName(ModelConfig &model_config, std
 }
 
 Status DefaultNetwork::ReshapeLayers() {
+    if (reshape_plan_cache_) {
+        // the input shapes were seen before, the layer accs still update their own state
+        bool restored = false;
+        RETURN_ON_NEQ(reshape_plan_cache_->Restore(restored), TNN_OK);
+        if (restored) {
+            for (auto cur_layer : layers_) {
+                RETURN_ON_NEQ(cur_layer->ReshapeAcc(), TNN_OK);
+            }
+            return TNN_OK;
+        }
+    }
+
     for (auto cur_layer : layers_) {
         auto status = cur_layer->Reshape();
         RETURN_ON_NEQ(status, TNN_OK);
         //Note output shape may not change after reshape for const folder, but will do change after forward because shape may be determined at rumtime
         LOGD("ReshapeLayers Output Shape: [%s]\n", cur_layer->GetOutputBlobs()[0]->GetBlobDesc().description().c_str());
     }
+
+    if (reshape_plan_cache_) {
+        return reshape_plan_cache_->Record();
+    }
     return TNN_OK;
 }
 
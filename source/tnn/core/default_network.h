@@ -24,7 +24,9 @@
 #include "tnn/core/common.h"
 #include "tnn/core/context.h"
 #include "tnn/core/macro.h"
+#include "tnn/core/parallel_layer_executor.h"
 #include "tnn/core/profile.h"
+#include "tnn/core/reshape_plan_cache.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/layer_resource.h"
@@ -92,6 +94,12 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief drop the recurrent state kept across forward calls
+    virtual Status ResetRecurrentState();
+
+    // @brief get the hit and miss counters of the reshape cache
+    virtual Status GetReshapeCacheStats(std::vector<ReshapeCacheStat> &stats);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -109,6 +117,13 @@ protected:
 
     std::string GenerateCacheFileName(ModelConfig &model_config, std::string& md5_str);
 
+    Status InitParallelExecutor();
+
+    // @brief precompile the forward steps of all layers, called after layers are reshaped
+    void BuildForwardPlan();
+    // @brief run the layers in order, no heap allocation
+    Status ForwardPlan();
+
     Status PrepareDoReshape(const InputShapesMap &inputs, bool& shape_changed);
     Status DoReshape();
 
@@ -117,6 +132,7 @@ protected:
     Context *GetContext();
 
     std::vector<BaseLayer *> layers_;
+    std::vector<LayerForwardStep> forward_plan_;
 
     BlobManager *blob_manager_ = nullptr;
     BlobMemoryPool *runtime_blob_pool_ = nullptr;
@@ -126,6 +142,10 @@ protected:
 
     NetworkConfig config_;
 
+    std::shared_ptr<ParallelLayerExecutor> parallel_executor_ = nullptr;
+
+    std::shared_ptr<ReshapePlanCache> reshape_plan_cache_ = nullptr;
+
     static std::mutex optimize_mtx_;
 
 private:
@@ -199,6 +199,14 @@ Status Instance::SetCpuNumThreads(int num_threads) {
     return network_->SetCpuNumThreads(num_threads);
 }
 
+Status Instance::ResetRecurrentState() {
+    return network_->ResetRecurrentState();
+}
+
+Status Instance::GetReshapeCacheStats(std::vector<ReshapeCacheStat>& stats) {
+    return network_->GetReshapeCacheStats(stats);
+}
+
 // set input Mat
 Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, std::string input_name) {
     if (!mat) {
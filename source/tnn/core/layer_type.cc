@@ -224,6 +224,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"NonMaxSuppression", LAYER_NON_MAX_SUPPRESSION},
     {"TopK", LAYER_TOPK},
     {"Scatter", LAYER_SCATTER},
+    {"MultiHeadAttention", LAYER_MULTI_HEAD_ATTENTION},
     // LAYER_INT8_RANGE
     // LAYER_TRT_ENGINE
 
@@ -238,6 +239,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"ConstantOfShape", LAYER_CONSTANT_OF_SHAPE},
     {"NonZero", LAYER_NONZERO},
     {"LSTMONNX", LAYER_LSTMONNX},
+    {"GRUONNX", LAYER_GRU},
     {"QuantizedSigmoid", LAYER_SIGMOID},
     {"StridedSliceV2", LAYER_STRIDED_SLICE_V2},
     {"Erf", LAYER_ERF},
@@ -250,6 +252,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"OneHot", LAYER_ONEHOT},
     {"CbamFusedReduce", LAYER_CBAM_FUSED_REDUCE},
     {"CbamFusedPooling", LAYER_CBAM_FUSED_POOLING},
+    {"FusedElementwise", LAYER_FUSED_ELEMENTWISE},
     {"Softsign", LAYER_SOFTSIGN},
     {"LogSoftmax", LAYER_LOGSOFTMAX},
     {"QuantizedReshape", LAYER_RESHAPE},
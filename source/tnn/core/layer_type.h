@@ -227,6 +227,7 @@ enum LayerType {
     LAYER_LESS                                              = 334,
     LAYER_NON_MAX_SUPPRESSION                               = 335,
     LAYER_SCATTER                                           = 336,
+    LAYER_MULTI_HEAD_ATTENTION                              = 337,
     LAYER_SWISH                                             = 401,
     LAYER_GLU                                               = 402,
 
@@ -237,6 +238,7 @@ enum LayerType {
 
     LAYER_CBAM_FUSED_REDUCE                                 = 800,
     LAYER_CBAM_FUSED_POOLING                                = 801,
+    LAYER_FUSED_ELEMENTWISE                                 = 802,
 
     // TNN Graph Matcher related LAYER_TYPES
     LAYER_DUMMY_TYPE                                        = 1000,
@@ -0,0 +1,288 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/parallel_layer_executor.h"
+
+#include <algorithm>
+#include <map>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+static thread_local int g_worker_index = 0;
+
+ParallelLayerExecutor::ParallelLayerExecutor()
+    : queued_tasks_(0), remaining_layers_(0), running_layers_(0), failed_(false) {}
+
+ParallelLayerExecutor::~ParallelLayerExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &thread : threads_) {
+        thread.join();
+    }
+}
+
+int ParallelLayerExecutor::GetWorkerIndex() {
+    return g_worker_index;
+}
+
+int ParallelLayerExecutor::GetMaxParallelism() {
+    return max_parallelism_;
+}
+
+static void AddEdge(std::vector<std::vector<int>> &successors, int from, int to) {
+    if (from < 0 || to < 0 || from == to) {
+        return;
+    }
+    successors[from].push_back(to);
+}
+
+Status ParallelLayerExecutor::Init(const std::vector<BaseLayer *> &layers, BlobManager *blob_manager) {
+    if (!threads_.empty()) {
+        return Status(TNNERR_NET_ERR, "ParallelLayerExecutor is already initialized");
+    }
+    if (blob_manager == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "blob manager is nil");
+    }
+
+    const int layer_count = (int)layers.size();
+    layers_               = layers;
+    successors_.assign(layer_count, {});
+
+    std::map<Blob *, int> producer;
+    std::map<Blob *, std::vector<int>> consumers;
+    for (int i = 0; i < layer_count; ++i) {
+        for (auto blob : layers_[i]->GetOutputBlobs()) {
+            producer[blob] = i;
+        }
+        for (auto blob : layers_[i]->GetInputBlobs()) {
+            consumers[blob].push_back(i);
+        }
+    }
+
+    // data dependency: a layer waits for the producers of its inputs
+    for (int i = 0; i < layer_count; ++i) {
+        for (auto blob : layers_[i]->GetInputBlobs()) {
+            auto iter = producer.find(blob);
+            if (iter != producer.end()) {
+                AddEdge(successors_, iter->second, i);
+            }
+        }
+    }
+
+    // memory dependency: blobs whose planned memory overlaps are written in sequential
+    // layer order, the writer of a blob must wait until every earlier blob living in
+    // the same bytes is produced and consumed by all of its readers.
+    std::vector<std::pair<int, Blob *>> produced;
+    for (auto iter : producer) {
+        produced.push_back(std::make_pair(iter.second, iter.first));
+    }
+    std::sort(produced.begin(), produced.end());
+    for (size_t i = 0; i < produced.size(); ++i) {
+        for (size_t j = i + 1; j < produced.size(); ++j) {
+            if (produced[i].first == produced[j].first ||
+                !blob_manager->IsBlobMemoryOverlapped(produced[i].second, produced[j].second)) {
+                continue;
+            }
+            int writer = produced[j].first;
+            AddEdge(successors_, produced[i].first, writer);
+            for (auto reader : consumers[produced[i].second]) {
+                AddEdge(successors_, reader, writer);
+            }
+        }
+    }
+
+    dependency_count_.assign(layer_count, 0);
+    std::vector<int> level(layer_count, 0);
+    for (int i = 0; i < layer_count; ++i) {
+        auto &next = successors_[i];
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        for (auto j : next) {
+            if (j < i) {
+                LOGE("ParallelLayerExecutor got layer %d depending on later layer %d\n", j, i);
+                return Status(TNNERR_NET_ERR, "ParallelLayerExecutor got invalid layer order");
+            }
+            dependency_count_[j]++;
+        }
+    }
+
+    // layers are topologically sorted, count the layers on each level of the graph
+    // to estimate how many of them can run at the same time.
+    std::map<int, int> level_width;
+    max_parallelism_ = layer_count > 0 ? 1 : 0;
+    for (int i = 0; i < layer_count; ++i) {
+        for (auto j : successors_[i]) {
+            level[j] = std::max(level[j], level[i] + 1);
+        }
+        max_parallelism_ = std::max(max_parallelism_, ++level_width[level[i]]);
+    }
+
+    pending_dependency_.reset(new std::atomic<int>[layer_count > 0 ? layer_count : 1]);
+    queues_.clear();
+    queues_.emplace_back(new WorkQueue());
+    return TNN_OK;
+}
+
+Status ParallelLayerExecutor::Forward(int num_threads) {
+    const int layer_count = (int)layers_.size();
+    if (layer_count == 0) {
+        return TNN_OK;
+    }
+
+    num_threads_ = std::max(1, num_threads);
+    num_workers_ = std::max(1, std::min(num_threads_, max_parallelism_));
+    // worker threads are created on demand and kept alive between forwards
+    while ((int)queues_.size() < num_workers_) {
+        queues_.emplace_back(new WorkQueue());
+        threads_.emplace_back(&ParallelLayerExecutor::WorkerLoop, this, (int)queues_.size() - 1, generation_);
+    }
+
+    status_           = TNN_OK;
+    failed_           = false;
+    running_layers_   = 0;
+    remaining_layers_ = layer_count;
+    for (int i = 0; i < layer_count; ++i) {
+        pending_dependency_[i] = dependency_count_[i];
+    }
+
+    int worker = 0;
+    for (int i = 0; i < layer_count; ++i) {
+        if (dependency_count_[i] == 0) {
+            PushTask(worker, i);
+            worker = (worker + 1) % num_workers_;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        active_workers_ = (int)threads_.size();
+        generation_++;
+    }
+    cv_.notify_all();
+
+    RunWorker(0);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return active_workers_ == 0; });
+    }
+
+    OMP_SET_THREADS_(num_threads_);
+    return status_;
+}
+
+void ParallelLayerExecutor::WorkerLoop(int worker_index, int generation) {
+    g_worker_index = worker_index;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return stop_ || generation_ != generation; });
+            if (stop_) {
+                return;
+            }
+            generation = generation_;
+        }
+
+        if (worker_index < num_workers_) {
+            RunWorker(worker_index);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_workers_--;
+        }
+        cv_.notify_all();
+    }
+}
+
+void ParallelLayerExecutor::RunWorker(int worker_index) {
+    while (remaining_layers_ > 0) {
+        int layer_index = 0;
+        if (PopTask(worker_index, layer_index)) {
+            RunLayer(worker_index, layer_index);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return queued_tasks_ > 0 || remaining_layers_ == 0; });
+    }
+}
+
+void ParallelLayerExecutor::RunLayer(int worker_index, int layer_index) {
+    // after an error the remaining layers are drained without running them
+    if (!failed_) {
+        // split the omp threads between the layers running at the same time
+        int running = ++running_layers_;
+        OMP_SET_THREADS_(std::max(1, num_threads_ / running));
+        Status status = layers_[layer_index]->Forward();
+        running_layers_--;
+        if (status != TNN_OK) {
+            LOGE("Forward error %s, exit\n", status.description().c_str());
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!failed_) {
+                status_ = status;
+                failed_ = true;
+            }
+        }
+    }
+
+    for (auto next : successors_[layer_index]) {
+        if (--pending_dependency_[next] == 0) {
+            PushTask(worker_index, next);
+        }
+    }
+
+    if (--remaining_layers_ == 0) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        cv_.notify_all();
+    }
+}
+
+void ParallelLayerExecutor::PushTask(int worker_index, int layer_index) {
+    {
+        std::lock_guard<std::mutex> lock(queues_[worker_index]->mutex);
+        queues_[worker_index]->tasks.push_back(layer_index);
+    }
+    queued_tasks_++;
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cv_.notify_all();
+}
+
+bool ParallelLayerExecutor::PopTask(int worker_index, int &layer_index) {
+    // the owner takes the newest task, thieves take the oldest one
+    for (int i = 0; i < num_workers_; ++i) {
+        auto &queue = *queues_[(worker_index + i) % num_workers_];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            layer_index = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            layer_index = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        queued_tasks_--;
+        return true;
+    }
+    return false;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,100 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_PARALLEL_LAYER_EXECUTOR_H_
+#define TNN_SOURCE_TNN_CORE_PARALLEL_LAYER_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tnn/core/blob_manager.h"
+#include "tnn/core/status.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+// @brief ParallelLayerExecutor runs independent layers of a network concurrently.
+// A dependency graph is built from the layer input and output blobs. Layers whose
+// outputs reuse the memory of an earlier blob also wait for every reader of that
+// blob, so the memory plan computed for sequential execution stays valid.
+// Ready layers are scheduled on a work-stealing pool, the calling thread acts as
+// worker 0, and the omp threads are split between the layers running at once.
+class ParallelLayerExecutor {
+public:
+    // @brief ParallelLayerExecutor constructor
+    ParallelLayerExecutor();
+
+    // @brief ParallelLayerExecutor destructor, join all worker threads
+    ~ParallelLayerExecutor();
+
+    // @brief build the layer dependency graph
+    // @param layers layers in sequential execution order
+    // @param blob_manager blob manager holding the blob memory reuse plan
+    Status Init(const std::vector<BaseLayer *> &layers, BlobManager *blob_manager);
+
+    // @brief forward all layers, return the first error met
+    // @param num_threads total threads shared by the running layers, at most
+    // num_threads layers run at the same time
+    Status Forward(int num_threads);
+
+    // @brief max number of layers that may run at the same time
+    int GetMaxParallelism();
+
+    // @brief index of the worker running on the calling thread, 0 outside the executor
+    static int GetWorkerIndex();
+
+private:
+    void WorkerLoop(int worker_index, int generation);
+    void RunWorker(int worker_index);
+    void RunLayer(int worker_index, int layer_index);
+    void PushTask(int worker_index, int layer_index);
+    bool PopTask(int worker_index, int &layer_index);
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<int> tasks;
+    };
+
+    std::vector<BaseLayer *> layers_;
+    std::vector<std::vector<int>> successors_;
+    std::vector<int> dependency_count_;
+    std::unique_ptr<std::atomic<int>[]> pending_dependency_;
+    int max_parallelism_ = 1;
+
+    // workers taking part in the current forward, the others stay idle
+    int num_workers_ = 1;
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_            = false;
+    int generation_       = 0;
+    int active_workers_   = 0;
+    std::atomic<int> queued_tasks_;
+    std::atomic<int> remaining_layers_;
+    std::atomic<int> running_layers_;
+    std::atomic<bool> failed_;
+    Status status_;
+    int num_threads_ = 1;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_PARALLEL_LAYER_EXECUTOR_H_
@@ -0,0 +1,137 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/core/reshape_plan_cache.h"
+
+#include <set>
+
+namespace TNN_NS {
+
+ReshapePlanCache::ReshapePlanCache(int capacity) : capacity_(capacity) {}
+
+Status ReshapePlanCache::Init(const std::vector<BaseLayer *> &layers, const BlobMap &input_blobs) {
+    input_blobs_ = input_blobs;
+    blobs_.clear();
+    params_.clear();
+    plans_.clear();
+    plan_index_.clear();
+    stats_.clear();
+
+    std::set<Blob *> visited;
+    for (auto layer : layers) {
+        for (auto blob : layer->GetInputBlobs()) {
+            if (visited.insert(blob).second) {
+                blobs_.push_back(blob);
+            }
+        }
+        for (auto blob : layer->GetOutputBlobs()) {
+            if (visited.insert(blob).second) {
+                blobs_.push_back(blob);
+            }
+        }
+        auto param = layer->GetLayerParam();
+        if (param) {
+            params_.push_back(param);
+        }
+    }
+    return TNN_OK;
+}
+
+std::string ReshapePlanCache::MakeKey() {
+    std::string key;
+    for (const auto &iter : input_blobs_) {
+        key += iter.first;
+        for (auto dim : iter.second->GetBlobDesc().dims) {
+            key += "," + std::to_string(dim);
+        }
+        key += ";";
+    }
+    return key;
+}
+
+Status ReshapePlanCache::Restore(bool &restored) {
+    restored = false;
+    auto key   = MakeKey();
+    auto &stat = stats_[key];
+    if (stat.shapes.empty()) {
+        for (const auto &iter : input_blobs_) {
+            stat.shapes[iter.first] = iter.second->GetBlobDesc().dims;
+        }
+    }
+
+    auto plan_iter = plan_index_.find(key);
+    if (plan_iter == plan_index_.end()) {
+        stat.misses++;
+        return TNN_OK;
+    }
+    stat.hits++;
+
+    // most recently used first
+    plans_.splice(plans_.begin(), plans_, plan_iter->second);
+    const auto &plan = plans_.front();
+    for (size_t i = 0; i < blobs_.size(); ++i) {
+        blobs_[i]->GetBlobDesc().dims = plan.dims[i];
+    }
+    for (size_t i = 0; i < params_.size(); ++i) {
+        if (!params_[i]->CopyFrom(plan.params[i].get())) {
+            return Status(TNNERR_PARAM_ERR, "restore layer param of reshape plan failed");
+        }
+    }
+    restored = true;
+    return TNN_OK;
+}
+
+Status ReshapePlanCache::Record() {
+    auto key = MakeKey();
+    if (plan_index_.find(key) != plan_index_.end()) {
+        return TNN_OK;
+    }
+
+    ReshapePlan plan;
+    plan.key = key;
+    plan.dims.reserve(blobs_.size());
+    for (auto blob : blobs_) {
+        plan.dims.push_back(blob->GetBlobDesc().dims);
+    }
+    plan.params.reserve(params_.size());
+    for (auto param : params_) {
+        auto param_copy = param->Copy();
+        if (!param_copy) {
+            return Status(TNNERR_PARAM_ERR, "copy layer param of reshape plan failed");
+        }
+        plan.params.push_back(param_copy);
+    }
+
+    plans_.push_front(std::move(plan));
+    plan_index_[key]    = plans_.begin();
+    stats_[key].cached = true;
+
+    while ((int)plans_.size() > capacity_) {
+        const auto &oldest = plans_.back();
+        stats_[oldest.key].cached = false;
+        plan_index_.erase(oldest.key);
+        plans_.pop_back();
+    }
+    return TNN_OK;
+}
+
+void ReshapePlanCache::GetStats(std::vector<ReshapeCacheStat> &stats) {
+    stats.clear();
+    for (const auto &iter : stats_) {
+        stats.push_back(iter.second);
+    }
+}
+
+}  // namespace TNN_NS
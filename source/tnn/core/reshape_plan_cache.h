@@ -0,0 +1,80 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
+#define TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_NS {
+
+// @brief ReshapePlanCache keeps the reshaped state of a network for the input shapes
+// seen recently. Shape inference only writes blob dims and layer params, both are a
+// function of the input shapes, so a plan records them after a full reshape and
+// restoring a plan replaces inferring the shapes of all layers. Plans are kept in
+// least recently used order, the oldest plan is dropped when the cache is full.
+class ReshapePlanCache {
+public:
+    // @brief ReshapePlanCache constructor
+    // @param capacity max number of plans kept
+    explicit ReshapePlanCache(int capacity);
+
+    // @brief collect the blobs and params written by shape inference
+    // @param layers layers in execution order
+    Status Init(const std::vector<BaseLayer *> &layers, const BlobMap &input_blobs);
+
+    // @brief restore the plan of the current input shapes
+    // @param restored set to false on a miss, the caller reshapes the layers and records the plan
+    Status Restore(bool &restored);
+
+    // @brief record the plan of the current input shapes after the layers are reshaped
+    Status Record();
+
+    // @brief hit and miss counters of every input shapes seen, evicted shapes included
+    void GetStats(std::vector<ReshapeCacheStat> &stats);
+
+private:
+    std::string MakeKey();
+
+    struct ReshapePlan {
+        std::string key;
+        std::vector<DimsVector> dims;
+        std::vector<std::shared_ptr<LayerParam>> params;
+    };
+
+    int capacity_ = 0;
+    BlobMap input_blobs_;
+    std::vector<Blob *> blobs_;
+    std::vector<LayerParam *> params_;
+
+    std::list<ReshapePlan> plans_;
+    std::unordered_map<std::string, std::list<ReshapePlan>::iterator> plan_index_;
+    std::map<std::string, ReshapeCacheStat> stats_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_RESHAPE_PLAN_CACHE_H_
@@ -38,6 +38,7 @@ Status TNNImplDefault::Init(ModelConfig& config) {
         return Status(TNNERR_NET_ERR, "interpreter is nil");
     }
     interpreter_ = std::shared_ptr<AbstractModelInterpreter>(interpreter);
+    RETURN_ON_NEQ(interpreter_->SetMapModelFile(config.map_model_file), TNN_OK);
     return interpreter_->Interpret(config.params);
 }
 
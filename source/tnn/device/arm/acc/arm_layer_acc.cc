@@ -88,6 +88,15 @@ Status ArmLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector
     return TNN_OK;
 }
 
+Status ArmLayerAcc::GetSharedPackedWeight(const RawBuffer &source, const std::string &tag,
+                                          PackedWeightCache::PackFunction pack_func, RawBuffer &packed) {
+    std::shared_ptr<RawBuffer> shared_packed;
+    RETURN_ON_NEQ(PackedWeightCache::Get(source, DEVICE_ARM, tag, pack_func, shared_packed), TNN_OK);
+    shared_packed_weights_.push_back(shared_packed);
+    packed = *shared_packed;
+    return TNN_OK;
+}
+
 Status ArmLayerAcc::ConfigBuffer2ArmBlobDesc(BlobDesc &desc) {
     return TNN_OK;
 }
@@ -24,6 +24,7 @@
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/device/arm/arm_device.h"
 #include "tnn/device/arm/arm_util.h"
+#include "tnn/utils/packed_weight_cache.h"
 
 namespace TNN_NS {
 using namespace arm;
@@ -86,7 +87,15 @@ protected:
     // @brief reload buffer to arm blob using packed format
     virtual Status RawBuffer2ArmBlob(RawBuffer *buffer, std::shared_ptr<Blob> &blob, BlobDesc &desc);
 
+    // @brief get the weight packed by pack_func, instances created from the same model
+    // share one packed weight if source and tag match
+    Status GetSharedPackedWeight(const RawBuffer &source, const std::string &tag,
+                                 PackedWeightCache::PackFunction pack_func, RawBuffer &packed);
+
 private:
+    // keep the shared packed weights alive
+    std::vector<std::shared_ptr<RawBuffer>> shared_packed_weights_;
+
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type);
 };
@@ -25,6 +25,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 
@@ -90,10 +91,23 @@ ArmConvLayer1x1::~ArmConvLayer1x1() {}
 
 Status ArmConvLayer1x1::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (!buffer_weight_.GetBytesSize()) {
-        RETURN_ON_NEQ(ArmConvLayerCommon::allocateBufferWeight(inputs, outputs), TNN_OK);
         if (ARM_SGEMM_TILE_N == 8) {
-            ConvertWeightsC4ToC8(buffer_weight_.force_to<float *>(), inputs[0]->GetBlobDesc().dims[1],
-                                 outputs[0]->GetBlobDesc().dims[1]);
+            ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+            CHECK_PARAM_NULL(conv_res);
+            const int ic = inputs[0]->GetBlobDesc().dims[1];
+            const int oc = outputs[0]->GetBlobDesc().dims[1];
+
+            auto pack_func = [&](RawBuffer &packed) {
+                RETURN_ON_NEQ(ArmConvLayerCommon::allocateBufferWeight(inputs, outputs), TNN_OK);
+                // the c4 weight is shared with other instances, convert a copy of it
+                packed = RawBuffer(buffer_weight_.GetBytesSize(), buffer_weight_.force_to<char *>());
+                ConvertWeightsC4ToC8(packed.force_to<float *>(), ic, oc);
+                return TNN_OK;
+            };
+            auto tag = "conv_1x1_c8" + VectorToString(std::vector<int>{ic, oc});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
+        } else {
+            RETURN_ON_NEQ(ArmConvLayerCommon::allocateBufferWeight(inputs, outputs), TNN_OK);
         }
     }
     return TNN_OK;
@@ -19,6 +19,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
 
 #if defined(__aarch64__)
 #define CONVOLUTION_TILED_NUMBER (14)
@@ -68,13 +69,18 @@ Status ArmConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &input
         [ATTENTION]
         alloc more NEON_KERNEL_EXTRA_LOAD bytes for assemble kernel prefetch
         */
-        RawBuffer temp_buffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
-        float *dst = temp_buffer.force_to<float *>();
-
-        ConvertWeightsFromGOIHWToGOIHW16((float *)src, (float *)dst, group, input_channel, output_channel,
-                                         conv_param->kernels[1], conv_param->kernels[0]);
-
-        buffer_weight_ = temp_buffer;
+        auto pack_func = [&](RawBuffer &packed) {
+            RawBuffer temp_buffer(weight_count * data_byte_size + NEON_KERNEL_EXTRA_LOAD);
+            float *dst = temp_buffer.force_to<float *>();
+
+            ConvertWeightsFromGOIHWToGOIHW16((float *)src, (float *)dst, group, input_channel, output_channel,
+                                             conv_param->kernels[1], conv_param->kernels[0]);
+
+            packed = temp_buffer;
+            return TNN_OK;
+        };
+        auto tag = "conv_goihw16" + VectorToString(std::vector<int>{group, input_channel, output_channel, kh, kw});
+        RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
     }
     return TNN_OK;
 }
@@ -18,6 +18,7 @@
 #include "tnn/core/macro.h"
 #include "tnn/device/arm/acc/Float4.h"
 #include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_mat_util.h"
 #include "tnn/device/arm/arm_util.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/dims_utils.h"
@@ -279,6 +280,77 @@ Status ArmBlobConverterAcc::ConvertFromMat(Mat &image, MatConvertParam param, vo
     return ConvertFromMatAsync(image, param, command_queue);
 }
 
+// the fused path handles packed float and half blobs of host images, bilinear resize needs 2 pixels at least
+static bool CanCropAndResizeToBlob(Mat& image, Blob* blob, const std::vector<CropParam>& crops) {
+    auto desc     = blob->GetBlobDesc();
+    auto mat_type = image.GetMatType();
+    auto channel  = DimsFunctionUtils::GetDim(desc.dims, 1);
+
+    int mat_channel = 0;
+    if (mat_type == NGRAY) {
+        mat_channel = 1;
+    } else if (mat_type == N8UC3 || mat_type == NNV12 || mat_type == NNV21) {
+        mat_channel = 3;
+    } else if (mat_type == N8UC4) {
+        mat_channel = 4;
+    }
+
+    if (mat_channel == 0 || channel > mat_channel || desc.data_format == DATA_FORMAT_NCHW ||
+        desc.data_format == DATA_FORMAT_AUTO ||
+        (image.GetDeviceType() != DEVICE_ARM && image.GetDeviceType() != DEVICE_NAIVE)) {
+        return false;
+    }
+    for (auto& crop : crops) {
+        if (crop.width < 2 || crop.height < 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status ArmBlobConverterAcc::ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess,
+                                                         MatConvertParam param, void* command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    auto dims = blob_->GetBlobDesc().dims;
+    if (image.GetBatch() != DimsFunctionUtils::GetDim(dims, 0)) {
+        return BlobConverterAcc::ConvertFromMatWithPreprocess(image, preprocess, param, command_queue);
+    }
+    // the same crop of every image
+    return ConvertFromMatWithBoxes(image, std::vector<CropParam>(image.GetBatch(), preprocess.crop),
+                                   preprocess.interp_type, param, command_queue);
+}
+
+Status ArmBlobConverterAcc::ConvertFromMatWithBoxes(Mat& image, const std::vector<CropParam>& boxes,
+                                                    InterpType interp_type, MatConvertParam param,
+                                                    void* command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    auto desc    = blob_->GetBlobDesc();
+    auto channel = DimsFunctionUtils::GetDim(desc.dims, 1);
+    auto height  = DimsFunctionUtils::GetDim(desc.dims, 2);
+    auto width   = DimsFunctionUtils::GetDim(desc.dims, 3);
+
+    bool fused      = CanCropAndResizeToBlob(image, blob_, boxes);
+    auto handle_ptr = GetBlobHandlePtr(blob_->GetHandle());
+    if (fused && desc.data_type == DATA_TYPE_FLOAT) {
+        CropAndResizeToBlob<float, 4>(image, boxes, interp_type, param, reinterpret_cast<float*>(handle_ptr),
+                                      channel, width, height);
+        return TNN_OK;
+    }
+#if TNN_ARM82
+    if (fused && desc.data_type == DATA_TYPE_HALF) {
+        CropAndResizeToBlob<fp16_t, 8>(image, boxes, interp_type, param, reinterpret_cast<fp16_t*>(handle_ptr),
+                                       channel, width, height);
+        return TNN_OK;
+    }
+#endif
+
+    return BlobConverterAcc::ConvertFromMatWithBoxes(image, boxes, interp_type, param, command_queue);
+}
+
 DECLARE_BLOB_CONVERTER_CREATER(Arm);
 REGISTER_BLOB_CONVERTER(Arm, DEVICE_ARM);
 
@@ -47,6 +47,11 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL);
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL);
 
+    virtual Status ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                                void* command_queue = NULL);
+    virtual Status ConvertFromMatWithBoxes(Mat& image, const std::vector<CropParam>& boxes, InterpType interp_type,
+                                           MatConvertParam param, void* command_queue = NULL);
+
     static Status RegisterBlobConvertFunc(MatType mat_type, DataType data_type, BlobConvertDirection cvt_dir,
                                           ArmBlobConvertFunc cvt_func);
 
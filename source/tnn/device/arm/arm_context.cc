@@ -13,6 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/core/parallel_layer_executor.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/omp_utils.h"
@@ -59,13 +60,18 @@ void* ArmContext::GetSharedWorkSpace(size_t size) {
 }
 
 void* ArmContext::GetSharedWorkSpace(size_t size, int index) {
-    while(work_space_.size() < index + 1) {
-        work_space_.push_back(RawBuffer(ROUND_UP(size, 64)));
+    std::vector<RawBuffer> *work_space = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(work_space_mutex_);
+        work_space = &work_space_[ParallelLayerExecutor::GetWorkerIndex()];
     }
-    if (work_space_[index].GetBytesSize() < size) {
-        work_space_[index] = RawBuffer(ROUND_UP(size, 64));
+    while(work_space->size() < index + 1) {
+        work_space->push_back(RawBuffer(ROUND_UP(size, 64)));
     }
-    return work_space_[index].force_to<void*>();
+    if ((*work_space)[index].GetBytesSize() < size) {
+        (*work_space)[index] = RawBuffer(ROUND_UP(size, 64));
+    }
+    return (*work_space)[index].force_to<void*>();
 }
 
 }  // namespace TNN_NS
@@ -15,6 +15,10 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 
+#include <map>
+#include <mutex>
+#include <vector>
+
 #include "tnn/core/context.h"
 #include "tnn/interpreter/raw_buffer.h"
 namespace TNN_NS {
@@ -51,7 +55,9 @@ public:
 
 private:
     int num_threads_ = 1;
-    std::vector<RawBuffer> work_space_;
+    // work space for each worker of the parallel layer executor
+    std::map<int, std::vector<RawBuffer>> work_space_;
+    std::mutex work_space_mutex_;
 };
 
 }  // namespace TNN_NS
@@ -285,6 +285,30 @@ Status ArmMatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+Status ArmMatConverterAcc::CropAndResize(Mat& src, Mat& dst, const std::vector<CropParam>& boxes, InterpType type,
+                                         void* command_queue) {
+    Status ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    auto mat_type = src.GetMatType();
+    if (mat_type != NGRAY && mat_type != N8UC3 && mat_type != N8UC4 && mat_type != NNV12 && mat_type != NNV21) {
+        return Status(TNNERR_PARAM_ERR, "ArmMatConverterAcc::CropAndResize, convert type not support yet");
+    }
+    if (type != INTERP_TYPE_LINEAR && type != INTERP_TYPE_NEAREST) {
+        return Status(TNNERR_PARAM_ERR, "interpolation type not support yet");
+    }
+    // bilinear resize reads 2 pixels at least
+    for (auto& box : boxes) {
+        if (box.width < 2 || box.height < 2) {
+            return Status(TNNERR_PARAM_ERR, "box size must be 2 at least");
+        }
+    }
+
+    arm::CropAndResize(src, boxes, type, (uint8_t*)dst.GetData(), dst.GetWidth(), dst.GetHeight());
+    return ret;
+}
+
 DECLARE_MAT_CONVERTER_CREATER(Arm);
 REGISTER_MAT_CONVERTER(Arm, DEVICE_ARM);
 
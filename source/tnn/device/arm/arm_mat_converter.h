@@ -29,6 +29,8 @@ public:
     virtual Status WarpAffine(Mat& src, Mat& dst, WarpAffineParam param, void* command_queue = NULL);
     virtual Status CvtColor(Mat& src, Mat& dst, ColorConversionType type, void* command_queue = NULL);
     virtual Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue = NULL);
+    virtual Status CropAndResize(Mat& src, Mat& dst, const std::vector<CropParam>& boxes, InterpType type,
+                                 void* command_queue = NULL);
 };
 
 }  // namespace TNN_NS
@@ -18,10 +18,12 @@
 #include <string.h>
 #include <sys/time.h>
 #include <cstdlib>
+#include <vector>
 
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/blob_converter.h"
 
 namespace TNN_NS {
 namespace arm {
@@ -68,6 +70,17 @@ void WarpAffineNearestC4(const uint8_t* src, int batch, int src_w, int src_h, ui
 void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
                                const float (*transform)[3], const float border_val = 0.0);
 
+// crop and resize
+// crop every box of an N8UC3, N8UC4, NGRAY, NNV12 or NNV21 image and resize it to w x h in one pass, box i reads
+// image batch i, or batch 0 if the image has one batch. nv12 and nv21 are converted to bgr.
+void CropAndResize(Mat& src, const std::vector<CropParam>& crops, InterpType interp_type, uint8_t* dst, int w,
+                   int h);
+// same as CropAndResize, but each resized row is scaled into a blob packed by `pack` channels (nc4hw4 float or
+// nc8hw8 half) while still in cache.
+template <typename T, int pack>
+void CropAndResizeToBlob(Mat& src, const std::vector<CropParam>& crops, InterpType interp_type,
+                         const MatConvertParam& param, T* dst, int channel, int w, int h);
+
 }  // namespace arm
 }  // namespace TNN_NS
 
@@ -0,0 +1,128 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+Status CpuFusedElementwiseLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+// strides of dims broadcast to output_dims, 0 on the broadcast axes
+static DimsVector BroadcastStrides(DimsVector dims, const DimsVector &output_dims) {
+    dims.insert(dims.begin(), output_dims.size() - dims.size(), 1);
+    DimsVector strides(dims.size(), 0);
+    int stride = 1;
+    for (int i = (int)dims.size() - 1; i >= 0; --i) {
+        strides[i] = dims[i] == 1 ? 0 : stride;
+        stride *= dims[i];
+    }
+    return strides;
+}
+
+static float FusedStep(const FusedElementwiseStep &step, float x, float y) {
+    if (step.operand_first) {
+        std::swap(x, y);
+    }
+    switch (step.type) {
+        case LAYER_ADD:
+            return x + y;
+        case LAYER_SUB:
+            return x - y;
+        case LAYER_MUL:
+            return x * y;
+        case LAYER_DIV:
+            return x / y;
+        case LAYER_MAXIMUM:
+            return std::max(x, y);
+        case LAYER_MINIMUM:
+            return std::min(x, y);
+        case LAYER_RELU:
+            return std::max(x, 0.0f);
+        case LAYER_RELU6:
+            return std::min(std::max(x, 0.0f), 6.0f);
+        case LAYER_CLIP:
+            return std::min(std::max(x, step.alpha), step.beta);
+        case LAYER_SIGMOID:
+            return 1.0f / (1.0f + std::exp(-x));
+        case LAYER_SWISH:
+            return x / (1.0f + std::exp(-x));
+        case LAYER_HARDSIGMOID:
+            return std::min(std::max(step.alpha * x + step.beta, 0.0f), 1.0f);
+        case LAYER_TANH:
+            return std::tanh(x);
+        case LAYER_ABS:
+            return std::fabs(x);
+        case LAYER_NEG:
+            return -x;
+        case LAYER_EXP:
+            return std::exp(x);
+        default:
+            return x;
+    }
+}
+
+Status CpuFusedElementwiseLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<FusedElementwiseLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: layer acc dont support datatype: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: layer acc dont support datatype");
+    }
+
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    std::vector<const float *> input_data;
+    std::vector<DimsVector> input_strides;
+    for (auto blob : inputs) {
+        input_data.push_back(static_cast<float *>(blob->GetHandle().base));
+        input_strides.push_back(BroadcastStrides(blob->GetBlobDesc().dims, output_dims));
+    }
+    float *output_data = static_cast<float *>(outputs[0]->GetHandle().base);
+
+    const int count = DimsVectorUtils::Count(output_dims);
+    std::vector<int> offsets(inputs.size());
+    for (int index = 0; index < count; ++index) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        int remain = index;
+        for (int d = (int)output_dims.size() - 1; d >= 0; --d) {
+            const int pos = remain % output_dims[d];
+            remain /= output_dims[d];
+            for (int i = 0; i < inputs.size(); ++i) {
+                offsets[i] += pos * input_strides[i][d];
+            }
+        }
+
+        float value = input_data[0][offsets[0]];
+        for (const auto &step : layer_param->steps) {
+            const float operand = step.operand >= 0 ? input_data[step.operand][offsets[step.operand]] : 0.0f;
+            value               = FusedStep(step, value, operand);
+        }
+        output_data[index] = value;
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+}  // namespace TNN_NS
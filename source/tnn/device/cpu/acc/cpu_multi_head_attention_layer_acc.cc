@@ -0,0 +1,124 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cfloat>
+#include <cmath>
+
+#include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+Status CpuMultiHeadAttentionLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+// offset of the matrix at index b of batch_dims in an input of dims broadcast to batch_dims
+static int BatchOffset(const DimsVector &dims, const DimsVector &batch_dims, int b) {
+    const int rank   = (int)dims.size() - 2;
+    const int offset = (int)batch_dims.size() - rank;
+    int matrix_offset = 0;
+    int stride        = dims[rank] * dims[rank + 1];
+    for (int i = (int)batch_dims.size() - 1; i >= 0; --i) {
+        const int index = b % batch_dims[i];
+        b /= batch_dims[i];
+        if (i >= offset) {
+            matrix_offset += dims[i - offset] == 1 ? 0 : index * stride;
+            stride *= dims[i - offset];
+        }
+    }
+    return matrix_offset;
+}
+
+Status CpuMultiHeadAttentionLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<MultiHeadAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: layer acc dont support datatype: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: layer acc dont support datatype");
+    }
+
+    auto q_dims      = inputs[0]->GetBlobDesc().dims;
+    auto k_dims      = inputs[1]->GetBlobDesc().dims;
+    auto v_dims      = inputs[2]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    DimsVector batch_dims(output_dims.begin(), output_dims.end() - 2);
+
+    const int batch    = DimsVectorUtils::Count(batch_dims);
+    const int seq_q    = q_dims[q_dims.size() - 2];
+    const int head_dim = q_dims.back();
+    const int seq_k    = k_dims.back();
+    const int v_dim    = v_dims.back();
+    const float scale  = layer_param->scale;
+
+    const float *q = (float *)((char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset);
+    const float *k = (float *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+    const float *v = (float *)((char *)inputs[2]->GetHandle().base + inputs[2]->GetHandle().bytes_offset);
+    float *output  = (float *)((char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset);
+
+    const float *mask = nullptr;
+    DimsVector mask_dims;
+    int mask_row_step = 0, mask_col_step = 0;
+    if (inputs.size() > 3) {
+        mask      = (float *)((char *)inputs[3]->GetHandle().base + inputs[3]->GetHandle().bytes_offset);
+        mask_dims = inputs[3]->GetBlobDesc().dims;
+        mask_dims.insert(mask_dims.begin(), output_dims.size() - mask_dims.size(), 1);
+        mask_col_step = mask_dims.back() == 1 ? 0 : 1;
+        mask_row_step = mask_dims[mask_dims.size() - 2] == 1 ? 0 : mask_dims.back();
+    }
+
+    std::vector<float> scores(seq_k);
+    for (int b = 0; b < batch; ++b) {
+        const float *q_b = q + BatchOffset(q_dims, batch_dims, b);
+        const float *k_b = k + BatchOffset(k_dims, batch_dims, b);
+        const float *v_b = v + BatchOffset(v_dims, batch_dims, b);
+        float *output_b  = output + b * seq_q * v_dim;
+        for (int i = 0; i < seq_q; ++i) {
+            float max_score = -FLT_MAX;
+            for (int j = 0; j < seq_k; ++j) {
+                float score = 0.f;
+                for (int d = 0; d < head_dim; ++d) {
+                    score += q_b[i * head_dim + d] * k_b[d * seq_k + j];
+                }
+                score *= scale;
+                if (mask) {
+                    score += mask[BatchOffset(mask_dims, batch_dims, b) + i * mask_row_step + j * mask_col_step];
+                }
+                scores[j] = score;
+                max_score = std::max(max_score, score);
+            }
+            float sum = 0.f;
+            for (int j = 0; j < seq_k; ++j) {
+                scores[j] = expf(scores[j] - max_score);
+                sum += scores[j];
+            }
+            for (int e = 0; e < v_dim; ++e) {
+                float value = 0.f;
+                for (int j = 0; j < seq_k; ++j) {
+                    value += scores[j] * v_b[j * v_dim + e];
+                }
+                output_b[i * v_dim + e] = value / sum;
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+}  // namespace TNN_NS
@@ -259,6 +259,50 @@ Status CpuMatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+Status CpuMatConverterAcc::CropAndResize(Mat& src, Mat& dst, const std::vector<CropParam>& boxes, InterpType type,
+                                         void* command_queue) {
+    Status ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    auto mat_type = src.GetMatType();
+    bool is_yuv   = mat_type == NNV12 || mat_type == NNV21;
+    if (mat_type != NGRAY && mat_type != N8UC3 && mat_type != N8UC4 && !is_yuv) {
+        return Status(TNNERR_PARAM_ERR, "CropAndResize mat type not support yet");
+    }
+
+    DimsVector src_dims = src.GetDims();
+    DimsVector dst_dims = dst.GetDims();
+    src_dims[0]         = 1;
+    dst_dims[0]         = 1;
+    int src_size        = DimsVectorUtils::Count(src_dims);
+    if (is_yuv) {
+        src_size = src.GetWidth() * src.GetHeight() * 3 / 2;
+    }
+    int dst_size = DimsVectorUtils::Count(dst_dims);
+
+    ResizeParam resize_param;
+    resize_param.type = type;
+    for (int i = 0; i < boxes.size(); ++i) {
+        auto& box = boxes[i];
+        Mat src_b(src.GetDeviceType(), mat_type, src_dims,
+                  (uint8_t*)src.GetData() + (src.GetBatch() == 1 ? 0 : i) * src_size);
+        Mat dst_b(dst.GetDeviceType(), dst.GetMatType(), dst_dims, (uint8_t*)dst.GetData() + i * dst_size);
+
+        Mat cropped(src.GetDeviceType(), mat_type, {1, src_dims[1], box.height, box.width});
+        RETURN_ON_NEQ(Crop(src_b, cropped, box, command_queue), TNN_OK);
+        if (is_yuv) {
+            Mat bgr(src.GetDeviceType(), N8UC3, {1, 3, box.height, box.width});
+            auto cvt_type = mat_type == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+            RETURN_ON_NEQ(CvtColor(cropped, bgr, cvt_type, command_queue), TNN_OK);
+            cropped = bgr;
+        }
+        RETURN_ON_NEQ(Resize(cropped, dst_b, resize_param, command_queue), TNN_OK);
+    }
+
+    return ret;
+}
+
 void CpuMatConverterAcc::MatMemcpy2D(void* src, void* dst, int width, int height, int src_stride, int dst_stride) {
     auto src_ptr = reinterpret_cast<uint8_t*>(src);
     auto dst_ptr = reinterpret_cast<uint8_t*>(dst);
@@ -31,7 +31,7 @@ template<typename a_t, typename b_t, typename c_t>
 conv_gemm_config<a_t, b_t, c_t>::conv_gemm_config(
     const dim_t m_block, const dim_t n_block) : m_block_(m_block), n_block_(n_block)
 {
-    std::vector<int> supported_m_block = {4, 8, 16};
+    std::vector<int> supported_m_block = {4, 8, 16, 32};
     std::vector<int> supported_n_block = {6};
     if (std::find(supported_m_block.begin(), supported_m_block.end(), m_block_) == supported_m_block.end()) {
        throw std::runtime_error("value of m_block is not supported.");
@@ -43,7 +43,15 @@ conv_gemm_config<a_t, b_t, c_t>::conv_gemm_config(
     M_c_ = 64;
     K_c_ = 256;
 
-    if (cpu_with_isa(avx2)) {
+    if (cpu_with_isa(avx512)) {
+#ifdef XBYAK64
+        m_block_ = 32;
+        kernel_m_r_ = 32;
+#else
+        m_block_ = 8;
+        kernel_m_r_ = 8;
+#endif
+    } else if (cpu_with_isa(avx2)) {
 #ifdef XBYAK64
         m_block_ = 16;
         kernel_m_r_ = 16; 
@@ -70,9 +78,15 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_4 [nb_kernels_m + 1][nb_kernels_n + 1];
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_8 [nb_kernels_m + 1][nb_kernels_n + 1];
     static std::shared_ptr<jit::base_jit_kernel> g_kernel_16[nb_kernels_m + 1][nb_kernels_n + 1];
+    static std::shared_ptr<jit::base_jit_kernel> g_kernel_32[nb_kernels_m + 1][nb_kernels_n + 1];
 
     static std::once_flag initialized;
     std::call_once(initialized, [] {
+        // zmm kernels are only generated on cpus with avx512
+        bool with_avx512 = false;
+#ifdef XBYAK64
+        with_avx512 = cpu_with_isa(avx512);
+#endif
 
         // initialize the pack t kernels
         for(int i = 1; i <= nb_kernels_n; i++) {
@@ -142,6 +156,8 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
             std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 8, 6>>();                         \
             if (M <= 16) g_kernel_16[M][N] =                                                    \
             std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 16, 6>>();                        \
+            if (with_avx512) g_kernel_32[M][N] =                                                \
+            std::make_shared<jit::conv_sgemm_avx_kernel<M, N, 32, 6>>();                        \
 
 #define REGISTER_KERNEL_M(M)                                                                    \
             REGISTER_KERNEL(M, 1);                                                              \
@@ -156,6 +172,7 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
         REGISTER_KERNEL_M(4);
         REGISTER_KERNEL_M(8);
         REGISTER_KERNEL_M(16);
+        REGISTER_KERNEL_M(32);
 
 #ifdef TNN_JIT_DUMP_KERNEL
         for(int i=1;i<=nb_kernels_m;i++) {
@@ -182,6 +199,9 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
                 if (g_kernel_16[m][n]) {
                     g_kernel_16[m][n]->dump_to_file();
                 }
+                if (g_kernel_32[m][n]) {
+                    g_kernel_32[m][n]->dump_to_file();
+                }
             }
         }
 #endif
@@ -226,6 +246,8 @@ void conv_gemm_config<a_t, b_t, c_t>::init_jit_kernel()
         SET_X86_CONV_GEMM_KERNEL_FUNC(8);
     } else if (m_block_ == 16) {
         SET_X86_CONV_GEMM_KERNEL_FUNC(16);
+    } else if (m_block_ == 32) {
+        SET_X86_CONV_GEMM_KERNEL_FUNC(32);
     } else {
         throw std::runtime_error("unsupported m_block value."); 
     }
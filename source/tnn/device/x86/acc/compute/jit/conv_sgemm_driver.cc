@@ -74,10 +74,29 @@ void conv_sgemm_block_n(
                 conv_gemm_conf.kernels_[8][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
                 i+=8;
                 break;
-            default:
+            case 16:
+            case 17:
+            case 18:
+            case 19:
+            case 20:
+            case 21:
+            case 22:
+            case 23:
+            case 24:
+            case 25:
+            case 26:
+            case 27:
+            case 28:
+            case 29:
+            case 30:
+            case 31:
                 conv_gemm_conf.kernels_[16][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
                 i+=16;
                 break;
+            default:
+                conv_gemm_conf.kernels_[32][N](K, cur_a, lda, cur_b, ldb, cur_c, ldc, bias, first, act_type);
+                i+=32;
+                break;
         }
     }
 }
@@ -383,14 +402,17 @@ void conv_pack_col_a_t(
 void conv_ajust_m_blk_size(
     int max_num_threads,
     dim_t m_all,
-    dim_t &m_blk)
+    dim_t &m_blk,
+    dim_t m_block)
 {
     // for 32bit, min M blk = 8
     // for 64bit, min M blk = 16
-    int m_min = 8;
+    // M blk can not be smaller than the packing block (32 for avx512)
+    dim_t m_min = 8;
 #ifdef XBYAK64
     m_min = 16;
 #endif
+    m_min = MAX(m_min, m_block);
 
     while ((m_all / m_blk) < max_num_threads &&
            m_blk > m_min) {
@@ -79,7 +79,8 @@ void conv_pack_col_a_t(
 void conv_ajust_m_blk_size(
     int max_num_threads,
     dim_t m_all,
-    dim_t &m_blk);
+    dim_t &m_blk,
+    dim_t m_block);
 
 }   // namespace TNN_NS
 
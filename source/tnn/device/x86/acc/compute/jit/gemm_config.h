@@ -56,7 +56,7 @@ typedef void (*sgemm_ker_func_t)(const dim_t K, const float * alpha_ptr,
     dim_t M_c_;
     dim_t K_c_;
 
-    constexpr static int nb_kernels_m = 16;
+    constexpr static int nb_kernels_m = 32;
     constexpr static int nb_kernels_n = 6;
 
     fetch_t_func_t pack_t_ker_[nb_kernels_m + 1];
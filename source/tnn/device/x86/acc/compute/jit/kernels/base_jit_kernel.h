@@ -182,6 +182,10 @@ public:
             return Xbyak::Xmm(getIdx());
         }
 
+        Xbyak::Zmm zmm() {
+            return Xbyak::Zmm(getIdx());
+        }
+
         bool in_use_ = false;
         base_jit_kernel * ker_;
     };
@@ -73,10 +73,29 @@ void sgemm_block_n(
                 gemm_conf.kernels_[8][N](K, &alpha, cur_a, lda, cur_b, ldb, &beta, cur_c, ldc);
                 i+=8;
                 break;
-            default:
+            case 16:
+            case 17:
+            case 18:
+            case 19:
+            case 20:
+            case 21:
+            case 22:
+            case 23:
+            case 24:
+            case 25:
+            case 26:
+            case 27:
+            case 28:
+            case 29:
+            case 30:
+            case 31:
                 gemm_conf.kernels_[16][N](K, &alpha, cur_a, lda, cur_b, ldb, &beta, cur_c, ldc);
                 i+=16;
                 break;
+            default:
+                gemm_conf.kernels_[32][N](K, &alpha, cur_a, lda, cur_b, ldb, &beta, cur_c, ldc);
+                i+=32;
+                break;
         }
     }
 }
@@ -40,6 +40,9 @@ bool cpu_with_isa(x86_isa_t arch) {
             return cpu.has(Cpu::tAVX512F)  && cpu.has(Cpu::tAVX512BW) &&
                    cpu.has(Cpu::tAVX512VL) && cpu.has(Cpu::tAVX512DQ) &&
                    cpu.has(Cpu::tAVX512_VNNI);
+        case avx_vnni:
+            return cpu.has(Cpu::tAVX2) && cpu.has(Cpu::tFMA) &&
+                   cpu.has(Cpu::tAVX_VNNI);
         default:
             return false;
     }
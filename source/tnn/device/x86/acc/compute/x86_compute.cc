@@ -227,11 +227,11 @@ void X86MaxPoolingCorner(const float* src, long iw, long ih, float* dst, long ow
             for (long ky = kys; ky < kye; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = kxs; kx < kxe; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                    vmax = T::max(vmax, T::loadu(src_ptr_h + kx * pack_c));
                 }
             }
 
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -253,11 +253,11 @@ void X86MaxPoolingCenter3x3s2(const float* src, long iw, long ih, float* dst, lo
 
             for (long ky = 0; ky < 3; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 0 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 1 * pack_c));
-                vmax                 = T::max(vmax, T::load(src_ptr_h + 2 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 0 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 1 * pack_c));
+                vmax                 = T::max(vmax, T::loadu(src_ptr_h + 2 * pack_c));
             }
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -280,11 +280,11 @@ void X86MaxPoolingCenter(const float* src, long iw, long ih, float* dst, long ow
             for (long ky = 0; ky < kh; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = 0; kx < kw; kx++) {
-                    vmax = T::max(vmax, T::load(src_ptr_h + kx * pack_c));
+                    vmax = T::max(vmax, T::loadu(src_ptr_h + kx * pack_c));
                 }
             }
 
-            T::save(dst_ptr, vmax);
+            T::saveu(dst_ptr, vmax);
         }
     }
 }
@@ -339,12 +339,12 @@ void X86AvgPooling(const float* src, long iw, long ih, float* dst, long ow, long
             for (long ky = kys; ky < kye; ++ky) {
                 const auto src_ptr_h = src_ptr + (ky * iw) * pack_c;
                 for (long kx = kxs; kx < kxe; kx++) {
-                    vavg = vavg + T::load(src_ptr_h + kx * pack_c);
+                    vavg = vavg + T::loadu(src_ptr_h + kx * pack_c);
                 }
             }
 
             vavg = vavg * T(kernel_count);
-            T::save(dst_ptr, vavg);
+            T::saveu(dst_ptr, vavg);
         }
     }
 }
@@ -434,6 +434,36 @@ template Status X86_FMA<Float8, 8>(float *input_data, float *output_data, float
 template Status X86_FMA<Float4, 4>(float *input_data, float *output_data, float *scale_data, float *bias_data,
                bool shared_channel, bool has_bias, DimsVector output_dim);
 
+/*
+per channel scale and bias on the blocked nc8hw8 layout, padded channels get zeros
+*/
+Status X86_FMA_NC8HW8(float *input_data, float *output_data, float *scale_data, float *bias_data,
+                      bool shared_channel, bool has_bias, DimsVector output_dim) {
+    const int channel = output_dim[1];
+    const int c_block = UP_DIV(channel, 8);
+    const int hw      = DimsVectorUtils::Count(output_dim, 2);
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int bc = 0; bc < output_dim[0] * c_block; bc++) {
+        const int c = (bc % c_block) * 8;
+        float scale[8], bias[8];
+        for (int l = 0; l < 8; l++) {
+            const int idx = shared_channel ? 0 : c + l;
+            const bool valid = c + l < channel;
+            scale[l] = valid ? scale_data[idx] : 0.f;
+            bias[l]  = (valid && has_bias) ? bias_data[idx] : 0.f;
+        }
+        Float8 v_scale = Float8::loadu(scale);
+        Float8 v_bias  = Float8::loadu(bias);
+        auto src       = input_data + bc * hw * 8;
+        auto dst       = output_data + bc * hw * 8;
+        for (int i = 0; i < hw; i++) {
+            Float8::saveu(dst + i * 8, Float8::loadu(src + i * 8) * v_scale + v_bias);
+        }
+    }
+    return TNN_OK;
+}
+
 template<class T, int pack>
 Status X86_GroupNorm_FMA(
     float *input_data, float *output_data,
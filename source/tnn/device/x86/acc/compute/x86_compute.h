@@ -59,6 +59,9 @@ template <class T, int pack_c>
 Status X86_FMA(float *input, float *output, float *scale, float *bias,
                bool shared_channel, bool has_bias, DimsVector output_dim);
 
+Status X86_FMA_NC8HW8(float *input, float *output, float *scale, float *bias,
+                      bool shared_channel, bool has_bias, DimsVector output_dim);
+
 template <int activation_type, typename VEC, int pack>
 void DepthwiseConv(float* dst, const float* src, const float* weight, const float* bias, long width, long src_w_step, long fw, long fh,
                    long dilate_x_step, long dilate_y_step, long height, long srcHStep, long dstHStep);
@@ -61,6 +61,54 @@ using namespace x86;
     __m128i dst_i8x8    = _mm_packs_epi16(dst_i16x8, dst_i16x8);      \
     _mm_storel_epi64((__m128i*)(dst), dst_i8x8);
 
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+#define TNN_X86_AVX512_VNNI_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512vl,avx512dq,avx512vnni")))
+#endif
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+#define TNN_X86_AVX_VNNI_TARGET __attribute__((target("avx2,fma,avxvnni")))
+#endif
+
+#if defined(TNN_X86_AVX512_VNNI_ENABLE) || defined(TNN_X86_AVX_VNNI_ENABLE)
+// round and saturate 16 floats to int8, the same rounding as F32X4TOI8X4
+__attribute__((target("avx2,fma"))) static inline void F32X16ToI8X16(__m256 f32x8_a, __m256 f32x8_b, int8_t* dst) {
+    __m256 zero_f32x8 = _mm256_setzero_ps();
+    __m256 add_05x8   = _mm256_set1_ps(0.5f);
+    __m256 sub_05x8   = _mm256_set1_ps(-0.5f);
+    f32x8_a = _mm256_add_ps(f32x8_a, _mm256_blendv_ps(sub_05x8, add_05x8, _mm256_cmp_ps(f32x8_a, zero_f32x8, _CMP_GE_OQ)));
+    f32x8_b = _mm256_add_ps(f32x8_b, _mm256_blendv_ps(sub_05x8, add_05x8, _mm256_cmp_ps(f32x8_b, zero_f32x8, _CMP_GE_OQ)));
+    // [a0-3, b0-3, a4-7, b4-7] -> [a0-7, b0-7]
+    __m256i i16x16 = _mm256_packs_epi32(_mm256_cvttps_epi32(f32x8_a), _mm256_cvttps_epi32(f32x8_b));
+    i16x16         = _mm256_permute4x64_epi64(i16x16, 0xD8);
+    __m128i i8x16  = _mm_packs_epi16(_mm256_castsi256_si128(i16x16), _mm256_extracti128_si256(i16x16, 1));
+    _mm_storeu_si128((__m128i*)dst, i8x16);
+}
+#endif
+
+x86_isa_t X86Int8GemmArch(x86_isa_t arch) {
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+    if (cpu_with_isa(avx512_vnni)) {
+        return avx512_vnni;
+    }
+#endif
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+    if (cpu_with_isa(avx_vnni)) {
+        return avx_vnni;
+    }
+#endif
+    return arch;
+}
+
+void X86Int8VnniCompensation(int32_t* bias, const int8_t* weight, long oc, long k) {
+    for (long o = 0; o < oc; ++o) {
+        const auto weight_o = weight + o * k;
+        int32_t weight_sum  = 0;
+        for (long i = 0; i < k; ++i) {
+            weight_sum += weight_o[i];
+        }
+        bias[o] -= 128 * weight_sum;
+    }
+}
+
 #ifdef __AVX2__
 void X86AVXGemmInt8Unit4x4(const int8_t* src, const int8_t* weight, int8_t* dst, long src_w_step, long dst_depth, long cdiv8,
                      const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
@@ -305,6 +353,138 @@ void X86SSEGemmInt8Unit4x4(const int8_t* src, const int8_t* weight, int8_t* dst,
     }
 }
 
+/*
+vnni gemm kernels, 4 pixels x 16 output channels
+weight layout: [k/4][o16][k4], see PackINT8WeightVnni
+vpdpbusd multiplies u8 by s8, so the input is shifted to u8 by xor 0x80
+*/
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+TNN_X86_AVX512_VNNI_TARGET
+void X86AVX512VNNIGemmInt8Unit4x16(const int8_t* src, const int8_t* weight, int8_t* dst, long src_w_step, long dst_depth,
+                     long cdiv8, const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
+                     const float* add_scale, const int8_t* relu6_max) {
+    const __m512i u8_offset = _mm512_set1_epi8((char)0x80);
+    __m512i dst_i32x16[4];
+    for (long w = 0; w < 4; ++w) {
+        dst_i32x16[w] = _mm512_setzero_si512();
+    }
+
+    for (long sz = 0; sz < cdiv8 * 2; ++sz) {
+        __m512i w_vec = _mm512_loadu_si512((const void*)(weight + sz * 64));
+        for (long w = 0; w < 4; ++w) {
+            int src_4xi8    = *((int*)(src + w * src_w_step + sz * 4));
+            __m512i src_vec = _mm512_xor_si512(_mm512_set1_epi32(src_4xi8), u8_offset);
+            dst_i32x16[w]   = _mm512_dpbusd_epi32(dst_i32x16[w], src_vec, w_vec);
+        }
+    }
+
+    __m512 zero_f32x16 = _mm512_setzero_ps();
+    __m512 add_05x16   = _mm512_set1_ps(0.5f);
+    __m512 sub_05x16   = _mm512_set1_ps(-0.5f);
+    __m512i bias_vec   = _mm512_loadu_si512((const void*)bias);
+    __m512 scale_vec   = _mm512_loadu_ps(scale);
+    __m512 add_scale_vec, relu6_max_vec;
+    if (add_input) {
+        add_scale_vec = _mm512_loadu_ps(add_scale);
+    }
+    if (relu == 2) {
+        relu6_max_vec = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_mm_loadu_si128((__m128i*)relu6_max)));
+    }
+
+    for (long w = 0; w < 4; ++w) {
+        auto dst_x       = dst + w * dst_depth;
+        __m512 dst_16x32 = _mm512_cvtepi32_ps(_mm512_add_epi32(dst_i32x16[w], bias_vec));
+        dst_16x32        = _mm512_mul_ps(dst_16x32, scale_vec);
+
+        if (relu == -1) {
+            dst_16x32 = _mm512_max_ps(dst_16x32, zero_f32x16);
+        }
+        if (add_input) {
+            __m128i add_input_i8x16 = _mm_loadu_si128((__m128i*)(add_input + w * dst_depth));
+            __m512 add_input_vec    = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(add_input_i8x16));
+            dst_16x32 = _mm512_add_ps(dst_16x32, _mm512_mul_ps(add_input_vec, add_scale_vec));
+        }
+        if (relu == 1) {
+            dst_16x32 = _mm512_max_ps(dst_16x32, zero_f32x16);
+        }
+        // Conv-Add-Relu6
+        else if (relu == 2) {
+            dst_16x32 = _mm512_max_ps(dst_16x32, zero_f32x16);
+            dst_16x32 = _mm512_min_ps(dst_16x32, relu6_max_vec);
+        }
+        __mmask16 cmp_zero = _mm512_cmp_ps_mask(dst_16x32, zero_f32x16, _CMP_GE_OQ);
+        dst_16x32          = _mm512_add_ps(dst_16x32, _mm512_mask_blend_ps(cmp_zero, sub_05x16, add_05x16));
+        _mm_storeu_si128((__m128i*)dst_x, _mm512_cvtsepi32_epi8(_mm512_cvttps_epi32(dst_16x32)));
+    }
+}
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+TNN_X86_AVX_VNNI_TARGET
+void X86AVXVNNIGemmInt8Unit4x16(const int8_t* src, const int8_t* weight, int8_t* dst, long src_w_step, long dst_depth,
+                     long cdiv8, const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
+                     const float* add_scale, const int8_t* relu6_max) {
+    const __m256i u8_offset = _mm256_set1_epi8((char)0x80);
+    __m256i dst_i32x8[4][2];
+    for (long w = 0; w < 4; ++w) {
+        dst_i32x8[w][0] = _mm256_setzero_si256();
+        dst_i32x8[w][1] = _mm256_setzero_si256();
+    }
+
+    for (long sz = 0; sz < cdiv8 * 2; ++sz) {
+        __m256i w_vec_0 = _mm256_loadu_si256((__m256i*)(weight + sz * 64));
+        __m256i w_vec_1 = _mm256_loadu_si256((__m256i*)(weight + sz * 64 + 32));
+        for (long w = 0; w < 4; ++w) {
+            int src_4xi8    = *((int*)(src + w * src_w_step + sz * 4));
+            __m256i src_vec = _mm256_xor_si256(_mm256_set1_epi32(src_4xi8), u8_offset);
+            dst_i32x8[w][0] = _mm256_dpbusd_avx_epi32(dst_i32x8[w][0], src_vec, w_vec_0);
+            dst_i32x8[w][1] = _mm256_dpbusd_avx_epi32(dst_i32x8[w][1], src_vec, w_vec_1);
+        }
+    }
+
+    __m256 zero_f32x8 = _mm256_setzero_ps();
+    __m256i bias_vec[2];
+    __m256 scale_vec[2], add_scale_vec[2], relu6_max_vec[2];
+    for (long h = 0; h < 2; ++h) {
+        bias_vec[h]  = _mm256_loadu_si256((__m256i*)(bias + h * 8));
+        scale_vec[h] = _mm256_loadu_ps(scale + h * 8);
+        if (add_input) {
+            add_scale_vec[h] = _mm256_loadu_ps(add_scale + h * 8);
+        }
+        if (relu == 2) {
+            relu6_max_vec[h] = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((__m128i*)(relu6_max + h * 8))));
+        }
+    }
+
+    for (long w = 0; w < 4; ++w) {
+        auto dst_x = dst + w * dst_depth;
+        __m256 dst_8x32[2];
+        for (long h = 0; h < 2; ++h) {
+            dst_8x32[h] = _mm256_cvtepi32_ps(_mm256_add_epi32(dst_i32x8[w][h], bias_vec[h]));
+            dst_8x32[h] = _mm256_mul_ps(dst_8x32[h], scale_vec[h]);
+
+            if (relu == -1) {
+                dst_8x32[h] = _mm256_max_ps(dst_8x32[h], zero_f32x8);
+            }
+            if (add_input) {
+                __m128i add_input_i8x8 = _mm_loadl_epi64((__m128i*)(add_input + w * dst_depth + h * 8));
+                __m256 add_input_vec   = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(add_input_i8x8));
+                dst_8x32[h] = _mm256_add_ps(dst_8x32[h], _mm256_mul_ps(add_input_vec, add_scale_vec[h]));
+            }
+            if (relu == 1) {
+                dst_8x32[h] = _mm256_max_ps(dst_8x32[h], zero_f32x8);
+            }
+            // Conv-Add-Relu6
+            else if (relu == 2) {
+                dst_8x32[h] = _mm256_max_ps(dst_8x32[h], zero_f32x8);
+                dst_8x32[h] = _mm256_min_ps(dst_8x32[h], relu6_max_vec[h]);
+            }
+        }
+        F32X16ToI8X16(dst_8x32[0], dst_8x32[1], dst_x);
+    }
+}
+#endif
+
 static void DepthwiseI8K3Kernel(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias_z,
                                 long src_y_step, long src_w_step, long dst_depth, const float* scale_z,
                                 long dx, long dc) {
@@ -467,6 +647,69 @@ void X86DepthwiseI8K3(int8_t* dst, const int8_t* src, const int8_t* weight, cons
     }
 }
 
+/*
+vnni depthwise k3 kernel, 16 channels
+two taps are interleaved as int16 pairs, vpdpwssd accumulates both taps of a channel at once
+acc_0 holds channels [0, 4) and [8, 12), acc_1 holds channels [4, 8) and [12, 16)
+*/
+#define DECLARE_VNNI_DEPTHWISE_K3(isa, target, dpwssd)                                                               \
+    target static void isa##DepthwiseI8K3Kernel(int8_t* dst, const int8_t* src, const int8_t* weight,               \
+                                                const int32_t* bias_z, long src_y_step, long src_w_step,            \
+                                                long dst_depth, const float* scale_z, long dx, long dc) {           \
+        __m256i zero_i16  = _mm256_setzero_si256();                                                                 \
+        auto dst_x        = dst + dx * dst_depth + dc;                                                              \
+        const auto src_z  = src + dx * src_w_step + dc;                                                             \
+        const auto w_z    = weight + dc;                                                                            \
+        __m256i acc_0     = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(bias_z + dc))), \
+                                                    _mm_loadu_si128((__m128i*)(bias_z + dc + 8)), 1);               \
+        __m256i acc_1     = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((__m128i*)(bias_z + dc + 4))), \
+                                                    _mm_loadu_si128((__m128i*)(bias_z + dc + 12)), 1);              \
+        for (long k = 0; k < 9; k += 2) {                                                                           \
+            const auto src_k0 = src_z + (k / 3) * src_y_step + (k % 3) * dst_depth;                                 \
+            __m256i src_16_0  = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(src_k0)));                          \
+            __m256i w_16_0    = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(w_z + k * dst_depth)));             \
+            __m256i src_16_1  = zero_i16;                                                                           \
+            __m256i w_16_1    = zero_i16;                                                                           \
+            if (k + 1 < 9) {                                                                                        \
+                const auto src_k1 = src_z + ((k + 1) / 3) * src_y_step + ((k + 1) % 3) * dst_depth;                 \
+                src_16_1          = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(src_k1)));                      \
+                w_16_1            = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(w_z + (k + 1) * dst_depth)));  \
+            }                                                                                                       \
+            acc_0 = dpwssd(acc_0, _mm256_unpacklo_epi16(src_16_0, src_16_1), _mm256_unpacklo_epi16(w_16_0, w_16_1)); \
+            acc_1 = dpwssd(acc_1, _mm256_unpackhi_epi16(src_16_0, src_16_1), _mm256_unpackhi_epi16(w_16_0, w_16_1)); \
+        }                                                                                                           \
+        __m256 dst_8x32_0 = _mm256_cvtepi32_ps(_mm256_permute2x128_si256(acc_0, acc_1, 0x20));                      \
+        __m256 dst_8x32_1 = _mm256_cvtepi32_ps(_mm256_permute2x128_si256(acc_0, acc_1, 0x31));                      \
+        dst_8x32_0        = _mm256_mul_ps(dst_8x32_0, _mm256_loadu_ps(scale_z + dc));                               \
+        dst_8x32_1        = _mm256_mul_ps(dst_8x32_1, _mm256_loadu_ps(scale_z + dc + 8));                           \
+        F32X16ToI8X16(dst_8x32_0, dst_8x32_1, dst_x);                                                               \
+    }                                                                                                               \
+                                                                                                                    \
+    void X86##isa##DepthwiseI8K3(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias_z,       \
+                                 long width, long dilate_y_step, long dialte_x_step, long src_w_step,               \
+                                 long dst_depth, long fw, long fh, const float* scale_z) {                          \
+        for (long dx = 0; dx < width; dx++) {                                                                       \
+            long dc = 0;                                                                                            \
+            for (; dc < dst_depth - 15; dc += 16) {                                                                 \
+                isa##DepthwiseI8K3Kernel(dst, src, weight, bias_z, dilate_y_step, src_w_step, dst_depth, scale_z,   \
+                                         dx, dc);                                                                   \
+            }                                                                                                       \
+            if (dc < dst_depth) {                                                                                   \
+                dc = dst_depth - 16;                                                                                \
+                isa##DepthwiseI8K3Kernel(dst, src, weight, bias_z, dilate_y_step, src_w_step, dst_depth, scale_z,   \
+                                         dx, dc);                                                                   \
+            }                                                                                                       \
+        }                                                                                                           \
+    }
+
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+DECLARE_VNNI_DEPTHWISE_K3(AVX512VNNI, TNN_X86_AVX512_VNNI_TARGET, _mm256_dpwssd_epi32)
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+DECLARE_VNNI_DEPTHWISE_K3(AVXVNNI, TNN_X86_AVX_VNNI_TARGET, _mm256_dpwssd_avx_epi32)
+#endif
+
 void X86DepthwiseI8K5(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias_z, long width,
                    long dilate_y_step, long dialte_x_step, long src_w_step, long dst_depth, long fw, long fh,
                    const float* scale_z) {
@@ -913,6 +1156,117 @@ void X86GemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int
     }
 }
 
+#if defined(TNN_X86_AVX512_VNNI_ENABLE) || defined(TNN_X86_AVX_VNNI_ENABLE)
+// reduce 4 accumulators to [o0, o1, o2, o3], then requantize, the same as X86GemvInt8
+__attribute__((target("avx2,fma"))) static inline void VnniGemvInt8Store(int8_t* dst, __m256i acc0, __m256i acc1,
+                                                                          __m256i acc2, __m256i acc3,
+                                                                          const int32_t* bias, const float* scale) {
+    DeclareRounding();
+    __m128i acc0_4    = _mm_add_epi32(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    __m128i acc1_4    = _mm_add_epi32(_mm256_castsi256_si128(acc1), _mm256_extracti128_si256(acc1, 1));
+    __m128i acc2_4    = _mm_add_epi32(_mm256_castsi256_si128(acc2), _mm256_extracti128_si256(acc2, 1));
+    __m128i acc3_4    = _mm_add_epi32(_mm256_castsi256_si128(acc3), _mm256_extracti128_si256(acc3, 1));
+    __m128i dst_4xi32 = _mm_hadd_epi32(_mm_hadd_epi32(acc0_4, acc1_4), _mm_hadd_epi32(acc2_4, acc3_4));
+    __m128i bias_vec  = _mm_loadu_si128((__m128i*)(bias));
+    __m128 scale_vec  = _mm_loadu_ps(scale);
+    __m128 dst_4xf32  = _mm_cvtepi32_ps(_mm_add_epi32(dst_4xi32, bias_vec));
+    dst_4xf32         = _mm_mul_ps(dst_4xf32, scale_vec);
+
+    F32X4TOI8X4(dst_4xf32, dst);
+}
+#endif
+
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+#define FOLD_M512I(v) _mm256_add_epi32(_mm512_castsi512_si256(v), _mm512_extracti64x4_epi64(v, 1))
+
+TNN_X86_AVX512_VNNI_TARGET
+static void AVX512VNNIGemvInt8Unit(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                                   const float* scale, long ic_r4) {
+    const __m512i u8_offset = _mm512_set1_epi8((char)0x80);
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    __m512i acc2 = _mm512_setzero_si512();
+    __m512i acc3 = _mm512_setzero_si512();
+    auto weight_o_0 = weight;
+    auto weight_o_1 = weight_o_0 + ic_r4;
+    auto weight_o_2 = weight_o_1 + ic_r4;
+    auto weight_o_3 = weight_o_2 + ic_r4;
+
+    long c = 0;
+    for (; c + 63 < ic_r4; c += 64) {
+        __m512i a = _mm512_xor_si512(_mm512_loadu_si512((const void*)(src + c)), u8_offset);
+        acc0      = _mm512_dpbusd_epi32(acc0, a, _mm512_loadu_si512((const void*)(weight_o_0 + c)));
+        acc1      = _mm512_dpbusd_epi32(acc1, a, _mm512_loadu_si512((const void*)(weight_o_1 + c)));
+        acc2      = _mm512_dpbusd_epi32(acc2, a, _mm512_loadu_si512((const void*)(weight_o_2 + c)));
+        acc3      = _mm512_dpbusd_epi32(acc3, a, _mm512_loadu_si512((const void*)(weight_o_3 + c)));
+    }
+    if (c < ic_r4) {
+        // masked weights are zero, so the shifted input in the masked lanes adds nothing
+        __mmask64 mask = _cvtu64_mask64((1ULL << (ic_r4 - c)) - 1);
+        __m512i a      = _mm512_xor_si512(_mm512_maskz_loadu_epi8(mask, src + c), u8_offset);
+        acc0           = _mm512_dpbusd_epi32(acc0, a, _mm512_maskz_loadu_epi8(mask, weight_o_0 + c));
+        acc1           = _mm512_dpbusd_epi32(acc1, a, _mm512_maskz_loadu_epi8(mask, weight_o_1 + c));
+        acc2           = _mm512_dpbusd_epi32(acc2, a, _mm512_maskz_loadu_epi8(mask, weight_o_2 + c));
+        acc3           = _mm512_dpbusd_epi32(acc3, a, _mm512_maskz_loadu_epi8(mask, weight_o_3 + c));
+    }
+
+    VnniGemvInt8Store(dst, FOLD_M512I(acc0), FOLD_M512I(acc1), FOLD_M512I(acc2), FOLD_M512I(acc3), bias, scale);
+}
+
+#undef FOLD_M512I
+
+void X86AVX512VNNIGemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                           const float* scale, long ic_r4, long oc_r4) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long dc = 0; dc < oc_r4; dc += 4) {
+        AVX512VNNIGemvInt8Unit(dst + dc, src, weight + dc * ic_r4, bias + dc, scale + dc, ic_r4);
+    }
+}
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+TNN_X86_AVX_VNNI_TARGET
+static void AVXVNNIGemvInt8Unit(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                                const float* scale, long ic_r4) {
+    const __m256i u8_offset = _mm256_set1_epi8((char)0x80);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    auto weight_o_0 = weight;
+    auto weight_o_1 = weight_o_0 + ic_r4;
+    auto weight_o_2 = weight_o_1 + ic_r4;
+    auto weight_o_3 = weight_o_2 + ic_r4;
+
+    long c = 0;
+    for (; c + 31 < ic_r4; c += 32) {
+        __m256i a = _mm256_xor_si256(_mm256_loadu_si256((__m256i*)(src + c)), u8_offset);
+        acc0      = _mm256_dpbusd_avx_epi32(acc0, a, _mm256_loadu_si256((__m256i*)(weight_o_0 + c)));
+        acc1      = _mm256_dpbusd_avx_epi32(acc1, a, _mm256_loadu_si256((__m256i*)(weight_o_1 + c)));
+        acc2      = _mm256_dpbusd_avx_epi32(acc2, a, _mm256_loadu_si256((__m256i*)(weight_o_2 + c)));
+        acc3      = _mm256_dpbusd_avx_epi32(acc3, a, _mm256_loadu_si256((__m256i*)(weight_o_3 + c)));
+    }
+    for (; c < ic_r4; c += 4) {
+        __m256i a = _mm256_xor_si256(_mm256_castsi128_si256(_mm_cvtsi32_si128(*((int*)(src + c)))), u8_offset);
+        a         = _mm256_blend_epi32(_mm256_setzero_si256(), a, 0x01);
+        acc0      = _mm256_dpbusd_avx_epi32(acc0, a, _mm256_castsi128_si256(_mm_cvtsi32_si128(*((int*)(weight_o_0 + c)))));
+        acc1      = _mm256_dpbusd_avx_epi32(acc1, a, _mm256_castsi128_si256(_mm_cvtsi32_si128(*((int*)(weight_o_1 + c)))));
+        acc2      = _mm256_dpbusd_avx_epi32(acc2, a, _mm256_castsi128_si256(_mm_cvtsi32_si128(*((int*)(weight_o_2 + c)))));
+        acc3      = _mm256_dpbusd_avx_epi32(acc3, a, _mm256_castsi128_si256(_mm_cvtsi32_si128(*((int*)(weight_o_3 + c)))));
+    }
+
+    VnniGemvInt8Store(dst, acc0, acc1, acc2, acc3, bias, scale);
+}
+
+void X86AVXVNNIGemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                        const float* scale, long ic_r4, long oc_r4) {
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long dc = 0; dc < oc_r4; dc += 4) {
+        AVXVNNIGemvInt8Unit(dst + dc, src, weight + dc * ic_r4, bias + dc, scale + dc, ic_r4);
+    }
+}
+#endif
+
 static bool is_per_tensor_quant(const std::vector<Blob *> &inputs) {
     bool int8_per_tensor_flag = true;
     for (auto &blob : inputs) {
@@ -19,6 +19,7 @@
 #include "tnn/core/blob.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/layer_param.h"
+#include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
 
 namespace TNN_NS {
 
@@ -32,6 +33,26 @@ void X86SSEGemmInt8Unit4x4(const int8_t* src, const int8_t* weight, int8_t* dst,
                      const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
                      const float* add_scale, const int8_t* relu6_max);
 
+// vnni kernels take u8 input, the s8 input is shifted by 128 inside the kernels,
+// bias must be compensated by X86Int8VnniCompensation with the unpacked weights
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+void X86AVX512VNNIGemmInt8Unit4x16(const int8_t* src, const int8_t* weight, int8_t* dst, long src_w_step, long dst_depth,
+                     long cdiv8, const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
+                     const float* add_scale, const int8_t* relu6_max);
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+void X86AVXVNNIGemmInt8Unit4x16(const int8_t* src, const int8_t* weight, int8_t* dst, long src_w_step, long dst_depth,
+                     long cdiv8, const float* scale, const int32_t* bias, long relu, const int8_t* add_input,
+                     const float* add_scale, const int8_t* relu6_max);
+#endif
+
+// select the int8 dot product isa, fallback to arch if vnni is not supported
+x86_isa_t X86Int8GemmArch(x86_isa_t arch);
+
+// bias[o] -= 128 * sum(weight[o][0:k])
+void X86Int8VnniCompensation(int32_t* bias, const int8_t* weight, long oc, long k);
+
 void X86DepthwiseI8Unit(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias, long fw, long fh,
                      long weight_y_step, long dilate_y_step, long dilate_x_step, const float* scale, long dst_depth);
 
@@ -47,6 +68,18 @@ void X86DepthwiseI8K5(int8_t* dst, const int8_t* src, const int8_t* weight, cons
                    long dilate_y_step, long dialte_x_step, long src_w_step, long dst_depth, long fw, long fh,
                    const float* scale_z);
 
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+void X86AVX512VNNIDepthwiseI8K3(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias_z, long width,
+                   long dilate_y_step, long dialte_x_step, long src_w_step, long dst_depth, long fw, long fh,
+                   const float* scale_z);
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+void X86AVXVNNIDepthwiseI8K3(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias_z, long width,
+                   long dilate_y_step, long dialte_x_step, long src_w_step, long dst_depth, long fw, long fh,
+                   const float* scale_z);
+#endif
+
 void X86ReluInt8(int8_t* dst, const int8_t* src, long len);
 void X86Relu6Int8(int8_t* dst, const int8_t* src, const int8_t* relu6_max, long width, long dst_depth);
 
@@ -62,6 +95,16 @@ void X86MatrixAddInt8(int8_t* dst, const int8_t* A, const int8_t* B, float* dst_
 void X86GemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias, const float* scale,
                  long ic_r4, long oc_r4);
 
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+void X86AVX512VNNIGemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                           const float* scale, long ic_r4, long oc_r4);
+#endif
+
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+void X86AVXVNNIGemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                        const float* scale, long ic_r4, long oc_r4);
+#endif
+
 void X86ConcatChannelInt8(Blob *output, const std::vector<Blob *> &inputs);
 void X86ConcatCommonInt8(Blob *output, const std::vector<Blob *> &inputs, int axis);
 
@@ -22,6 +22,7 @@
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/omp_utils.h"
 #include "tnn/utils/naive_compute.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 using namespace x86;
@@ -63,19 +64,42 @@ Status X86ConvInt8LayerCommon::allocateBufferWeight(const std::vector<Blob *> &i
         const int icrs_g_r16 = ROUND_UP(ic_g_r4 * kw * kh, 16);
         const int icrs_g     = ic_g * kw * kh;
 
-        int weight_count   = group * oc_g_r4 * icrs_g_r16;
+        const bool use_vnni  = int8_arch_ == avx512_vnni || int8_arch_ == avx_vnni;
+        // vnni kernels compute 16 output channels at a time
+        const int oc_g_round = use_vnni ? ROUND_UP(oc_g, 16) : oc_g_r4;
+
+        int weight_count   = group * oc_g_round * icrs_g_r16;
         int data_byte_size = weight_count * DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
-        RawBuffer temp_buffer(data_byte_size + SIMD_KERNEL_EXTRA_LOAD);
-
-        for (int g = 0; g < group; g++) {
-            auto weight_src_g = conv_res->filter_handle.force_to<int8_t *>() + g * oc_g * icrs_g;
-            auto weight_dst_g = temp_buffer.force_to<int8_t *>() + g * oc_g_r4 * icrs_g_r16;
-            // from [o][i][h][w]
-            // to: [o/4][h][w][i/16][o4][i16]
-            PackINT8Weight(weight_src_g, weight_dst_g, ic_g, oc_g,
-                           conv_param->kernels[1], conv_param->kernels[0]);
+
+        auto pack_func = [&](RawBuffer &packed) {
+            RawBuffer temp_buffer(data_byte_size + SIMD_KERNEL_EXTRA_LOAD);
+
+            for (int g = 0; g < group; g++) {
+                auto weight_src_g = conv_res->filter_handle.force_to<int8_t *>() + g * oc_g * icrs_g;
+                auto weight_dst_g = temp_buffer.force_to<int8_t *>() + g * oc_g_round * icrs_g_r16;
+                if (use_vnni) {
+                    // from [o][i][h][w]
+                    // to: [o/16][h][w][i/4][o16][i4]
+                    PackINT8WeightVnni(weight_src_g, weight_dst_g, ic_g, oc_g,
+                                       conv_param->kernels[1], conv_param->kernels[0]);
+                } else {
+                    // from [o][i][h][w]
+                    // to: [o/4][h][w][i/16][o4][i16]
+                    PackINT8Weight(weight_src_g, weight_dst_g, ic_g, oc_g,
+                                   conv_param->kernels[1], conv_param->kernels[0]);
+                }
+            }
+            packed = temp_buffer;
+            return TNN_OK;
+        };
+        auto tag = "conv_int8" + VectorToString(std::vector<int>{use_vnni, group, ic_g, oc_g, kh, kw});
+        RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
+
+        // vnni kernels shift the input to u8, fold 128 * sum(weight) into bias
+        if (use_vnni) {
+            X86Int8VnniCompensation(buffer_bias_.force_to<int32_t *>(), conv_res->filter_handle.force_to<int8_t *>(),
+                                    oc, icrs_g);
         }
-        buffer_weight_ = temp_buffer;
     }
     return TNN_OK;
 }
@@ -324,6 +348,7 @@ Status X86ConvInt8LayerCommon::setFusionParam(const std::vector<Blob *> &inputs,
 Status X86ConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
                                     const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    int8_arch_ = X86Int8GemmArch(arch_);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(setFusionParam(inputs, outputs), TNN_OK);
@@ -374,9 +399,99 @@ Status X86ConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerRe
     return TNN_OK;
 }
 
+#if defined(TNN_X86_AVX512_VNNI_ENABLE) || defined(TNN_X86_AVX_VNNI_ENABLE)
+/*
+vnni gemm, 16 output channels per block
+partial blocks (output channels or hw) are computed into a tmp buffer
+*/
+static void GemmInt8Vnni(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
+                         const float* scale, int hw_tile, int src_depth_d8, int src_w_step, int dst_depth, int relu,
+                         const int8_t* add_input, const float* add_scale, const int8_t* relu6_max, x86_isa_t arch) {
+    const int src_depth_d16 = UP_DIV(src_depth_d8, 2);
+
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+    auto gemm_kernel = X86AVX512VNNIGemmInt8Unit4x16;
+#else
+    auto gemm_kernel = X86AVXVNNIGemmInt8Unit4x16;
+#endif
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+    if (arch == avx_vnni) {
+        gemm_kernel = X86AVXVNNIGemmInt8Unit4x16;
+    }
+#endif
+
+    for (int j = 0; j < dst_depth; j += 16) {
+        const int oc_count = MIN(dst_depth - j, 16);
+
+        const int32_t* bias_j     = bias + j;
+        const float* scale_j      = scale + j;
+        const float* add_scale_j  = add_input ? add_scale + j : nullptr;
+        const int8_t* relu6_max_j = relu == 2 ? relu6_max + j : nullptr;
+
+        int32_t bias_tmp[16]     = {0};
+        float scale_tmp[16]      = {0};
+        float add_scale_tmp[16]  = {0};
+        int8_t relu6_max_tmp[16] = {0};
+        if (oc_count < 16) {
+            memcpy(bias_tmp, bias_j, oc_count * sizeof(int32_t));
+            memcpy(scale_tmp, scale_j, oc_count * sizeof(float));
+            bias_j  = bias_tmp;
+            scale_j = scale_tmp;
+            if (add_scale_j) {
+                memcpy(add_scale_tmp, add_scale_j, oc_count * sizeof(float));
+                add_scale_j = add_scale_tmp;
+            }
+            if (relu6_max_j) {
+                memcpy(relu6_max_tmp, relu6_max_j, oc_count * sizeof(int8_t));
+                relu6_max_j = relu6_max_tmp;
+            }
+        }
+
+        for (int hw = 0; hw < hw_tile; hw += SIMD_INT8CONV_TILE_HW) {
+            auto src_hw       = src + hw * src_w_step;
+            auto dst_hw       = dst + hw * dst_depth + j;
+            auto add_input_hw = add_input ? add_input + hw * dst_depth + j : nullptr;
+            int real_hw_tile  = MIN(hw_tile - hw, SIMD_INT8CONV_TILE_HW);
+
+            if (real_hw_tile == SIMD_INT8CONV_TILE_HW && oc_count == 16) {
+                gemm_kernel(src_hw, weight, dst_hw, src_w_step, dst_depth, src_depth_d8,
+                            scale_j, bias_j, relu, add_input_hw, add_scale_j, relu6_max_j);
+                continue;
+            }
+
+            int8_t outptr_tmp[16 * SIMD_INT8CONV_TILE_HW]    = {0};
+            int8_t add_input_tmp[16 * SIMD_INT8CONV_TILE_HW] = {0};
+            int8_t *add_input_ptr_tmp = nullptr;
+
+            if (add_input) {
+                add_input_ptr_tmp = add_input_tmp;
+                for (int i = 0; i < real_hw_tile; i++) {
+                    memcpy(add_input_ptr_tmp + i * 16, add_input_hw + i * dst_depth, oc_count * sizeof(int8_t));
+                }
+            }
+            gemm_kernel(src_hw, weight, outptr_tmp, src_w_step, 16, src_depth_d8,
+                        scale_j, bias_j, relu, add_input_ptr_tmp, add_scale_j, relu6_max_j);
+
+            for (int i = 0; i < real_hw_tile; i++) {
+                memcpy(dst_hw + i * dst_depth, outptr_tmp + i * 16, oc_count * sizeof(int8_t));
+            }
+        }
+
+        weight += 16 * src_depth_d16 * 16;
+    }
+}
+#endif
+
 void GemmInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias,
               const float* scale, int hw_tile, int src_depth_d8, int src_w_step, int dst_depth, int relu,
               const int8_t* add_input, const float* add_scale, const int8_t* relu6_max, x86_isa_t arch) {
+#if defined(TNN_X86_AVX512_VNNI_ENABLE) || defined(TNN_X86_AVX_VNNI_ENABLE)
+    if (arch == avx512_vnni || arch == avx_vnni) {
+        GemmInt8Vnni(dst, src, weight, bias, scale, hw_tile, src_depth_d8, src_w_step, dst_depth, relu,
+                     add_input, add_scale, relu6_max, arch);
+        return;
+    }
+#endif
     const int src_depth_d16 = UP_DIV(src_depth_d8, 2);
 
     auto gemm_kernel = X86SSEGemmInt8Unit4x4;
@@ -463,7 +578,8 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
     auto output_channel_stride = DimsVectorUtils::Count(dims_output, 2);
     auto input_batch_stride    = input_channel_stride * ic_r4;
     auto output_batch_stride   = output_channel_stride * oc_r4;
-    auto kernel_group_stride   = oc_g_r4 * ROUND_UP(ic_g_r4 * conv_param->kernels[0] * conv_param->kernels[1], 16);
+    auto oc_g_round            = (int8_arch_ == avx512_vnni || int8_arch_ == avx_vnni) ? ROUND_UP(oc_g, 16) : oc_g_r4;
+    auto kernel_group_stride   = oc_g_round * ROUND_UP(ic_g_r4 * conv_param->kernels[0] * conv_param->kernels[1], 16);
 
     int8_t *input_data     = handle_ptr<int8_t *>(input->GetHandle());
     int8_t *output_data    = handle_ptr<int8_t *>(output->GetHandle());
@@ -546,7 +662,7 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
                 GemmInt8(output_kernel, input_kernel, weight_g, bias_g, scale_g,
                          real_hw_tile, crs_div8, crs_div8 * 8, oc_g_r4, relu_,
                          add_input_kernel, buffer_add_scale_.force_to<float *>(),
-                         relu6_max_g, arch_);
+                         relu6_max_g, int8_arch_);
             }
 
             if (conv_param->group > 1) {
@@ -58,6 +58,8 @@ protected:
 
     long relu_ = 0;
     int tile_blk_ = 32;
+    // int8 gemm isa, may be avx512_vnni or avx_vnni
+    x86_isa_t int8_arch_ = sse42;
 
     std::function<void(int8_t *, const int8_t *, const ConvLayerParam *, size_t, size_t, int,
                        DimsVector, DimsVector)> im_col_func_;
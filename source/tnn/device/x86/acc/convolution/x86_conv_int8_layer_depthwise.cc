@@ -20,6 +20,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 bool X86ConvInt8LayerDepthwise::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
@@ -59,18 +60,24 @@ Status X86ConvInt8LayerDepthwise::allocateBufferWeight(const std::vector<Blob *>
         const int channel  = inputs[0]->GetBlobDesc().dims[1];
         const int c_4      = ROUND_UP(channel, 4);
         int data_byte_size = c_4 * kh * kw;
-        RawBuffer temp_buffer(data_byte_size);
-        int8_t *temp_ptr = temp_buffer.force_to<int8_t *>();
-
-        for (int c = 0; c < channel; c++) {
-            int8_t *f_c = filter + c * kw * kh;
-            int8_t *t_c = temp_ptr + c;
-            for (int k = 0; k < kh * kw; k++) {
-                t_c[k * c_4] = f_c[k];
+
+        auto pack_func = [&](RawBuffer &packed) {
+            RawBuffer temp_buffer(data_byte_size);
+            int8_t *temp_ptr = temp_buffer.force_to<int8_t *>();
+
+            for (int c = 0; c < channel; c++) {
+                int8_t *f_c = filter + c * kw * kh;
+                int8_t *t_c = temp_ptr + c;
+                for (int k = 0; k < kh * kw; k++) {
+                    t_c[k * c_4] = f_c[k];
+                }
             }
-        }
 
-        buffer_weight_ = temp_buffer;
+            packed = temp_buffer;
+            return TNN_OK;
+        };
+        auto tag = "conv_int8_depthwise" + VectorToString(std::vector<int>{channel, kh, kw});
+        RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
     }
     return TNN_OK;
 }
@@ -152,6 +159,16 @@ Status X86ConvInt8LayerDepthwise::DoForward(const std::vector<Blob *> &inputs, c
 
         if (kernel_x == kernel_y && kernel_x == 3 && oc_r4 >= 8 && dilate_x == 1 && dilate_y == 1) {
             dwfunc = X86DepthwiseI8K3;
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+            if (int8_arch_ == avx512_vnni && oc_r4 >= 16) {
+                dwfunc = X86AVX512VNNIDepthwiseI8K3;
+            }
+#endif
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+            if (int8_arch_ == avx_vnni && oc_r4 >= 16) {
+                dwfunc = X86AVXVNNIDepthwiseI8K3;
+            }
+#endif
         } else if (kernel_x == kernel_y && kernel_x == 5 && oc_r4 >= 8 && dilate_x == 1 && dilate_y == 1) {
             dwfunc = X86DepthwiseI8K5;
         }
@@ -75,7 +75,7 @@ Status X86ConvLayer1x1::DoForward(const std::vector<Blob *> &inputs, const std::
     int k = dims_input[1];
 
     int max_num_threads = OMP_MAX_THREADS_NUM_;
-    conv_ajust_m_blk_size(max_num_threads, src_z_step, conv_gemm_conf_.M_c_);
+    conv_ajust_m_blk_size(max_num_threads, src_z_step, conv_gemm_conf_.M_c_, conv_gemm_conf_.m_block_);
 
     int m_c = conv_gemm_conf_.M_c_;
     int k_c = conv_gemm_conf_.K_c_;
@@ -13,6 +13,12 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
+
+#include <cfloat>
+#include <chrono>
+#include <map>
+#include <mutex>
+
 #include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/Float8.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
@@ -24,6 +30,8 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
+#include "tnn/utils/winograd_generator.h"
 
 namespace TNN_NS {
 
@@ -566,6 +574,186 @@ template void output_trans_post_2x4<Float8>(const float *src, int src_stride, in
 template void output_trans_post_2x4<Float4>(const float *src, int src_stride, int src_h_stride, float *dest,
                                             int dest_stride, int dest_h_stride, const float *bias_value, int relu_type);
 
+// F(2,3) reuses the hand-written kernels above, the transform matrices are ignored
+template <typename VEC>
+static void input_trans_f23(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                            int dest_h_stride, const float *BT) {
+    input_trans_4x4<VEC>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride);
+}
+
+template <typename VEC>
+static void output_trans_f23(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                             int dest_h_stride, const float *AT, const float *bias_value, int relu_type) {
+    output_trans_post_2x4<VEC>(src, src_stride, src_h_stride, dest, dest_stride, dest_h_stride, bias_value, relu_type);
+}
+
+// V = BT * d * B, BT is ALPHA x ALPHA row major, zero coefficients are skipped
+template <typename VEC, int ALPHA>
+static void input_trans_generic(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                                int dest_h_stride, const float *BT) {
+    VEC d[ALPHA];
+    VEC t[ALPHA][ALPHA];
+    for (int y = 0; y < ALPHA; y++) {
+        const float *src_y = src + y * src_h_stride;
+        for (int x = 0; x < ALPHA; x++) {
+            d[x] = VEC::loadu(src_y + x * src_stride);
+        }
+        for (int b = 0; b < ALPHA; b++) {
+            const float *bt = BT + b * ALPHA;
+            VEC acc         = VEC(0.f);
+            for (int x = 0; x < ALPHA; x++) {
+                if (bt[x] != 0.f) {
+                    VEC::mla(acc, d[x], VEC(bt[x]));
+                }
+            }
+            t[b][y] = acc;
+        }
+    }
+
+    for (int b = 0; b < ALPHA; b++) {
+        float *dest_b = dest + b * dest_h_stride;
+        for (int a = 0; a < ALPHA; a++) {
+            const float *bt = BT + a * ALPHA;
+            VEC acc         = VEC(0.f);
+            for (int y = 0; y < ALPHA; y++) {
+                if (bt[y] != 0.f) {
+                    VEC::mla(acc, t[b][y], VEC(bt[y]));
+                }
+            }
+            VEC::saveu(dest_b + a * dest_stride, acc);
+        }
+    }
+}
+
+// Y = AT * M * A, AT is N x ALPHA row major, bias and relu are fused
+template <typename VEC, int ALPHA, int N>
+static void output_trans_generic(const float *src, int src_stride, int src_h_stride, float *dest, int dest_stride,
+                                 int dest_h_stride, const float *AT, const float *bias_value, int relu_type) {
+    VEC m[ALPHA];
+    VEC t[N][ALPHA];
+    for (int x = 0; x < ALPHA; x++) {
+        const float *src_x = src + x * src_h_stride;
+        for (int y = 0; y < ALPHA; y++) {
+            m[y] = VEC::loadu(src_x + y * src_stride);
+        }
+        for (int o = 0; o < N; o++) {
+            const float *at = AT + o * ALPHA;
+            VEC acc         = VEC(0.f);
+            for (int y = 0; y < ALPHA; y++) {
+                if (at[y] != 0.f) {
+                    VEC::mla(acc, m[y], VEC(at[y]));
+                }
+            }
+            t[o][x] = acc;
+        }
+    }
+
+    VEC bias  = bias_value ? VEC::loadu(bias_value) : VEC(0.f);
+    VEC zeros = VEC(0.f);
+    VEC sixs  = VEC(6.f);
+    for (int oy = 0; oy < N; oy++) {
+        float *dest_y = dest + oy * dest_h_stride;
+        for (int ox = 0; ox < N; ox++) {
+            const float *at = AT + ox * ALPHA;
+            VEC acc         = bias;
+            for (int x = 0; x < ALPHA; x++) {
+                if (at[x] != 0.f) {
+                    VEC::mla(acc, t[oy][x], VEC(at[x]));
+                }
+            }
+            if (relu_type == ActivationType_ReLU || relu_type == ActivationType_ReLU6) {
+                acc = VEC::max(acc, zeros);
+            }
+            if (relu_type == ActivationType_ReLU6) {
+                acc = VEC::min(acc, sixs);
+            }
+            VEC::saveu(dest_y + ox * dest_stride, acc);
+        }
+    }
+}
+
+// winograd F(m,3) matrices, G is alpha x 3, BT is alpha x alpha and AT is m x alpha, all row major.
+// F(2,3) keeps the matrices of the hand-written kernels, larger tiles are built by WinogradGenerator.
+static void GetWinogradMatrix(int dst_unit, std::vector<float> &G, std::vector<float> &BT, std::vector<float> &AT) {
+    const int alpha = dst_unit + 2;
+    if (dst_unit == 2) {
+        G  = {1.0f, 0.0f, 0.0f, 0.5f, 0.5f, 0.5f, 0.5f, -0.5f, 0.5f, 0.0f, 0.0f, 1.0f};
+        BT = {1.0f, 0.0f, -1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f};
+        AT = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, -1.0f, -1.0f};
+        return;
+    }
+
+    WinogradGenerator generator(dst_unit, 3, 0.5f);
+    const float *g = std::get<0>(generator.G()).get();
+    const float *b = std::get<0>(generator.B()).get();
+    const float *a = std::get<0>(generator.A()).get();
+    G.assign(g, g + alpha * 3);
+    BT.resize(alpha * alpha);
+    AT.resize(dst_unit * alpha);
+    for (int i = 0; i < alpha; i++) {
+        for (int j = 0; j < alpha; j++) {
+            BT[i * alpha + j] = b[j * alpha + i];
+        }
+        for (int o = 0; o < dst_unit; o++) {
+            AT[o * alpha + i] = a[i * dst_unit + o];
+        }
+    }
+}
+
+static int CountNonZero(const std::vector<float> &matrix) {
+    int count = 0;
+    for (auto v : matrix) {
+        count += v != 0.f ? 1 : 0;
+    }
+    return count;
+}
+
+// estimated cost in multiply-adds of F(dst_unit,3) on one image: the gemm over alpha^2 points plus the
+// input and output transforms, tiles cut by the output border are counted in full.
+static double WinogradCost(int dst_unit, int ic, int oc, int oh, int ow, int ch_pack) {
+    std::vector<float> G, BT, AT;
+    GetWinogradMatrix(dst_unit, G, BT, AT);
+
+    const int alpha     = dst_unit + 2;
+    const double tiles  = (double)UP_DIV(oh, dst_unit) * UP_DIV(ow, dst_unit);
+    const double ic_pad = ROUND_UP(ic, ch_pack);
+    const double oc_pad = ROUND_UP(oc, ch_pack);
+
+    const double gemm_cost   = (double)alpha * alpha * ic_pad * oc_pad;
+    const double input_cost  = 2.0 * alpha * CountNonZero(BT) * ic_pad;
+    const double output_cost = (double)(alpha + dst_unit) * CountNonZero(AT) * oc_pad;
+    // transforms are bound by loads and stores, weight them above the register blocked gemm,
+    // the generic kernels of the larger tiles run about half as fast as the hand-written F(2,3) ones
+    const double trans_weight = dst_unit == 2 ? 2.0 : 4.0;
+    return tiles * (gemm_cost + trans_weight * (input_cost + output_cost));
+}
+
+static const int kWinogradDstUnits[] = {2, 4, 6};
+
+// pick the output tile with the lowest estimated cost, tiles larger than the output are never chosen
+static int SelectDstUnit(int ic, int oc, int oh, int ow, int ch_pack, double *cost = nullptr) {
+    int best_unit    = 2;
+    double best_cost = WinogradCost(2, ic, oc, oh, ow, ch_pack);
+    for (auto unit : kWinogradDstUnits) {
+        if (unit == 2 || unit > oh || unit > ow) {
+            continue;
+        }
+        double unit_cost = WinogradCost(unit, ic, oc, oh, ow, ch_pack);
+        if (unit_cost < best_cost) {
+            best_unit = unit;
+            best_cost = unit_cost;
+        }
+    }
+    if (cost) {
+        *cost = best_cost;
+    }
+    return best_unit;
+}
+
+// output tile chosen for each layer shape, shared by all instances
+static std::mutex g_dst_unit_mutex;
+static std::map<std::vector<int>, int> g_dst_unit_cache;
+
 bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                                  const std::vector<Blob *> &outputs) {
     if (!param) {
@@ -584,11 +772,122 @@ bool X86ConvLayer3x3::isPrefered(ConvLayerParam *param, const std::vector<Blob *
     const int sh = param->strides[1];
     const int ic = inputs[0]->GetBlobDesc().dims[1];
 
-    return kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1 && ic >= 16;
+    if (!(kw == 3 && kh == 3 && dw == 1 && dh == 1 && sw == 1 && sh == 1 && ic >= 8)) {
+        return false;
+    }
+
+    // winograd only pays off when the transforms are cheaper than the multiplications they save
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    const int oc     = dims_output[1];
+    const int oh     = dims_output[2];
+    const int ow     = dims_output[3];
+    double winograd_cost = 0;
+    SelectDstUnit(ic, oc, oh, ow, 8, &winograd_cost);
+    return winograd_cost < 9.0 * oh * ow * ic * oc;
 }
 
 X86ConvLayer3x3::~X86ConvLayer3x3() {}
 
+Status X86ConvLayer3x3::Init(Context *context, LayerParam *param, LayerResource *resource,
+                             const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    auto dims_input   = inputs[0]->GetBlobDesc().dims;
+    auto dims_output  = outputs[0]->GetBlobDesc().dims;
+    const int tune    = context_->GetEnableTuneKernel() ? 1 : 0;
+    const int ch_pack = arch_ == avx2 ? 8 : 4;
+
+    std::vector<int> key = dims_input;
+    key.insert(key.end(), dims_output.begin(), dims_output.end());
+    key.push_back(ch_pack);
+    key.push_back(tune);
+
+    int dst_unit = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_dst_unit_mutex);
+        auto iter = g_dst_unit_cache.find(key);
+        if (iter != g_dst_unit_cache.end()) {
+            dst_unit = iter->second;
+        }
+    }
+    if (dst_unit == 0) {
+        if (tune) {
+            RETURN_ON_NEQ(MeasureDstUnit(inputs, outputs, dst_unit), TNN_OK);
+        } else {
+            dst_unit = SelectDstUnit(dims_input[1], dims_output[1], dims_output[2], dims_output[3], ch_pack);
+        }
+        std::lock_guard<std::mutex> lock(g_dst_unit_mutex);
+        g_dst_unit_cache[key] = dst_unit;
+    }
+
+    SetDstUnit(dst_unit);
+    return allocateBufferWeight(inputs, outputs);
+}
+
+void X86ConvLayer3x3::SetDstUnit(int dst_unit) {
+    dst_unit_ = dst_unit;
+    GetWinogradMatrix(dst_unit_, weight_trans_matrix_, input_trans_matrix_, output_trans_matrix_);
+}
+
+// time every candidate tile once on the layer shape and keep the fastest one
+Status X86ConvLayer3x3::MeasureDstUnit(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                       int &dst_unit) {
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    std::vector<float> src(DimsVectorUtils::Count(dims_input), 0.f);
+    std::vector<float> dst(DimsVectorUtils::Count(dims_output), 0.f);
+
+    const int ch_pack = arch_ == avx2 ? 8 : 4;
+    dst_unit = SelectDstUnit(dims_input[1], dims_output[1], dims_output[2], dims_output[3], ch_pack);
+    float best_time = FLT_MAX;
+    for (auto unit : kWinogradDstUnits) {
+        if (unit != 2 && (unit > dims_output[2] || unit > dims_output[3])) {
+            continue;
+        }
+        SetDstUnit(unit);
+        RETURN_ON_NEQ(PackWeight(inputs, outputs, buffer_weight_), TNN_OK);
+
+        // the first run warms up caches and workspace
+        RETURN_ON_NEQ(ExecWinograd(src.data(), dst.data(), dims_input, dims_output), TNN_OK);
+        auto start = std::chrono::steady_clock::now();
+        RETURN_ON_NEQ(ExecWinograd(src.data(), dst.data(), dims_input, dims_output), TNN_OK);
+        float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed < best_time) {
+            best_time = elapsed;
+            dst_unit  = unit;
+        }
+    }
+    buffer_weight_ = RawBuffer();
+    return TNN_OK;
+}
+
+Status X86ConvLayer3x3::PackWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                   RawBuffer &packed) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    const float *src = conv_res->filter_handle.force_to<float *>();
+    auto CH_PACK     = 4;
+    if (arch_ == avx2)
+        CH_PACK = 8;
+
+    const int src_unit       = dst_unit_ + 2;
+    const int input_channel  = inputs[0]->GetBlobDesc().dims[1];
+    const int output_channel = outputs[0]->GetBlobDesc().dims[1];
+    const int weight_count   = ROUND_UP(input_channel, CH_PACK) * ROUND_UP(output_channel, CH_PACK) * src_unit * src_unit;
+
+    RawBuffer pack_buffer(weight_count * sizeof(float));
+    float *dst = pack_buffer.force_to<float *>();
+
+    auto G = reinterpret_cast<const float(*)[3]>(weight_trans_matrix_.data());
+    weight_transform(src, dst, 3, src_unit, input_channel, output_channel, CH_PACK, G);
+
+    pack_buffer.SetDataType(DATA_TYPE_FLOAT);
+    packed = pack_buffer;
+    return TNN_OK;
+}
+
 Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -599,25 +898,20 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
     auto dims_output = outputs[0]->GetBlobDesc().dims;
 
     if (!buffer_weight_.GetBytesSize()) {
-        const float *src = conv_res->filter_handle.force_to<float *>();
-        auto CH_PACK     = 4;
+        auto CH_PACK = 4;
         if (arch_ == avx2)
             CH_PACK = 8;
 
         const int input_channel  = dims_input[1];
         const int output_channel = dims_output[1];
-        const int weight_count   = ROUND_UP(input_channel, CH_PACK) * ROUND_UP(output_channel, CH_PACK) * 4 * 4;
-        const int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer pack_buffer(weight_count * data_byte_size);
-            float *dst = pack_buffer.force_to<float *>();
-
-            const float G[4][3] = {{1.0f, 0.0f, 0.0f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}};
-            weight_transform(src, dst, 3, 4, input_channel, output_channel, CH_PACK, G);
-
-            pack_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = pack_buffer;
+            auto pack_func = [&](RawBuffer &packed) {
+                return PackWeight(inputs, outputs, packed);
+            };
+            auto tag = "conv_winograd_f" +
+                       VectorToString(std::vector<int>{dst_unit_, input_channel, output_channel, CH_PACK});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -637,8 +931,6 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
 // #define CH_PACK 8
 
 Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
-
     auto input       = inputs[0];
     auto output      = outputs[0];
     auto dims_input  = input->GetBlobDesc().dims;
@@ -647,6 +939,13 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
     auto src_origin = handle_ptr<float *>(input->GetHandle());
     auto dst_origin = handle_ptr<float *>(output->GetHandle());
 
+    return ExecWinograd(src_origin, dst_origin, dims_input, dims_output);
+}
+
+Status X86ConvLayer3x3::ExecWinograd(const float *src_origin, float *dst_origin, const DimsVector &dims_input,
+                                     const DimsVector &dims_output) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+
     const int batch       = dims_output[0];
     const int channel_in  = dims_input[1];
     const int height_in   = dims_input[2];
@@ -665,15 +964,29 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
     int ic_stride    = width_in * height_in;
     int oc_stride    = width_out * height_out;
 
-    auto input_trans_func  = input_trans_4x4<Float4>;
-    auto output_trans_func = output_trans_post_2x4<Float4>;
+    auto input_trans_func  = input_trans_f23<Float4>;
+    auto output_trans_func = output_trans_f23<Float4>;
     auto pack_func         = pack_input_c4;
     auto unpack_func       = unpack_output_c4;
     auto gemm_func         = gemm_kernel_avx<Float4, 6, 4, 4>;
     auto CH_PACK           = 4;
+    if (dst_unit_ == 4) {
+        input_trans_func  = input_trans_generic<Float4, 6>;
+        output_trans_func = output_trans_generic<Float4, 6, 4>;
+    } else if (dst_unit_ == 6) {
+        input_trans_func  = input_trans_generic<Float4, 8>;
+        output_trans_func = output_trans_generic<Float4, 8, 6>;
+    }
     if (arch_ == avx2) {
-        input_trans_func  = input_trans_4x4<Float8>;
-        output_trans_func = output_trans_post_2x4<Float8>;
+        input_trans_func  = input_trans_f23<Float8>;
+        output_trans_func = output_trans_f23<Float8>;
+        if (dst_unit_ == 4) {
+            input_trans_func  = input_trans_generic<Float8, 6>;
+            output_trans_func = output_trans_generic<Float8, 6, 4>;
+        } else if (dst_unit_ == 6) {
+            input_trans_func  = input_trans_generic<Float8, 8>;
+            output_trans_func = output_trans_generic<Float8, 8, 6>;
+        }
         pack_func         = pack_input_c8;
         unpack_func       = unpack_output_c8;
         gemm_func         = gemm_kernel_avx<Float8, 6, 8, 8>;
@@ -683,8 +996,10 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
     int ic_8 = UP_DIV(channel_in, CH_PACK);
     int oc_8 = UP_DIV(channel_out, CH_PACK);
 
-    const int src_unit = 4;
-    const int dst_unit = 2;
+    const int dst_unit = dst_unit_;
+    const int src_unit = dst_unit + 2;
+    const float *BT    = input_trans_matrix_.data();
+    const float *AT    = output_trans_matrix_.data();
     int w_unit         = UP_DIV(width_out, dst_unit);
     int h_unit         = UP_DIV(height_out, dst_unit);
     int total_cnt      = UP_DIV(w_unit * h_unit, TILE_NUM);
@@ -757,14 +1072,15 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                     for (int ci = 0; ci < ic_8; ++ci) {
                         const float *src_ci = src_ptr + ci * ic_8_stride;
                         float *dst_ci       = dst_ptr + ci * tile_count * CH_PACK;
-                        input_trans_func(src_ci, CH_PACK, w_pad * CH_PACK, dst_ci, b_gi_stride, b_gi_stride * src_unit);
+                        input_trans_func(src_ci, CH_PACK, w_pad * CH_PACK, dst_ci, b_gi_stride, b_gi_stride * src_unit,
+                                         BT);
                     }
                 } else {
                     int x_size = ex;
                     for (int ci = 0; ci < ic_8; ++ci) {
                         const float *src_ci = src_ptr + ci * ic_8_stride;
                         // pad
-                        memset(src_trans_tmp_per_thread, 0, 16 * CH_PACK * sizeof(float));  // src_unit * src_unit * ch_pack
+                        memset(src_trans_tmp_per_thread, 0, src_unit * src_unit * CH_PACK * sizeof(float));
                         if (x_size > 0) {
                             for (int yi = 0; yi < ey; ++yi) {
                                 float *dst_yi       = src_trans_tmp_per_thread + yi * src_unit * CH_PACK;
@@ -776,14 +1092,14 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                         // trans
                         float *dst_ci = dst_ptr + ci * tile_count * CH_PACK;
                         input_trans_func(src_trans_tmp_per_thread, CH_PACK, src_unit * CH_PACK, dst_ci, b_gi_stride,
-                                         b_gi_stride * src_unit);
+                                         b_gi_stride * src_unit, BT);
                     }
                 }
             }
 
             // ---------------------------------------- gemm func ----------------------------------------
             // gemm
-            float *dst_temp_data = tmp_data + TILE_NUM * ic_8 * 16 * CH_PACK;  // src_unit * src_unit * ch_pack
+            float *dst_temp_data = tmp_data + TILE_NUM * ic_8 * src_unit * src_unit * CH_PACK;
             float *b_ptr         = tmp_data;
             int w_gi_stride      = ic_8 * oc_8 * CH_PACK * CH_PACK;
             OMP_PARALLEL_FOR_GUIDED_
@@ -817,14 +1133,14 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                 float *dst_ptr = output_ptr + (dst_y * width_out + dst_x) * CH_PACK;
                 float *src_ptr = dst_temp_data + ti * CH_PACK;
 
-                if (ex == 2) {
+                if (ex == dst_unit) {
                     // trans output
                     for (int ci = 0; ci < oc_8; ++ci) {
                         const float *bias_ci = bias_ptr + ci * CH_PACK;
                         float *dst_ci = dst_ptr + ci * oc_8_stride;
                         float *src_ci = src_ptr + ci * tile_count * CH_PACK;
                         output_trans_func(src_ci, c_gi_stride, c_gi_stride * src_unit, src_trans_tmp_per_thread, CH_PACK,
-                                          dst_unit * CH_PACK, bias_ci, param->activation_type);
+                                          dst_unit * CH_PACK, AT, bias_ci, param->activation_type);
                         unpack_func(src_trans_tmp_per_thread, output_ptr, ci * CH_PACK, ci * CH_PACK + CH_PACK, dst_y,
                                     dst_y + ey, dst_x, dst_x + ex, channel_out, height_out, width_out, false, zero_ptr);
                     }
@@ -835,9 +1151,9 @@ Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::
                         float *dst_ci = dst_ptr + ci * oc_8_stride;
                         float *src_ci = src_ptr + ci * tile_count * CH_PACK;
                         output_trans_func(src_ci, c_gi_stride, c_gi_stride * src_unit, src_trans_tmp_per_thread, CH_PACK,
-                                          dst_unit * CH_PACK, bias_ci, param->activation_type);
+                                          dst_unit * CH_PACK, AT, bias_ci, param->activation_type);
                         // copy to dest
-                        memset(dst_trans_tmp_per_thread, 0, 4 * CH_PACK * sizeof(float));  // dst_unit * dst_unit * ch_pack
+                        memset(dst_trans_tmp_per_thread, 0, dst_unit * dst_unit * CH_PACK * sizeof(float));
                         for (int i = 0; i < ey; ++i) {
                             memcpy(dst_trans_tmp_per_thread + i * ex * CH_PACK, src_trans_tmp_per_thread + i * CH_PACK * dst_unit,
                                    ex * sizeof(float) * CH_PACK);
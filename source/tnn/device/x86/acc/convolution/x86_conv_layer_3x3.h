@@ -23,12 +23,28 @@ class X86ConvLayer3x3: public X86ConvLayerCommon {
 public:
     virtual ~X86ConvLayer3x3();
 
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                        const std::vector<Blob *> &outputs);
+
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    // select F(m,3) with m in {2, 4, 6} and build its transform matrices
+    void SetDstUnit(int dst_unit);
+    Status MeasureDstUnit(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, int &dst_unit);
+    Status PackWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs, RawBuffer &packed);
+    Status ExecWinograd(const float *src, float *dst, const DimsVector &dims_input, const DimsVector &dims_output);
+
+    // output tile size of the winograd transform, chosen once per layer shape
+    int dst_unit_ = 2;
+    std::vector<float> weight_trans_matrix_;
+    std::vector<float> input_trans_matrix_;
+    std::vector<float> output_trans_matrix_;
 };
 
 }  // namespace TNN_NS
@@ -18,6 +18,7 @@
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_1x1.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_3x3.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_common.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_nchwc.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_common.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_int8_layer_depthwise.h"
 
@@ -29,7 +30,11 @@ X86ConvLayerCommon always as the last solution
 */
 void X86ConvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
                                          LayerParam *param, std::shared_ptr<X86LayerAcc> &conv_acc_impl) {
-    if (X86ConvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+    if (X86ConvLayerNCHWc::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+        if (!dynamic_cast<X86ConvLayerNCHWc *>(conv_acc_impl.get())) {
+            conv_acc_impl = std::make_shared<X86ConvLayerNCHWc>();
+        }
+    } else if (X86ConvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
         if (!dynamic_cast<X86ConvLayerDepthwise *>(conv_acc_impl.get())) {
             conv_acc_impl = std::make_shared<X86ConvLayerDepthwise>();
         }
@@ -16,6 +16,7 @@
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 /*
@@ -55,17 +56,22 @@ Status X86ConvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &input
         const float *src = conv_res->filter_handle.force_to<float *>();
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
-            float *dst = temp_buffer.force_to<float *>();
-
-            for (int g = 0; g < param->group; g++) {
-                auto src_g = src + K * M * g;
-                auto dst_g = dst + weight_pack_per_group * g;
-                conv_pack_col_b_n(M, K, src_g, K, dst_g, conv_gemm_conf_);
-            }
-
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
+                float *dst = temp_buffer.force_to<float *>();
+
+                for (int g = 0; g < param->group; g++) {
+                    auto src_g = src + K * M * g;
+                    auto dst_g = dst + weight_pack_per_group * g;
+                    conv_pack_col_b_n(M, K, src_g, K, dst_g, conv_gemm_conf_);
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            auto tag = "conv_gemm_b" + VectorToString(std::vector<int>{param->group, K, M, k_c, n_block});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -128,7 +134,7 @@ Status X86ConvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const st
     size_t col_offset_ = param->kernels[0] * param->kernels[1] * oh * ow * (input_dims[1] / param->group);
 
     int max_num_threads = OMP_MAX_THREADS_NUM_;
-    conv_ajust_m_blk_size(max_num_threads, conv_out_spatial_dim_, conv_gemm_conf_.M_c_);
+    conv_ajust_m_blk_size(max_num_threads, conv_out_spatial_dim_, conv_gemm_conf_.M_c_, conv_gemm_conf_.m_block_);
 
     int m_c = conv_gemm_conf_.M_c_;
     int k_c = conv_gemm_conf_.K_c_;
@@ -21,6 +21,7 @@
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 using namespace x86;
@@ -62,16 +63,21 @@ Status X86ConvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &in
         int data_byte_size = DataTypeUtils::GetBytesSize(conv_res->filter_handle.GetDataType());
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            RawBuffer temp_buffer(weight_count * data_byte_size);
-            float *dst = temp_buffer.force_to<float *>();
-
-            if (arch_ == avx2) {
-                PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
-            } else if (arch_ == sse42) {
-                PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
-            }
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(weight_count * data_byte_size);
+                float *dst = temp_buffer.force_to<float *>();
+
+                if (arch_ == avx2) {
+                    PackC8(dst, src, kh * kw, kh * kw, kh * kw, group);
+                } else if (arch_ == sse42) {
+                    PackC4(dst, src, kh * kw, kh * kw, kh * kw, group);
+                }
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            auto tag = "conv_depthwise" + VectorToString(std::vector<int>{arch_, group, kh, kw});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -0,0 +1,356 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_nchwc.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/x86_context.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+#include "tnn/utils/string_format.h"
+
+namespace TNN_NS {
+
+/*
+X86ConvLayerNCHWc runs the conv when the input blob is blocked as nc8hw8,
+group 1 and depthwise conv are vectorized over 8 output channels.
+*/
+bool X86ConvLayerNCHWc::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                   const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+
+    return inputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8;
+}
+
+X86ConvLayerNCHWc::~X86ConvLayerNCHWc() {}
+
+std::vector<DataFormat> X86ConvLayerNCHWc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
+static bool IsDepthwise(ConvLayerParam *param, int input_channel, int output_channel) {
+    return param->group == input_channel && param->group == output_channel;
+}
+
+Status X86ConvLayerNCHWc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (buffer_weight_.GetBytesSize()) {
+        return TNN_OK;
+    }
+    if (conv_res->filter_handle.GetDataType() != DATA_TYPE_FLOAT) {
+        LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
+        return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+    }
+
+    const int ic          = inputs[0]->GetBlobDesc().dims[1];
+    const int oc          = outputs[0]->GetBlobDesc().dims[1];
+    const int ic_block    = UP_DIV(ic, 8);
+    const int kernel_size = param->kernels[0] * param->kernels[1];
+    const float *src      = conv_res->filter_handle.force_to<float *>();
+
+    std::string tag;
+    size_t weight_count = 0;
+    std::function<void(float *)> pack;
+    if (param->group == 1) {
+        // [oc/8][ic/8][kh][kw][8 ic][8 oc]
+        weight_count = UP_DIV(oc, 8) * ic_block * kernel_size * 64;
+        tag          = "conv_nchwc_gemm";
+        pack         = [&](float *dst) {
+            for (int o = 0; o < oc; o++) {
+                for (int i = 0; i < ic; i++) {
+                    for (int k = 0; k < kernel_size; k++) {
+                        dst[((((o / 8) * ic_block + i / 8) * kernel_size + k) * 8 + i % 8) * 8 + o % 8] =
+                            src[(o * ic + i) * kernel_size + k];
+                    }
+                }
+            }
+        };
+    } else if (IsDepthwise(param, ic, oc)) {
+        // [c/8][kh][kw][8 c]
+        weight_count = UP_DIV(oc, 8) * kernel_size * 8;
+        tag          = "conv_nchwc_depthwise";
+        pack         = [&](float *dst) {
+            for (int c = 0; c < oc; c++) {
+                for (int k = 0; k < kernel_size; k++) {
+                    dst[((c / 8) * kernel_size + k) * 8 + c % 8] = src[c * kernel_size + k];
+                }
+            }
+        };
+    } else {
+        weight_count = oc * (ic / param->group) * kernel_size;
+        tag          = "conv_nchwc_group";
+        pack         = [&](float *dst) {
+            memcpy(dst, src, weight_count * sizeof(float));
+        };
+    }
+
+    auto pack_func = [&](RawBuffer &packed) {
+        RawBuffer temp_buffer(weight_count * sizeof(float));
+        float *dst = temp_buffer.force_to<float *>();
+        memset(dst, 0, weight_count * sizeof(float));
+        pack(dst);
+        temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+        packed = temp_buffer;
+        return TNN_OK;
+    };
+    tag += VectorToString(std::vector<int>{param->group, ic, oc, param->kernels[1], param->kernels[0]});
+    return GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_);
+}
+
+static inline Float8 ActivationNCHWc(const Float8 &v, int activation_type) {
+    if (activation_type == ActivationType_ReLU) {
+        return Float8::max(v, Float8(0.f));
+    } else if (activation_type == ActivationType_ReLU6) {
+        return Float8::min(Float8::max(v, Float8(0.f)), Float8(6.f));
+    }
+    return v;
+}
+
+static inline float ActivationNCHWc(float v, int activation_type) {
+    if (activation_type == ActivationType_ReLU) {
+        return std::max(v, 0.f);
+    } else if (activation_type == ActivationType_ReLU6) {
+        return std::min(std::max(v, 0.f), 6.f);
+    }
+    return v;
+}
+
+// accumulate tile output pixels of one output channel block over the real lanes of one input channel block
+template <int tile>
+static inline void ConvNCHWcKernel(Float8 *acc, const float *const *src, const float *weight, int lanes) {
+    for (int l = 0; l < lanes; l++) {
+        Float8 w = Float8::loadu(weight + l * 8);
+        for (int j = 0; j < tile; j++) {
+            Float8::mla(acc[j], Float8(src[j] + l), w);
+        }
+    }
+}
+
+Status X86ConvLayerNCHWc::ExecGemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int ic = dims_input[1], ih = dims_input[2], iw = dims_input[3];
+    const int oc = dims_output[1], oh = dims_output[2], ow = dims_output[3];
+    const int kw = param->kernels[0], kh = param->kernels[1];
+    const int sw = param->strides[0], sh = param->strides[1];
+    const int dw = param->dialations[0], dh = param->dialations[1];
+    const int pl = param->pads[0], pt = param->pads[2];
+    const int ic_block    = UP_DIV(ic, 8);
+    const int oc_block    = UP_DIV(oc, 8);
+    const int kernel_size = kh * kw;
+    const int act_type    = param->activation_type;
+
+    auto input_data   = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data  = handle_ptr<float *>(outputs[0]->GetHandle());
+    auto weights_data = buffer_weight_.force_to<float *>();
+    auto bias_data    = buffer_bias_.force_to<float *>();
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        auto src_b = input_data + b * ic_block * ih * iw * 8;
+        auto dst_b = output_data + b * oc_block * oh * ow * 8;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int task = 0; task < oc_block * oh; task++) {
+            const int ocb = task / oh;
+            const int oy  = task % oh;
+            // out of bound pixels read the zero padding
+            float zero_pad[8] = {0.f};
+            const float *src[8];
+            auto dst_row    = dst_b + (ocb * oh + oy) * ow * 8;
+            auto weight_ocb = weights_data + ocb * ic_block * kernel_size * 64;
+            Float8 bias_v   = Float8::loadu(bias_data + ocb * 8);
+
+            for (int ox = 0; ox < ow; ox += 8) {
+                const int tile = MIN(8, ow - ox);
+                Float8 acc[8];
+                for (int j = 0; j < 8; j++) {
+                    acc[j] = bias_v;
+                }
+                for (int icb = 0; icb < ic_block; icb++) {
+                    const int lanes = MIN(8, ic - icb * 8);
+                    auto src_c      = src_b + icb * ih * iw * 8;
+                    for (int ky = 0; ky < kh; ky++) {
+                        const int iy = oy * sh - pt + ky * dh;
+                        if (iy < 0 || iy >= ih) {
+                            continue;
+                        }
+                        for (int kx = 0; kx < kw; kx++) {
+                            for (int j = 0; j < tile; j++) {
+                                const int ix = (ox + j) * sw - pl + kx * dw;
+                                src[j]       = (ix >= 0 && ix < iw) ? src_c + (iy * iw + ix) * 8 : zero_pad;
+                            }
+                            auto weight = weight_ocb + ((icb * kernel_size) + ky * kw + kx) * 64;
+                            if (tile == 8) {
+                                ConvNCHWcKernel<8>(acc, src, weight, lanes);
+                            } else {
+                                for (int j = 0; j < tile; j++) {
+                                    ConvNCHWcKernel<1>(acc + j, src + j, weight, lanes);
+                                }
+                            }
+                        }
+                    }
+                }
+                for (int j = 0; j < tile; j++) {
+                    Float8::saveu(dst_row + (ox + j) * 8, ActivationNCHWc(acc[j], act_type));
+                }
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+Status X86ConvLayerNCHWc::ExecDepthwise(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int ih = dims_input[2], iw = dims_input[3];
+    const int oh = dims_output[2], ow = dims_output[3];
+    const int kw = param->kernels[0], kh = param->kernels[1];
+    const int sw = param->strides[0], sh = param->strides[1];
+    const int dw = param->dialations[0], dh = param->dialations[1];
+    const int pl = param->pads[0], pt = param->pads[2];
+    const int c_block  = UP_DIV(dims_output[1], 8);
+    const int act_type = param->activation_type;
+
+    auto input_data   = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data  = handle_ptr<float *>(outputs[0]->GetHandle());
+    auto weights_data = buffer_weight_.force_to<float *>();
+    auto bias_data    = buffer_bias_.force_to<float *>();
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        auto src_b = input_data + b * c_block * ih * iw * 8;
+        auto dst_b = output_data + b * c_block * oh * ow * 8;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int task = 0; task < c_block * oh; task++) {
+            const int cb  = task / oh;
+            const int oy  = task % oh;
+            auto src_c    = src_b + cb * ih * iw * 8;
+            auto dst_row  = dst_b + (cb * oh + oy) * ow * 8;
+            auto weight_c = weights_data + cb * kh * kw * 8;
+            Float8 bias_v = Float8::loadu(bias_data + cb * 8);
+
+            for (int ox = 0; ox < ow; ox++) {
+                Float8 acc = bias_v;
+                for (int ky = 0; ky < kh; ky++) {
+                    const int iy = oy * sh - pt + ky * dh;
+                    if (iy < 0 || iy >= ih) {
+                        continue;
+                    }
+                    for (int kx = 0; kx < kw; kx++) {
+                        const int ix = ox * sw - pl + kx * dw;
+                        if (ix < 0 || ix >= iw) {
+                            continue;
+                        }
+                        Float8::mla(acc, Float8::loadu(src_c + (iy * iw + ix) * 8),
+                                    Float8::loadu(weight_c + (ky * kw + kx) * 8));
+                    }
+                }
+                Float8::saveu(dst_row + ox * 8, ActivationNCHWc(acc, act_type));
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+Status X86ConvLayerNCHWc::ExecGroup(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    const int ic = dims_input[1], ih = dims_input[2], iw = dims_input[3];
+    const int oc = dims_output[1], oh = dims_output[2], ow = dims_output[3];
+    const int kw = param->kernels[0], kh = param->kernels[1];
+    const int sw = param->strides[0], sh = param->strides[1];
+    const int dw = param->dialations[0], dh = param->dialations[1];
+    const int pl = param->pads[0], pt = param->pads[2];
+    const int ic_group = ic / param->group;
+    const int oc_group = oc / param->group;
+    const int act_type = param->activation_type;
+
+    auto input_data   = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data  = handle_ptr<float *>(outputs[0]->GetHandle());
+    auto weights_data = buffer_weight_.force_to<float *>();
+    auto bias_data    = buffer_bias_.force_to<float *>();
+
+    for (int b = 0; b < dims_output[0]; b++) {
+        auto src_b = input_data + b * UP_DIV(ic, 8) * ih * iw * 8;
+        auto dst_b = output_data + b * UP_DIV(oc, 8) * oh * ow * 8;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int task = 0; task < oc * oh; task++) {
+            const int o  = task / oh;
+            const int oy = task % oh;
+            const int g  = o / oc_group;
+            auto dst_row = dst_b + ((o / 8) * oh + oy) * ow * 8 + o % 8;
+
+            for (int ox = 0; ox < ow; ox++) {
+                float sum = bias_data[o];
+                for (int i = 0; i < ic_group; i++) {
+                    const int c   = g * ic_group + i;
+                    auto src_c    = src_b + (c / 8) * ih * iw * 8 + c % 8;
+                    auto weight_c = weights_data + (o * ic_group + i) * kh * kw;
+                    for (int ky = 0; ky < kh; ky++) {
+                        const int iy = oy * sh - pt + ky * dh;
+                        if (iy < 0 || iy >= ih) {
+                            continue;
+                        }
+                        for (int kx = 0; kx < kw; kx++) {
+                            const int ix = ox * sw - pl + kx * dw;
+                            if (ix < 0 || ix >= iw) {
+                                continue;
+                            }
+                            sum += src_c[(iy * iw + ix) * 8] * weight_c[ky * kw + kx];
+                        }
+                    }
+                }
+                dst_row[ox * 8] = ActivationNCHWc(sum, act_type);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+Status X86ConvLayerNCHWc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT ||
+        outputs[0]->GetBlobDesc().data_format != DATA_FORMAT_NC8HW8) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 nchwc conv only support nc8hw8 float");
+    }
+
+    if (param->group == 1) {
+        return ExecGemm(inputs, outputs);
+    } else if (IsDepthwise(param, inputs[0]->GetBlobDesc().dims[1], outputs[0]->GetBlobDesc().dims[1])) {
+        return ExecDepthwise(inputs, outputs);
+    }
+    return ExecGroup(inputs, outputs);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,43 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_acc_factory.h"
+
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_common.h"
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_depthwise.h"
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_stride2.h"
+
+namespace TNN_NS {
+
+/*
+get different impl based on deconv params
+X86DeconvLayerCommon always as the last solution
+*/
+void X86DeconvLayerAccFactory::CreateImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
+                                           LayerParam *param, std::shared_ptr<X86LayerAcc> &deconv_acc_impl) {
+    if (X86DeconvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+        if (!dynamic_cast<X86DeconvLayerDepthwise *>(deconv_acc_impl.get())) {
+            deconv_acc_impl = std::make_shared<X86DeconvLayerDepthwise>();
+        }
+    } else if (X86DeconvLayerStride2::isPrefered(dynamic_cast<ConvLayerParam *>(param), inputs, outputs)) {
+        if (!dynamic_cast<X86DeconvLayerStride2 *>(deconv_acc_impl.get())) {
+            deconv_acc_impl = std::make_shared<X86DeconvLayerStride2>();
+        }
+    } else if (!deconv_acc_impl) {
+        deconv_acc_impl = std::make_shared<X86DeconvLayerCommon>();
+    }
+}
+
+}  // namespace TNN_NS
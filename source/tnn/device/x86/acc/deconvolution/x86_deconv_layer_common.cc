@@ -16,6 +16,7 @@
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 using namespace x86;
@@ -57,23 +58,28 @@ Status X86DeconvLayerCommon::allocateBufferWeight(const std::vector<Blob *> &inp
 
         size_t weight_pack_per_group = ROUND_UP(K, k_c) * ROUND_UP(M, n_block);
 
-        RawBuffer transpose_buffer(conv_res->filter_handle.GetBytesSize() / param->group);
         const float *src = conv_res->filter_handle.force_to<float *>();
 
         if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
-            float *trans = transpose_buffer.force_to<float *>();
-            RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
-            float *dst = temp_buffer.force_to<float *>();
-
-            for (int g = 0; g < param->group; g++) {
-                auto src_g = src + K * M * g;
-                MatTranspose(trans, src_g, K, M);
-                auto dst_g = dst + weight_pack_per_group * g;
-                conv_pack_col_b_n(M, K, trans, K, dst_g, conv_gemm_conf_);
-            }
-
-            temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-            buffer_weight_ = temp_buffer;
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer transpose_buffer(conv_res->filter_handle.GetBytesSize() / param->group);
+                float *trans = transpose_buffer.force_to<float *>();
+                RawBuffer temp_buffer(weight_pack_per_group * param->group * sizeof(float));
+                float *dst = temp_buffer.force_to<float *>();
+
+                for (int g = 0; g < param->group; g++) {
+                    auto src_g = src + K * M * g;
+                    MatTranspose(trans, src_g, K, M);
+                    auto dst_g = dst + weight_pack_per_group * g;
+                    conv_pack_col_b_n(M, K, trans, K, dst_g, conv_gemm_conf_);
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            auto tag = "deconv_gemm_b" + VectorToString(std::vector<int>{param->group, K, M, k_c, n_block});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
@@ -152,7 +158,7 @@ Status X86DeconvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const
         param->kernels[0] * param->kernels[1] * input_dims[2] * input_dims[3] * (output_dims[1] / param->group);
 
     int max_num_threads = OMP_MAX_THREADS_NUM_;
-    conv_ajust_m_blk_size(max_num_threads, conv_in_spatial_dim_, conv_gemm_conf_.M_c_);
+    conv_ajust_m_blk_size(max_num_threads, conv_in_spatial_dim_, conv_gemm_conf_.M_c_, conv_gemm_conf_.m_block_);
 
     int m_c               = conv_gemm_conf_.M_c_;
     int k_c               = conv_gemm_conf_.K_c_;
@@ -0,0 +1,194 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_depthwise.h"
+
+#include <immintrin.h>
+
+#include "tnn/device/x86/x86_context.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_format.h"
+
+namespace TNN_NS {
+
+bool X86DeconvLayerDepthwise::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                         const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+
+    return param->group == dims_input[1] && param->group == dims_output[1];
+}
+
+X86DeconvLayerDepthwise::~X86DeconvLayerDepthwise() {}
+
+Status X86DeconvLayerDepthwise::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                     const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            // the [c][1][1][kh][kw] weight is used as it is, copy it so the resource can be released
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(conv_res->filter_handle.GetBytesSize());
+                memcpy(temp_buffer.force_to<float *>(), conv_res->filter_handle.force_to<float *>(),
+                       conv_res->filter_handle.GetBytesSize());
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, "deconv_depthwise", pack_func, buffer_weight_),
+                          TNN_OK);
+        } else {
+            LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
+            return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+        }
+    }
+    return TNN_OK;
+}
+
+// dst[ox0 + ix] += src[ix] * weight, for every ix landing inside [0, width)
+static void DeconvRowStride1(float *dst, const float *src, int src_width, int width, int ox0, float weight) {
+    int ix_begin = ox0 < 0 ? -ox0 : 0;
+    int ix_end   = std::min(src_width, width - ox0);
+    int ix       = ix_begin;
+    __m128 w     = _mm_set1_ps(weight);
+    for (; ix + 4 <= ix_end; ix += 4) {
+        __m128 acc = _mm_loadu_ps(dst + ox0 + ix);
+        acc        = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + ix), w));
+        _mm_storeu_ps(dst + ox0 + ix, acc);
+    }
+    for (; ix < ix_end; ix++) {
+        dst[ox0 + ix] += src[ix] * weight;
+    }
+}
+
+// dst[ox0 + 2 * ix] += src[ix] * weight0 and dst[ox0 + 2 * ix + 1] += src[ix] * weight1,
+// two neighbouring kernel columns fill the even and odd outputs of one vector
+static void DeconvRowStride2(float *dst, const float *src, int src_width, int width, int ox0, float weight0,
+                             float weight1) {
+    __m128 w0 = _mm_set1_ps(weight0);
+    __m128 w1 = _mm_set1_ps(weight1);
+    int ix    = 0;
+    while (ix < src_width) {
+        int ox = ox0 + 2 * ix;
+        if (ix + 4 <= src_width && ox >= 0 && ox + 8 <= width) {
+            __m128 data = _mm_loadu_ps(src + ix);
+            __m128 even = _mm_mul_ps(data, w0);
+            __m128 odd  = _mm_mul_ps(data, w1);
+            __m128 lo   = _mm_add_ps(_mm_loadu_ps(dst + ox), _mm_unpacklo_ps(even, odd));
+            __m128 hi   = _mm_add_ps(_mm_loadu_ps(dst + ox + 4), _mm_unpackhi_ps(even, odd));
+            _mm_storeu_ps(dst + ox, lo);
+            _mm_storeu_ps(dst + ox + 4, hi);
+            ix += 4;
+            continue;
+        }
+        if (ox >= 0 && ox < width) {
+            dst[ox] += src[ix] * weight0;
+        }
+        if (ox + 1 >= 0 && ox + 1 < width) {
+            dst[ox + 1] += src[ix] * weight1;
+        }
+        ix++;
+    }
+}
+
+static void DeconvRowStrideN(float *dst, const float *src, int src_width, int width, int ox0, int stride,
+                             float weight) {
+    for (int ix = 0; ix < src_width; ix++) {
+        int ox = ox0 + ix * stride;
+        if (ox >= 0 && ox < width) {
+            dst[ox] += src[ix] * weight;
+        }
+    }
+}
+
+Status X86DeconvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 device not support this data type");
+    }
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    auto input_data  = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data = handle_ptr<float *>(outputs[0]->GetHandle());
+    auto weight_data = buffer_weight_.force_to<float *>();
+    auto bias_data   = buffer_bias_.force_to<float *>();
+
+    const int batch    = output_dims[0];
+    const int channel  = output_dims[1];
+    const int ih       = input_dims[2];
+    const int iw       = input_dims[3];
+    const int oh       = output_dims[2];
+    const int ow       = output_dims[3];
+    const int kh       = param->kernels[1];
+    const int kw       = param->kernels[0];
+    const int stride_h = param->strides[1];
+    const int stride_w = param->strides[0];
+    const int dilate_h = param->dialations[1];
+    const int dilate_w = param->dialations[0];
+    const int pad_t    = param->pads[2];
+    const int pad_l    = param->pads[0];
+
+    for (int b = 0; b < batch; b++) {
+        OMP_PARALLEL_FOR_
+        for (int c = 0; c < channel; c++) {
+            const float *src_c    = input_data + (b * channel + c) * ih * iw;
+            const float *weight_c = weight_data + c * kh * kw;
+            float *dst_c          = output_data + (b * channel + c) * oh * ow;
+            memset(dst_c, 0, oh * ow * sizeof(float));
+
+            for (int iy = 0; iy < ih; iy++) {
+                const float *src_row = src_c + iy * iw;
+                for (int ky = 0; ky < kh; ky++) {
+                    int oy = iy * stride_h - pad_t + ky * dilate_h;
+                    if (oy < 0 || oy >= oh) {
+                        continue;
+                    }
+                    float *dst_row          = dst_c + oy * ow;
+                    const float *weight_row = weight_c + ky * kw;
+                    if (stride_w == 2 && dilate_w == 1) {
+                        for (int kx = 0; kx < kw; kx += 2) {
+                            float weight1 = kx + 1 < kw ? weight_row[kx + 1] : 0.f;
+                            DeconvRowStride2(dst_row, src_row, iw, ow, kx - pad_l, weight_row[kx], weight1);
+                        }
+                    } else if (stride_w == 1) {
+                        for (int kx = 0; kx < kw; kx++) {
+                            DeconvRowStride1(dst_row, src_row, iw, ow, kx * dilate_w - pad_l, weight_row[kx]);
+                        }
+                    } else {
+                        for (int kx = 0; kx < kw; kx++) {
+                            DeconvRowStrideN(dst_row, src_row, iw, ow, kx * dilate_w - pad_l, stride_w,
+                                             weight_row[kx]);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (post_func_) {
+            post_func_(output_data + b * channel * oh * ow, bias_data, channel, oh * ow);
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,248 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_stride2.h"
+
+#include "tnn/device/x86/x86_context.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_format.h"
+
+namespace TNN_NS {
+
+/*
+output row oy = 2 * iy - pad + ky takes the kernel rows ky of parity phase = (oy + pad) % 2,
+for oy = 2 * j + c this is a stride 1 correlation over j with the taps
+ky = phase + 2 * (taps - 1 - u), u in [0, taps), reading input row j - sub_pad + u.
+*/
+struct SubPixelPhase {
+    int phase;    // parity of the kernel rows used
+    int taps;     // number of kernel rows of that parity
+    int sub_pad;  // leading pad of the stride 1 sub convolution, may be negative
+    int size;     // number of output rows with this parity
+};
+
+static SubPixelPhase GetSubPixelPhase(int c, int pad, int kernel, int out_size) {
+    SubPixelPhase phase;
+    phase.phase   = ((c + pad) % 2 + 2) % 2;
+    phase.taps    = (kernel - phase.phase + 1) / 2;
+    phase.sub_pad = phase.taps - 1 - (c + pad - phase.phase) / 2;
+    phase.size    = (out_size - c + 1) / 2;
+    return phase;
+}
+
+bool X86DeconvLayerStride2::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                       const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+
+    return param->group == 1 && param->strides[0] == 2 && param->strides[1] == 2 && param->dialations[0] == 1 &&
+           param->dialations[1] == 1 && param->kernels[0] >= 2 && param->kernels[1] >= 2;
+}
+
+X86DeconvLayerStride2::~X86DeconvLayerStride2() {}
+
+Status X86DeconvLayerStride2::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                   const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    const int ic = inputs[0]->GetBlobDesc().dims[1];
+    const int oc = outputs[0]->GetBlobDesc().dims[1];
+    const int kh = param->kernels[1];
+    const int kw = param->kernels[0];
+
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+
+    // the offsets only depend on the kernel phases, the packed data may come from the shared cache
+    size_t total_size = 0;
+    for (int py = 0; py < 2; py++) {
+        for (int px = 0; px < 2; px++) {
+            int K                             = ic * ((kh - py + 1) / 2) * ((kw - px + 1) / 2);
+            phase_weight_offset_[py * 2 + px] = total_size;
+            total_size += ROUND_UP(K, k_c) * ROUND_UP(oc, n_block);
+        }
+    }
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const float *src = conv_res->filter_handle.force_to<float *>();
+
+        if (conv_res->filter_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(total_size * sizeof(float));
+                float *dst = temp_buffer.force_to<float *>();
+
+                for (int py = 0; py < 2; py++) {
+                    for (int px = 0; px < 2; px++) {
+                        int taps_h = (kh - py + 1) / 2;
+                        int taps_w = (kw - px + 1) / 2;
+                        int K      = ic * taps_h * taps_w;
+
+                        // deconv weight [ic][oc][kh][kw] to conv weight [oc][ic][taps_h][taps_w]
+                        std::vector<float> phase_weight(oc * K);
+                        for (int o = 0; o < oc; o++) {
+                            for (int i = 0; i < ic; i++) {
+                                for (int uy = 0; uy < taps_h; uy++) {
+                                    int ky = py + 2 * (taps_h - 1 - uy);
+                                    for (int ux = 0; ux < taps_w; ux++) {
+                                        int kx = px + 2 * (taps_w - 1 - ux);
+                                        phase_weight[o * K + (i * taps_h + uy) * taps_w + ux] =
+                                            src[((i * oc + o) * kh + ky) * kw + kx];
+                                    }
+                                }
+                            }
+                        }
+                        conv_pack_col_b_n(oc, K, phase_weight.data(), K, dst + phase_weight_offset_[py * 2 + px],
+                                          conv_gemm_conf_);
+                    }
+                }
+
+                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            auto tag = "deconv_stride2_b" + VectorToString(std::vector<int>{ic, oc, kh, kw, k_c, n_block});
+            RETURN_ON_NEQ(GetSharedPackedWeight(conv_res->filter_handle, tag, pack_func, buffer_weight_), TNN_OK);
+        } else {
+            LOGE("Error: DataType %d not support\n", conv_res->filter_handle.GetDataType());
+            return Status(TNNERR_MODEL_ERR, "conv_res DataType is not supported");
+        }
+    }
+    return TNN_OK;
+}
+
+// col[(ci * taps_h + uy) * taps_w + ux][j * out_w + i] = src[ci][j - pad_h + uy][i - pad_w + ux]
+static void SubPixelIm2Col(const float *src, int channel, int height, int width, const SubPixelPhase &phase_h,
+                           const SubPixelPhase &phase_w, float *col) {
+    const int out_h = phase_h.size;
+    const int out_w = phase_w.size;
+    const int N     = out_h * out_w;
+
+    OMP_PARALLEL_FOR_
+    for (int ci = 0; ci < channel; ci++) {
+        const float *src_c = src + ci * height * width;
+        for (int uy = 0; uy < phase_h.taps; uy++) {
+            for (int ux = 0; ux < phase_w.taps; ux++) {
+                float *col_k = col + ((ci * phase_h.taps + uy) * phase_w.taps + ux) * N;
+                int offset_x = ux - phase_w.sub_pad;
+                int i_begin  = std::min(out_w, std::max(0, -offset_x));
+                int i_end    = std::max(i_begin, std::min(out_w, width - offset_x));
+                for (int j = 0; j < out_h; j++) {
+                    float *col_row = col_k + j * out_w;
+                    int y          = j - phase_h.sub_pad + uy;
+                    if (y < 0 || y >= height) {
+                        memset(col_row, 0, out_w * sizeof(float));
+                        continue;
+                    }
+                    memset(col_row, 0, i_begin * sizeof(float));
+                    memcpy(col_row + i_begin, src_c + y * width + i_begin + offset_x, (i_end - i_begin) * sizeof(float));
+                    memset(col_row + i_end, 0, (out_w - i_end) * sizeof(float));
+                }
+            }
+        }
+    }
+}
+
+Status X86DeconvLayerStride2::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConvLayerParam *>(param_);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 device not support this data type");
+    }
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    auto input_data  = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    const int ic = input_dims[1];
+    const int ih = input_dims[2];
+    const int iw = input_dims[3];
+    const int oc = output_dims[1];
+    const int oh = output_dims[2];
+    const int ow = output_dims[3];
+
+    SubPixelPhase phases_h[2], phases_w[2];
+    size_t col_size = 0, dst_size = 0;
+    for (int c = 0; c < 2; c++) {
+        phases_h[c] = GetSubPixelPhase(c, param->pads[2], param->kernels[1], oh);
+        phases_w[c] = GetSubPixelPhase(c, param->pads[0], param->kernels[0], ow);
+    }
+    for (int cy = 0; cy < 2; cy++) {
+        for (int cx = 0; cx < 2; cx++) {
+            size_t N = phases_h[cy].size * phases_w[cx].size;
+            col_size = std::max(col_size, ic * phases_h[cy].taps * phases_w[cx].taps * N);
+            dst_size = std::max(dst_size, oc * N);
+        }
+    }
+
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    conv_ajust_m_blk_size(max_num_threads, phases_h[0].size * phases_w[0].size, conv_gemm_conf_.M_c_,
+                          conv_gemm_conf_.m_block_);
+    size_t src_trans_size = conv_gemm_conf_.M_c_ * conv_gemm_conf_.K_c_;
+
+    size_t col_bytes      = ROUND_UP(col_size * sizeof(float), 32);
+    size_t dst_bytes      = ROUND_UP(dst_size * sizeof(float), 32);
+    size_t workspace_size = col_bytes + dst_bytes + ROUND_UP(src_trans_size * max_num_threads * sizeof(float), 32);
+    float *workspace      = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
+
+    float *col_workspace       = workspace;
+    float *dst_workspace       = workspace + col_bytes / sizeof(float);
+    float *src_trans_workspace = dst_workspace + dst_bytes / sizeof(float);
+
+    auto weight_data = buffer_weight_.force_to<float *>();
+    auto bias_data   = buffer_bias_.force_to<float *>();
+
+    for (int b = 0; b < output_dims[0]; b++) {
+        const float *src = input_data + b * ic * ih * iw;
+        float *dst       = output_data + b * oc * oh * ow;
+        for (int cy = 0; cy < 2; cy++) {
+            for (int cx = 0; cx < 2; cx++) {
+                const auto &phase_h = phases_h[cy];
+                const auto &phase_w = phases_w[cx];
+                int N               = phase_h.size * phase_w.size;
+                int K               = ic * phase_h.taps * phase_w.taps;
+                if (N == 0) {
+                    continue;
+                }
+
+                SubPixelIm2Col(src, ic, ih, iw, phase_h, phase_w, col_workspace);
+                const float *weight = weight_data + phase_weight_offset_[phase_h.phase * 2 + phase_w.phase];
+                conv_sgemm_nn_col_major_prepack_b(N, oc, K, col_workspace, N, weight, K, dst_workspace, N, bias_data,
+                                                  param->activation_type, src_trans_workspace, conv_gemm_conf_);
+
+                // interleave the sub-pixel outputs back into the full resolution output
+                OMP_PARALLEL_FOR_
+                for (int o = 0; o < oc; o++) {
+                    const float *sub = dst_workspace + o * N;
+                    float *dst_o     = dst + o * oh * ow;
+                    for (int j = 0; j < phase_h.size; j++) {
+                        float *dst_row       = dst_o + (2 * j + cy) * ow + cx;
+                        const float *sub_row = sub + j * phase_w.size;
+                        for (int i = 0; i < phase_w.size; i++) {
+                            dst_row[2 * i] = sub_row[i];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
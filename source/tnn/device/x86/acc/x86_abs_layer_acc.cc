@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_ABS, avx2, unary2_kernel_avx<X86_ABS_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_ABS, sse42, unary2_kernel_sse<X86_ABS_OP>);
 DECLARE_X86_UNARY2_ACC(Abs, LAYER_ABS);
 REGISTER_X86_ACC(Abs, LAYER_ABS);
+REGISTER_X86_LAYOUT(LAYER_ABS, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
@@ -76,6 +76,10 @@ Status X86AddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
         if (inputs.size() > 2) {
             return Status(TNNERR_UNSUPPORT_NET, "INPUT > 2 NOT IMPLEMENT FOR INT8");
         }
+        if (!DimsVectorUtils::Equal(inputs[0]->GetBlobDesc().dims, dims) ||
+            !DimsVectorUtils::Equal(inputs[1]->GetBlobDesc().dims, dims)) {
+            return Status(TNNERR_UNSUPPORT_NET, "BROADCAST NOT IMPLEMENT FOR INT8");
+        }
         auto output_ptr   = handle_ptr<int8_t *>(outputs[0]->GetHandle());
         auto input0_ptr   = handle_ptr<int8_t *>(inputs[0]->GetHandle());
         auto input1_ptr   = handle_ptr<int8_t *>(inputs[1]->GetHandle());
@@ -92,5 +96,6 @@ Status X86AddLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::v
 }
 
 REGISTER_X86_ACC(Add, LAYER_ADD);
+REGISTER_X86_LAYOUT(LAYER_ADD, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
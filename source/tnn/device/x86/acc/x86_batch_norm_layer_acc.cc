@@ -23,6 +23,11 @@ namespace TNN_NS {
 
 X86BatchNormLayerAcc::~X86BatchNormLayerAcc() {}
 
+std::vector<DataFormat> X86BatchNormLayerAcc::SupportDataFormat(DataType data_type, int dims_size,
+                                                                 BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
 Status X86BatchNormLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto res = dynamic_cast<BatchNormLayerResource *>(resource);
@@ -62,6 +67,10 @@ Status X86BatchNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
     RawBuffer bias_handle  = resource->bias_handle;
     bool has_bias          = bias_handle.GetDataCount() > 0; 
 
+    if (output_blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        x86_fma_func = X86_FMA_NC8HW8;
+    }
+
     x86_fma_func(handle_ptr<float *>(input_blob->GetHandle()),
             handle_ptr<float *>(output_blob->GetHandle()),
             scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
@@ -71,5 +80,6 @@ Status X86BatchNormLayerAcc::DoForward(const std::vector<Blob *> &inputs, const
 }
 
 REGISTER_X86_ACC(BatchNorm, LAYER_BATCH_NORM);
+REGISTER_X86_LAYOUT(LAYER_BATCH_NORM, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
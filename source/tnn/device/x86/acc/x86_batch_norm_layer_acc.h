@@ -28,6 +28,8 @@ public:
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
 protected:
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) override;
+
     std::shared_ptr<LayerResource> bn_acc_f32_resource_ = nullptr;
 };
 
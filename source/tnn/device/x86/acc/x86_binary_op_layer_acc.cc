@@ -13,11 +13,15 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/x86_binary_op_layer_acc.h"
+
+#include <algorithm>
+
 #include "tnn/device/x86/x86_common.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
 #include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/Float8.h"
 
@@ -45,6 +49,9 @@ template<> float binary_op<X86BinaryOpType::kMAX>(const float &a, const float &b
 template<> float binary_op<X86BinaryOpType::kMIN>(const float &a, const float &b) {
     return a < b ? a : b;
 }
+template<> float binary_op<X86BinaryOpType::kSQUARED_DIFFERENCE>(const float &a, const float &b) {
+    return (a - b) * (a - b);
+}
 
 template<X86BinaryOpType type, typename VEC>
 VEC binary_op(const VEC &a, const VEC &b) {
@@ -68,6 +75,10 @@ template<> Float4 binary_op<X86BinaryOpType::kMAX, Float4>(const Float4 &a, cons
 template<> Float4 binary_op<X86BinaryOpType::kMIN, Float4>(const Float4 &a, const Float4 &b) {
     return Float4::min(a, b);
 }
+template<> Float4 binary_op<X86BinaryOpType::kSQUARED_DIFFERENCE, Float4>(const Float4 &a, const Float4 &b) {
+    Float4 diff = Float4::sub(a, b);
+    return Float4::mul(diff, diff);
+}
 template<> Float8 binary_op<X86BinaryOpType::kADD, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::add(a, b);
 }
@@ -86,6 +97,10 @@ template<> Float8 binary_op<X86BinaryOpType::kMAX, Float8>(const Float8 &a, cons
 template<> Float8 binary_op<X86BinaryOpType::kMIN, Float8>(const Float8 &a, const Float8 &b) {
     return Float8::min(a, b);
 }
+template<> Float8 binary_op<X86BinaryOpType::kSQUARED_DIFFERENCE, Float8>(const Float8 &a, const Float8 &b) {
+    Float8 diff = Float8::sub(a, b);
+    return Float8::mul(diff, diff);
+}
 
 static inline void PadShape(const int pad_size, const int dim_size, DimsVector &pad_shape, DimsVector in_shape) {
     int j = 0;
@@ -619,6 +634,9 @@ Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResou
             case X86BinaryOpType::kMIN :
                 binary_func_ = BinaryFunc<X86BinaryOpType::kMIN, Float8, 8>;
                 break;
+            case X86BinaryOpType::kSQUARED_DIFFERENCE :
+                binary_func_ = BinaryFunc<X86BinaryOpType::kSQUARED_DIFFERENCE, Float8, 8>;
+                break;
 
             default :
                 LOGE("Error, unknown binary op_type\n");
@@ -644,6 +662,9 @@ Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResou
             case X86BinaryOpType::kMIN :
                 binary_func_ = BinaryFunc<X86BinaryOpType::kMIN, Float4, 4>;
                 break;
+            case X86BinaryOpType::kSQUARED_DIFFERENCE :
+                binary_func_ = BinaryFunc<X86BinaryOpType::kSQUARED_DIFFERENCE, Float4, 4>;
+                break;
 
             default :
                 LOGE("Error, unknown binary op_type\n");
@@ -669,6 +690,9 @@ Status X86BinaryOpLayerAcc::Init(Context *context, LayerParam *param, LayerResou
         case X86BinaryOpType::kMIN :
             binary_general_func_ = BinaryGeneral<X86BinaryOpType::kMIN>;
             break;
+        case X86BinaryOpType::kSQUARED_DIFFERENCE :
+            binary_general_func_ = BinaryGeneral<X86BinaryOpType::kSQUARED_DIFFERENCE>;
+            break;
 
         default :
             LOGE("Error, unknown binary op_type\n");
@@ -728,6 +752,186 @@ Status X86BinaryOpLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std
     return TNN_OK;
 }
 
+std::vector<DataFormat> X86BinaryOpLayerAcc::SupportDataFormat(DataType data_type, int dims_size,
+                                                               BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
+Status X86BinaryOpLayerAcc::Compute(std::vector<float *> &input_ptrs, float *output_ptr, DimsVector dims) {
+    if (btype_ == BroadcastTypeUnknown) {
+        LOGE("Error: unknown broadcast type\n");
+        return Status(TNNERR_LAYER_ERR, "Error: Binary layer unknown broadcast type");
+    } else if (btype_ == BroadcastTypeGeneral) {
+        binary_general_func_(dims, input_shapes_, output_ptr, input_ptrs);
+    } else {
+        auto input0_ptr = reinterpret_cast<float *>(input_ptrs[0]);
+        auto input1_ptr = reinterpret_cast<float *>(input_ptrs[1]);
+
+        // input0_shape != output_shape && input1_shape != output_shape -> general impl
+        if (!DimsVectorUtils::Equal(dims, input_shapes_[0]) &&
+            !DimsVectorUtils::Equal(dims, input_shapes_[1])) {
+            std::vector<DimsVector> shapes_tmp = {input_shapes_[0], input_shapes_[1]};
+            std::vector<float *> ptrs_tmp = {input0_ptr, input1_ptr};
+
+            binary_general_func_(dims, shapes_tmp, output_ptr, ptrs_tmp);
+        } else {
+            DimsVector input0_pad_shape, input1_pad_shape;
+            input0_pad_shape.resize(dims.size());
+            input1_pad_shape.resize(dims.size());
+            PadShape(dims.size() - input_shapes_[0].size(), dims.size(), input0_pad_shape, input_shapes_[0]);
+            PadShape(dims.size() - input_shapes_[1].size(), dims.size(), input1_pad_shape, input_shapes_[1]);
+
+            binary_func_(output_ptr, input0_ptr, input1_ptr, input0_pad_shape, input1_pad_shape, dims);
+        }
+
+        for (int i = 2; i < input_ptrs.size(); i++) {
+            DimsVector input0_pad_shape;
+            auto input_ptr = reinterpret_cast<float *>(input_ptrs[i]);
+            PadShape(dims.size() - input_shapes_[i].size(), dims.size(), input0_pad_shape, input_shapes_[i]);
+            binary_func_(output_ptr, output_ptr, input_ptr, dims, input0_pad_shape, dims);
+        }
+    }
+
+    return TNN_OK;
+}
+
+namespace {
+// operand of a binary op on the blocked nc8hw8 layout
+struct BlockedOperand {
+    enum { FULL = 0, CHANNEL = 1, SINGLE = 2 } kind;
+    const float *ptr;
+    int batch_stride;
+    // per channel operand, one Float8 for each channel block
+    std::vector<float> channel_data;
+};
+}  // namespace
+
+template <X86BinaryOpType op_type>
+static void BinaryNC8HW8(float *output_ptr, const std::vector<BlockedOperand> &operands, int batch, int channel_block,
+                         int hw) {
+    auto load = [&](const BlockedOperand &operand, int b, int cb, int i) {
+        if (operand.kind == BlockedOperand::FULL) {
+            return Float8::loadu(operand.ptr + b * operand.batch_stride + (cb * hw + i) * 8);
+        } else if (operand.kind == BlockedOperand::CHANNEL) {
+            return Float8::loadu(operand.channel_data.data() + cb * 8);
+        }
+        return Float8(operand.ptr[0]);
+    };
+
+    for (int b = 0; b < batch; b++) {
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int cb = 0; cb < channel_block; cb++) {
+            auto dst = output_ptr + (b * channel_block + cb) * hw * 8;
+            for (int i = 0; i < hw; i++) {
+                Float8 acc = load(operands[0], b, cb, i);
+                for (int k = 1; k < operands.size(); k++) {
+                    acc = binary_op<op_type, Float8>(acc, load(operands[k], b, cb, i));
+                }
+                Float8::saveu(dst + i * 8, acc);
+            }
+        }
+    }
+}
+
+Status X86BinaryOpLayerAcc::DoForwardNC8HW8(std::vector<float *> &input_ptrs, const std::vector<Blob *> &operand_blobs,
+                                            Blob *output) {
+    auto dims                = output->GetBlobDesc().dims;
+    auto output_ptr          = handle_ptr<float *>(output->GetHandle());
+    const int batch          = dims[0];
+    const int channel        = dims[1];
+    const int channel_block  = UP_DIV(channel, 8);
+    const int hw             = DimsVectorUtils::Count(dims, 2);
+
+    // operands matching the output, broadcast per channel or a single value run on the blocked data directly
+    bool blocked = true;
+    std::vector<BlockedOperand> operands(input_ptrs.size());
+    for (int i = 0; i < input_ptrs.size() && blocked; i++) {
+        DimsVector shape(dims.size());
+        PadShape(dims.size() - input_shapes_[i].size(), dims.size(), shape, input_shapes_[i]);
+        auto blob             = operand_blobs[i];
+        auto &operand         = operands[i];
+        operand.ptr           = input_ptrs[i];
+        operand.batch_stride  = 0;
+        if (DimsVectorUtils::Count(shape) == 1) {
+            operand.kind = BlockedOperand::SINGLE;
+        } else if (blob && blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8 &&
+                   DimsVectorUtils::Equal(shape, dims, 1) && (shape[0] == batch || shape[0] == 1)) {
+            operand.kind         = BlockedOperand::FULL;
+            operand.batch_stride = shape[0] == 1 ? 0 : channel_block * hw * 8;
+        } else if (shape[0] == 1 && shape[1] == channel && DimsVectorUtils::Count(shape, 2) == 1) {
+            // [1, c, 1, 1] is stored the same way in nchw and nc8hw8
+            operand.kind = BlockedOperand::CHANNEL;
+            operand.channel_data.assign(channel_block * 8, 0.f);
+            memcpy(operand.channel_data.data(), operand.ptr, channel * sizeof(float));
+        } else {
+            blocked = false;
+        }
+    }
+
+    if (blocked) {
+        switch (op_type_) {
+            case X86BinaryOpType::kADD:
+                BinaryNC8HW8<X86BinaryOpType::kADD>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kSUB:
+                BinaryNC8HW8<X86BinaryOpType::kSUB>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kMUL:
+                BinaryNC8HW8<X86BinaryOpType::kMUL>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kDIV:
+                BinaryNC8HW8<X86BinaryOpType::kDIV>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kMAX:
+                BinaryNC8HW8<X86BinaryOpType::kMAX>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kMIN:
+                BinaryNC8HW8<X86BinaryOpType::kMIN>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            case X86BinaryOpType::kSQUARED_DIFFERENCE:
+                BinaryNC8HW8<X86BinaryOpType::kSQUARED_DIFFERENCE>(output_ptr, operands, batch, channel_block, hw);
+                break;
+            default:
+                LOGE("Error, unknown binary op_type\n");
+                return TNNERR_LAYER_ERR;
+        }
+        return TNN_OK;
+    }
+
+    // other broadcasts go through nchw copies of the blocked blobs
+    size_t workspace_count = DimsVectorUtils::Count(dims);
+    for (auto blob : operand_blobs) {
+        if (blob && blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+            workspace_count += DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+        }
+    }
+    float *workspace  = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_count * sizeof(float)));
+    float *output_tmp = workspace;
+    workspace += DimsVectorUtils::Count(dims);
+
+    std::vector<float *> nchw_ptrs = input_ptrs;
+    for (int i = 0; i < operand_blobs.size(); i++) {
+        auto blob = operand_blobs[i];
+        if (!blob || blob->GetBlobDesc().data_format != DATA_FORMAT_NC8HW8) {
+            continue;
+        }
+        // the same blob may show up twice, unpack it only once
+        auto first = std::find(operand_blobs.begin(), operand_blobs.end(), blob) - operand_blobs.begin();
+        if (first < i) {
+            nchw_ptrs[i] = nchw_ptrs[first];
+            continue;
+        }
+        auto blob_dims = blob->GetBlobDesc().dims;
+        UnpackNC8HW8(workspace, input_ptrs[i], blob_dims[0], blob_dims[1], DimsVectorUtils::Count(blob_dims, 2));
+        nchw_ptrs[i] = workspace;
+        workspace += DimsVectorUtils::Count(blob_dims);
+    }
+
+    RETURN_ON_NEQ(Compute(nchw_ptrs, output_tmp, dims), TNN_OK);
+    PackNC8HW8(output_ptr, output_tmp, batch, channel, hw);
+    return TNN_OK;
+}
+
 Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<MultidirBroadcastLayerParam *>(param_);
     if (!layer_param) {
@@ -737,6 +941,7 @@ Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     auto layer_res = dynamic_cast<EltwiseLayerResource *>(resource_);
 
     std::vector<float *> input_ptrs;
+    std::vector<Blob *> operand_blobs;
     input_ptrs.reserve(4);
     auto output = outputs[0];
     auto dims   = output->GetBlobDesc().dims;
@@ -749,59 +954,31 @@ Status X86BinaryOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
             input_ptrs.push_back(layer_res->element_handle.force_to<float *>());
 
             input_ptrs.push_back(handle_ptr<float *>(inputs[0]->GetHandle()));
+            operand_blobs = {nullptr, inputs[0]};
         } else {
             input_ptrs.push_back(handle_ptr<float *>(inputs[0]->GetHandle()));
 
             input_ptrs.push_back(layer_res->element_handle.force_to<float *>());
+            operand_blobs = {inputs[0], nullptr};
         }
     } else {
         if (inputs.size() == 1) {
             input_ptrs.push_back(handle_ptr<float *>(inputs[0]->GetHandle()));
             input_ptrs.push_back(handle_ptr<float *>(inputs[0]->GetHandle()));
+            operand_blobs = {inputs[0], inputs[0]};
         } else {
             for (size_t inid = 0; inid < inputs.size(); inid++) {
                 input_ptrs.push_back(handle_ptr<float *>(inputs[inid]->GetHandle()));
             }
+            operand_blobs = inputs;
         }
     }
 
-    if (btype_ == BroadcastTypeUnknown) {
-        LOGE("Error: unknown broadcast type\n");
-        return Status(TNNERR_LAYER_ERR, "Error: Binary layer unknown broadcast type");
-    } else if (btype_ == BroadcastTypeGeneral) {
-        auto output_ptr = handle_ptr<float *>(output->GetHandle());
-        binary_general_func_(dims, input_shapes_, output_ptr, input_ptrs);
-    } else {
-        auto output_ptr = handle_ptr<float *>(output->GetHandle());
-        auto input0_ptr = reinterpret_cast<float *>(input_ptrs[0]);
-        auto input1_ptr = reinterpret_cast<float *>(input_ptrs[1]);
-
-        // input0_shape != output_shape && input1_shape != output_shape -> general impl
-        if (!DimsVectorUtils::Equal(dims, input_shapes_[0]) &&
-            !DimsVectorUtils::Equal(dims, input_shapes_[1])) {
-            std::vector<DimsVector> shapes_tmp = {input_shapes_[0], input_shapes_[1]};
-            std::vector<float *> ptrs_tmp = {input0_ptr, input1_ptr};
-
-            binary_general_func_(dims, shapes_tmp, output_ptr, ptrs_tmp);
-        } else {
-            DimsVector input0_pad_shape, input1_pad_shape;
-            input0_pad_shape.resize(dims.size());
-            input1_pad_shape.resize(dims.size());
-            PadShape(dims.size() - input_shapes_[0].size(), dims.size(), input0_pad_shape, input_shapes_[0]);
-            PadShape(dims.size() - input_shapes_[1].size(), dims.size(), input1_pad_shape, input_shapes_[1]);
-
-            binary_func_(output_ptr, input0_ptr, input1_ptr, input0_pad_shape, input1_pad_shape, output->GetBlobDesc().dims);
-        }
-
-        for (int i = 2; i < input_ptrs.size(); i++) {
-            DimsVector input0_pad_shape;
-            auto input_ptr = reinterpret_cast<float *>(input_ptrs[i]);
-            PadShape(dims.size() - input_shapes_[i].size(), dims.size(), input0_pad_shape, input_shapes_[i]);
-            binary_func_(output_ptr, output_ptr, input_ptr, dims, input0_pad_shape, output->GetBlobDesc().dims);
-        }
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        return DoForwardNC8HW8(input_ptrs, operand_blobs, output);
     }
 
-    return TNN_OK;
+    return Compute(input_ptrs, handle_ptr<float *>(output->GetHandle()), dims);
 }
 
 }  // namespace TNN_NS
@@ -31,6 +31,7 @@ enum class X86BinaryOpType : int {
     kDIV = 3,
     kMAX = 4,
     kMIN = 5,
+    kSQUARED_DIFFERENCE = 6,
 };
 
 template <X86BinaryOpType op_type, typename VEC, int pack>
@@ -56,8 +57,17 @@ protected:
     // Calculate Function
     Status Calculate(const std::vector<Blob *> &input_blobs, const std::vector<void *> &input_ptrs,
                      const std::vector<DimsVector> &input_shapes, Blob *output);
+
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) override;
+
     X86BinaryOpType op_type_;
 private:
+    // run the binary op on nchw data, input_ptrs follow the order of input_shapes_
+    Status Compute(std::vector<float *> &input_ptrs, float *output_ptr, DimsVector dims);
+
+    // run the binary op on the blocked nc8hw8 output, operand_blobs is nullptr for the layer resource
+    Status DoForwardNC8HW8(std::vector<float *> &input_ptrs, const std::vector<Blob *> &operand_blobs, Blob *output);
+
     std::vector<DimsVector> input_shapes_;
     BroadcastType btype_;
 
@@ -16,11 +16,80 @@
 #include "tnn/device/x86/x86_device.h"
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/omp_utils.h"
 #include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Concat, LAYER_CONCAT);
+DECLARE_X86_ACC_WITH_FUNC(Concat, LAYER_CONCAT,
+                          virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size,
+                                                                            BlobType blob_type) override;);
+
+std::vector<DataFormat> X86ConcatLayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
+/*
+concat on the blocked nc8hw8 layout, blobs are seen as [n][c/8][h][w][8].
+channels are copied lane by lane unless every input has full channel blocks.
+*/
+static Status X86ConcatNC8HW8(Blob *output, const std::vector<Blob *> &inputs, int axis) {
+    auto output_dims = output->GetBlobDesc().dims;
+    auto output_data = handle_ptr<float *>(output->GetHandle());
+    const int batch  = output_dims[0];
+    const int hw     = DimsVectorUtils::Count(output_dims, 2);
+
+    bool full_block = true;
+    for (auto input : inputs) {
+        full_block &= input->GetBlobDesc().dims[1] % 8 == 0;
+    }
+
+    if (axis == 1 && !full_block) {
+        const int oc_r8 = ROUND_UP(output_dims[1], 8);
+        int channel_offset = 0;
+        for (auto input : inputs) {
+            auto input_data = handle_ptr<float *>(input->GetHandle());
+            const int ic    = input->GetBlobDesc().dims[1];
+            const int ic_r8 = ROUND_UP(ic, 8);
+            for (int b = 0; b < batch; b++) {
+                OMP_PARALLEL_FOR_GUIDED_
+                for (int c = 0; c < ic; c++) {
+                    const int oc = c + channel_offset;
+                    auto src = input_data + (b * ic_r8 + c / 8 * 8) * hw + c % 8;
+                    auto dst = output_data + (b * oc_r8 + oc / 8 * 8) * hw + oc % 8;
+                    for (int i = 0; i < hw; i++) {
+                        dst[i * 8] = src[i * 8];
+                    }
+                }
+            }
+            channel_offset += ic;
+        }
+        return TNN_OK;
+    }
+
+    // blocked dims, the concat axis never splits a channel block
+    auto blocked_dims = [](DimsVector dims) {
+        dims[1] = UP_DIV(dims[1], 8);
+        dims.push_back(8);
+        return dims;
+    };
+    auto output_blocked = blocked_dims(output_dims);
+    int num_concats     = DimsVectorUtils::Count(output_blocked, 0, axis);
+    int concate_size    = DimsVectorUtils::Count(output_blocked, axis + 1);
+
+    int output_concat_axis_offset = 0;
+    for (auto input : inputs) {
+        auto input_data             = handle_ptr<float *>(input->GetHandle());
+        const int input_concat_axis = blocked_dims(input->GetBlobDesc().dims)[axis];
+        for (int n = 0; n < num_concats; ++n) {
+            memcpy(output_data + (n * output_blocked[axis] + output_concat_axis_offset) * concate_size,
+                   input_data + n * input_concat_axis * concate_size,
+                   input_concat_axis * concate_size * sizeof(float));
+        }
+        output_concat_axis_offset += input_concat_axis;
+    }
+    return TNN_OK;
+}
 
 Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<ConcatLayerParam *>(param_);
@@ -55,6 +124,10 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
         return Status(TNNERR_PARAM_ERR, "Concat layer param invalid");
     }
 
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        return X86ConcatNC8HW8(output, inputs, axis);
+    }
+
     int num_concats = 1;
     for (int i = 0; i < axis; i++) {
         num_concats *= dims[i];
@@ -84,5 +157,6 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
 }
 
 REGISTER_X86_ACC(Concat, LAYER_CONCAT);
+REGISTER_X86_LAYOUT(LAYER_CONCAT, DATA_FORMAT_NC8HW8);
 
 }
\ No newline at end of file
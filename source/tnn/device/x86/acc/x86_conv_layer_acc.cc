@@ -70,6 +70,11 @@ Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+std::vector<DataFormat> X86ConvLayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
 REGISTER_X86_ACC(Conv, LAYER_CONVOLUTION);
+REGISTER_X86_LAYOUT(LAYER_CONVOLUTION, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
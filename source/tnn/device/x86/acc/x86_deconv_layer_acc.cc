@@ -13,7 +13,7 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/x86_deconv_layer_acc.h"
-#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_common.h"
+#include "tnn/device/x86/acc/deconvolution/x86_deconv_layer_acc_factory.h"
 #include "tnn/interpreter/layer_resource_generator.h"
 
 namespace TNN_NS {
@@ -38,9 +38,7 @@ Status X86DeconvLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
         return ret;
     }
 
-    if (!conv_acc_impl_) {
-        conv_acc_impl_ = std::make_shared<X86DeconvLayerCommon>();
-    }
+    X86DeconvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
 
     if (!conv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
@@ -0,0 +1,300 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+// elements of the output run through all steps while they stay in L1
+static const int kFusedTileSize = 512;
+
+template <typename VEC, int pack, typename VOP, typename SOP>
+static void UnaryTile(float *value, int count, VOP vop, SOP sop) {
+    int i = 0;
+    for (; i + pack - 1 < count; i += pack) {
+        VEC::saveu(value + i, vop(VEC::loadu(value + i)));
+    }
+    for (; i < count; ++i) {
+        value[i] = sop(value[i]);
+    }
+}
+
+// operand is a single value broadcast over the tile if operand_broadcast
+template <typename VEC, int pack, typename VOP, typename SOP>
+static void BinaryTile(float *value, const float *operand, bool operand_broadcast, bool operand_first, int count,
+                       VOP vop, SOP sop) {
+    int i = 0;
+    if (operand_broadcast) {
+        const float y = operand[0];
+        const VEC y_v(y);
+        if (operand_first) {
+            for (; i + pack - 1 < count; i += pack) {
+                VEC::saveu(value + i, vop(y_v, VEC::loadu(value + i)));
+            }
+            for (; i < count; ++i) {
+                value[i] = sop(y, value[i]);
+            }
+        } else {
+            for (; i + pack - 1 < count; i += pack) {
+                VEC::saveu(value + i, vop(VEC::loadu(value + i), y_v));
+            }
+            for (; i < count; ++i) {
+                value[i] = sop(value[i], y);
+            }
+        }
+    } else {
+        if (operand_first) {
+            for (; i + pack - 1 < count; i += pack) {
+                VEC::saveu(value + i, vop(VEC::loadu(operand + i), VEC::loadu(value + i)));
+            }
+            for (; i < count; ++i) {
+                value[i] = sop(operand[i], value[i]);
+            }
+        } else {
+            for (; i + pack - 1 < count; i += pack) {
+                VEC::saveu(value + i, vop(VEC::loadu(value + i), VEC::loadu(operand + i)));
+            }
+            for (; i < count; ++i) {
+                value[i] = sop(value[i], operand[i]);
+            }
+        }
+    }
+}
+
+// run one step of the program over a tile of the running value
+template <typename VEC, int pack>
+static void FusedStepTile(const FusedElementwiseStep &step, float *value, const float *operand,
+                          bool operand_broadcast, int count) {
+    const bool first = step.operand_first;
+    switch (step.type) {
+        case LAYER_ADD:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::add(x, y); }, [](float x, float y) { return x + y; });
+            break;
+        case LAYER_SUB:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::sub(x, y); }, [](float x, float y) { return x - y; });
+            break;
+        case LAYER_MUL:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::mul(x, y); }, [](float x, float y) { return x * y; });
+            break;
+        case LAYER_DIV:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::div(x, y); }, [](float x, float y) { return x / y; });
+            break;
+        case LAYER_MAXIMUM:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::max(x, y); },
+                [](float x, float y) { return std::max(x, y); });
+            break;
+        case LAYER_MINIMUM:
+            BinaryTile<VEC, pack>(
+                value, operand, operand_broadcast, first, count,
+                [](const VEC &x, const VEC &y) { return VEC::min(x, y); },
+                [](float x, float y) { return std::min(x, y); });
+            break;
+        case LAYER_RELU:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::max(x, VEC(0.0f)); },
+                [](float x) { return std::max(x, 0.0f); });
+            break;
+        case LAYER_RELU6:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::min(VEC::max(x, VEC(0.0f)), VEC(6.0f)); },
+                [](float x) { return std::min(std::max(x, 0.0f), 6.0f); });
+            break;
+        case LAYER_CLIP: {
+            const float min = step.alpha, max = step.beta;
+            UnaryTile<VEC, pack>(
+                value, count, [min, max](const VEC &x) { return VEC::min(VEC::max(x, VEC(min)), VEC(max)); },
+                [min, max](float x) { return std::min(std::max(x, min), max); });
+            break;
+        }
+        case LAYER_HARDSIGMOID: {
+            const float alpha = step.alpha, beta = step.beta;
+            UnaryTile<VEC, pack>(
+                value, count,
+                [alpha, beta](const VEC &x) {
+                    return VEC::min(VEC::max(VEC::add(VEC::mul(x, VEC(alpha)), VEC(beta)), VEC(0.0f)), VEC(1.0f));
+                },
+                [alpha, beta](float x) { return std::min(std::max(alpha * x + beta, 0.0f), 1.0f); });
+            break;
+        }
+        case LAYER_SIGMOID:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::sigmoid(x); },
+                [](float x) { return 1.0f / (1.0f + std::exp(-x)); });
+            break;
+        case LAYER_SWISH:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::mul(x, VEC::sigmoid(x)); },
+                [](float x) { return x / (1.0f + std::exp(-x)); });
+            break;
+        case LAYER_TANH:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::tanh(x); }, [](float x) { return std::tanh(x); });
+            break;
+        case LAYER_ABS:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::abs(x); }, [](float x) { return std::fabs(x); });
+            break;
+        case LAYER_NEG:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::neg(x); }, [](float x) { return -x; });
+            break;
+        case LAYER_EXP:
+            UnaryTile<VEC, pack>(
+                value, count, [](const VEC &x) { return VEC::exp(x); }, [](float x) { return std::exp(x); });
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename VEC, int pack>
+static void FusedElementwiseKernel(const std::vector<FusedElementwiseStep> &steps,
+                                   const std::vector<const float *> &input_data,
+                                   const std::vector<DimsVector> &outer_strides, const std::vector<bool> &broadcast,
+                                   const DimsVector &outer_dims, int inner, float *output) {
+    const int outer = DimsVectorUtils::Count(outer_dims);
+    const int tiles = UP_DIV(inner, kFusedTileSize);
+
+    OMP_PARALLEL_FOR_
+    for (int task = 0; task < outer * tiles; ++task) {
+        const int o     = task / tiles;
+        const int begin = (task % tiles) * kFusedTileSize;
+        const int count = std::min(kFusedTileSize, inner - begin);
+
+        // operands of the tile
+        const float *operands[16];
+        for (int i = 0; i < input_data.size(); ++i) {
+            int offset = 0, remain = o;
+            for (int d = (int)outer_dims.size() - 1; d >= 0; --d) {
+                offset += (remain % outer_dims[d]) * outer_strides[i][d];
+                remain /= outer_dims[d];
+            }
+            operands[i] = input_data[i] + offset + (broadcast[i] ? 0 : begin);
+        }
+
+        float *value = output + (size_t)o * inner + begin;
+        if (broadcast[0]) {
+            std::fill(value, value + count, operands[0][0]);
+        } else if (value != operands[0]) {
+            memcpy(value, operands[0], count * sizeof(float));
+        }
+        for (const auto &step : steps) {
+            const int operand = step.operand;
+            FusedStepTile<VEC, pack>(step, value, operand >= 0 ? operands[operand] : nullptr,
+                                     operand >= 0 && broadcast[operand], count);
+        }
+    }
+}
+
+Status X86FusedElementwiseLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<FusedElementwiseLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: layer acc dont support datatype: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: layer acc dont support datatype");
+    }
+    if (inputs.size() > 16) {
+        return Status(TNNERR_LAYER_ERR, "FusedElementwise supports at most 16 inputs");
+    }
+
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    const int rank   = (int)output_dims.size();
+    std::vector<DimsVector> input_dims;
+    for (auto blob : inputs) {
+        auto dims = blob->GetBlobDesc().dims;
+        dims.insert(dims.begin(), rank - dims.size(), 1);
+        input_dims.push_back(dims);
+    }
+
+    // the inner part of the output is the longest run of trailing dims on which every input is either
+    // contiguous or a single broadcast value, the outer dims index the inputs with broadcast strides
+    const int input_count = (int)inputs.size();
+    std::vector<int> modes(input_count, 0);  // 0: undecided, 1: contiguous, 2: broadcast
+    int split = rank;
+    for (int d = rank - 1; d >= 0; --d) {
+        if (output_dims[d] == 1) {
+            split = d;
+            continue;
+        }
+        std::vector<int> new_modes = modes;
+        bool extend                = true;
+        for (int i = 0; i < input_count; ++i) {
+            const int mode = input_dims[i][d] == output_dims[d] ? 1 : 2;
+            if (new_modes[i] != 0 && new_modes[i] != mode) {
+                extend = false;
+                break;
+            }
+            new_modes[i] = mode;
+        }
+        if (!extend) {
+            break;
+        }
+        modes = new_modes;
+        split = d;
+    }
+
+    DimsVector outer_dims(output_dims.begin(), output_dims.begin() + split);
+    const int inner = DimsVectorUtils::Count(output_dims, split);
+    std::vector<DimsVector> outer_strides;
+    std::vector<bool> broadcast;
+    std::vector<const float *> input_data;
+    for (int i = 0; i < input_count; ++i) {
+        DimsVector strides(split, 0);
+        int stride = DimsVectorUtils::Count(input_dims[i], split);
+        for (int d = split - 1; d >= 0; --d) {
+            strides[d] = input_dims[i][d] == 1 ? 0 : stride;
+            stride *= input_dims[i][d];
+        }
+        outer_strides.push_back(strides);
+        broadcast.push_back(modes[i] == 2);
+        input_data.push_back(
+            (const float *)((char *)inputs[i]->GetHandle().base + inputs[i]->GetHandle().bytes_offset));
+    }
+    float *output = (float *)((char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset);
+
+    if (arch_ == avx2) {
+        FusedElementwiseKernel<Float8, 8>(layer_param->steps, input_data, outer_strides, broadcast, outer_dims, inner,
+                                          output);
+    } else {
+        FusedElementwiseKernel<Float4, 4>(layer_param->steps, input_data, outer_strides, broadcast, outer_dims, inner,
+                                          output);
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+}  // namespace TNN_NS
@@ -65,5 +65,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, avx2, unary2_kernel_avx<X86_GELU_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_GELU, sse42, unary2_kernel_sse<X86_GELU_OP>);
 DECLARE_X86_UNARY2_ACC(Gelu, LAYER_GELU);
 REGISTER_X86_ACC(Gelu, LAYER_GELU);
+REGISTER_X86_LAYOUT(LAYER_GELU, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(GLU, LAYER_GLU);
+
+template <typename VEC, int pack>
+static void X86GLU(const float *input, float *output, int batch, int split, int count) {
+    const int count_vec = count / pack * pack;
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int bc = 0; bc < batch * split; ++bc) {
+        const int n           = bc / split;
+        const int c           = bc % split;
+        const float *first    = input + (n * 2 * split + c) * count;
+        const float *second   = first + split * count;
+        float *dst            = output + bc * count;
+        int i = 0;
+        for (; i < count_vec; i += pack) {
+            VEC::saveu(dst + i, VEC::mul(VEC::loadu(first + i), VEC::sigmoid(VEC::loadu(second + i))));
+        }
+        for (; i < count; ++i) {
+            dst[i] = first[i] / (1.0f + std::exp(-second[i]));
+        }
+    }
+}
+
+Status X86GLULayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<GLULayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: X86GLULayerAcc don't support data type: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: X86GLULayerAcc don't support data type");
+    }
+
+    const auto &input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto &output_dims = outputs[0]->GetBlobDesc().dims;
+    const int axis          = param->axis;
+    const int batch         = DimsVectorUtils::Count(input_dims, 0, axis);
+    const int split         = output_dims[axis];
+    const int count         = DimsVectorUtils::Count(input_dims, axis + 1);
+
+    auto input_data  = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data = handle_ptr<float *>(outputs[0]->GetHandle());
+    if (arch_ == avx2) {
+        X86GLU<Float8, 8>(input_data, output_data, batch, split, count);
+    } else {
+        X86GLU<Float4, 4>(input_data, output_data, batch, split, count);
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GLU, LAYER_GLU);
+
+}  // namespace TNN_NS
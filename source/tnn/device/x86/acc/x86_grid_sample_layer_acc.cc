@@ -0,0 +1,108 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(GridSample, LAYER_GRIDSAMPLE);
+
+static inline bool WithinBounds2D(int h, int w, int H, int W) {
+    return h >= 0 && h < H && w >= 0 && w < W;
+}
+
+Status X86GridSampleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<GridSampleLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (param->mode != 2 || param->pad_type != 0 || param->align_corners != 0) {
+        return Status(TNNERR_PARAM_ERR, "X86GridSampleLayerAcc dont support some mode or pade type or align_corners");
+    }
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_PARAM_ERR, "X86GridSampleLayerAcc now only support float data");
+    }
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto grid_dims   = inputs[1]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    if (output_dims.size() != 4) {
+        return Status(TNNERR_PARAM_ERR, "X86GridSampleLayerAcc only support 4D sampler");
+    }
+
+    const int batch         = input_dims[0];
+    const int channel       = input_dims[1];
+    const int input_height  = input_dims[2];
+    const int input_width   = input_dims[3];
+    const int input_area    = input_height * input_width;
+    const int output_height = output_dims[2];
+    const int output_width  = output_dims[3];
+    const int output_area   = output_height * output_width;
+    const int grid_area     = DimsVectorUtils::Count(grid_dims, 1);
+    const int grid_width    = grid_dims[2];
+
+    auto input_data  = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto grid_data   = handle_ptr<float *>(inputs[1]->GetHandle());
+    auto output_data = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    // corner indices and weights are computed once per output row and shared by all channels
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int nh = 0; nh < batch * output_height; ++nh) {
+        const int n = nh / output_height;
+        const int h = nh % output_height;
+
+        std::vector<int> index(output_width * 4);
+        std::vector<float> weight(output_width * 4);
+
+        const float *grid_row = grid_data + n * grid_area + h * grid_width * 2;
+        for (int w = 0; w < output_width; ++w) {
+            const float ix = (grid_row[w * 2] + 1) * input_width * 0.5f - 0.5f;
+            const float iy = (grid_row[w * 2 + 1] + 1) * input_height * 0.5f - 0.5f;
+            const int x0   = static_cast<int>(std::floor(ix));
+            const int y0   = static_cast<int>(std::floor(iy));
+            const int x1   = x0 + 1;
+            const int y1   = y0 + 1;
+            // north-west, north-east, south-west, south-east
+            const int xs[4]   = {x0, x1, x0, x1};
+            const int ys[4]   = {y0, y0, y1, y1};
+            const float ws[4] = {(x1 - ix) * (y1 - iy), (ix - x0) * (y1 - iy), (x1 - ix) * (iy - y0),
+                                 (ix - x0) * (iy - y0)};
+            for (int k = 0; k < 4; ++k) {
+                bool within       = WithinBounds2D(ys[k], xs[k], input_height, input_width);
+                index[w * 4 + k]  = within ? ys[k] * input_width + xs[k] : 0;
+                weight[w * 4 + k] = within ? ws[k] : 0;
+            }
+        }
+
+        const float *input_n = input_data + n * channel * input_area;
+        float *output_n      = output_data + n * channel * output_area + h * output_width;
+        for (int c = 0; c < channel; ++c) {
+            const float *src = input_n + c * input_area;
+            float *dst       = output_n + c * output_area;
+            for (int w = 0; w < output_width; ++w) {
+                const int *idx   = index.data() + w * 4;
+                const float *wgt = weight.data() + w * 4;
+                dst[w] = src[idx[0]] * wgt[0] + src[idx[1]] * wgt[1] + src[idx[2]] * wgt[2] + src[idx[3]] * wgt[3];
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GridSample, LAYER_GRIDSAMPLE);
+
+}  // namespace TNN_NS
@@ -0,0 +1,335 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_gru_layer_acc.h"
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// gates: [batch, 3 * hidden_size] in order z, r, h. z and r are activated in place,
+// r (.) h_t is written to r_h if the reset gate is applied before the recurrence matmul.
+static void X86GRUActivateZR(float *gates, const float *h_t, float *r_h, int batch, int hidden_size) {
+    int len_vec = hidden_size / 4 * 4;
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int b = 0; b < batch; b++) {
+        auto z       = gates + b * 3 * hidden_size;
+        auto r       = z + hidden_size;
+        auto h_b     = h_t + b * hidden_size;
+        auto r_h_b   = r_h ? r_h + b * hidden_size : nullptr;
+        for (int i = 0; i < len_vec; i += 4) {
+            Float4 z_vec = Float4::sigmoid(Float4::loadu(z + i));
+            Float4 r_vec = Float4::sigmoid(Float4::loadu(r + i));
+            Float4::saveu(z + i, z_vec);
+            Float4::saveu(r + i, r_vec);
+            if (r_h_b) {
+                Float4::saveu(r_h_b + i, r_vec * Float4::loadu(h_b + i));
+            }
+        }
+        for (int i = len_vec; i < hidden_size; i++) {
+            z[i] = 1.f / (1.f + exp(-z[i]));
+            r[i] = 1.f / (1.f + exp(-r[i]));
+            if (r_h_b) {
+                r_h_b[i] = r[i] * h_b[i];
+            }
+        }
+    }
+}
+
+// h~ = tanh(gates_h + r (.) (h_gemm + Rbh)) if h_gemm is given, the recurrence is already in gates_h otherwise
+// h_t = (1 - z) (.) h~ + z (.) h_t
+static void X86GRUActivateH(const float *gates, const float *h_gemm, const float *rb_h, float *h_t, float *y,
+                            int batch, int hidden_size) {
+    int len_vec = hidden_size / 4 * 4;
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int b = 0; b < batch; b++) {
+        auto z     = gates + b * 3 * hidden_size;
+        auto r     = z + hidden_size;
+        auto n     = r + hidden_size;
+        auto hg_b  = h_gemm ? h_gemm + b * hidden_size : nullptr;
+        auto h_b   = h_t + b * hidden_size;
+        auto y_b   = y + b * hidden_size;
+        for (int i = 0; i < len_vec; i += 4) {
+            Float4 n_vec = Float4::loadu(n + i);
+            if (hg_b) {
+                n_vec = n_vec + Float4::loadu(r + i) * (Float4::loadu(hg_b + i) + Float4::loadu(rb_h + i));
+            }
+            n_vec        = Float4::tanh(n_vec);
+            Float4 h_vec = n_vec + Float4::loadu(z + i) * (Float4::loadu(h_b + i) - n_vec);
+            Float4::saveu(h_b + i, h_vec);
+            Float4::saveu(y_b + i, h_vec);
+        }
+        for (int i = len_vec; i < hidden_size; i++) {
+            float N = n[i];
+            if (hg_b) {
+                N += r[i] * (hg_b[i] + rb_h[i]);
+            }
+            N        = tanh(N);
+            float H  = N + z[i] * (h_b[i] - N);
+            h_b[i]   = H;
+            y_b[i]   = H;
+        }
+    }
+}
+
+Status X86GRUONNXLayerAcc::GRUOneDirection(const float *x, float *y, const float *w, const float *r_zr,
+                                           const float *r_h, const float *b, float *h_t, int seq_len,
+                                           int batch_size, int input_size, int hidden_size, int reverse) {
+    auto layer_param              = dynamic_cast<GRUONNXLayerParam *>(param_);
+    const bool linear_before_reset = layer_param->linear_before_reset != 0;
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+
+    // sgemm for weight tensor over all timesteps
+    // weights: [3*hidden_size, input_size]
+    // inputs: [seq_len, batch, input_size]
+    int K = input_size;
+    int N = seq_len * batch_size;
+    int M = 3 * hidden_size;
+
+    // temp bufs: gemm_buf, gates_buf, and one of r (.) h_t or the hidden gate recurrence
+    size_t gemm_buf_size  = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
+    size_t step_buf_size  = ROUND_UP(batch_size * hidden_size * sizeof(float), 32);
+    size_t workspace_size = gemm_buf_size + gates_buf_size + step_buf_size;
+    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
+    float *gemm_buf  = workspace;
+    float *gates_buf = workspace + gemm_buf_size / sizeof(float);
+    float *step_buf  = gates_buf + gates_buf_size / sizeof(float);
+
+    RawBuffer fake_bias(N * sizeof(float));
+    float *fake_bias_ptr = fake_bias.force_to<float *>();
+    conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M,
+            fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+
+    // fold bias of z, r and h into the input projection
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int i = 0; i < N; i++) {
+        auto gates_i = gates_buf + i * M;
+        int j = 0;
+        for (; j + 3 < M; j += 4) {
+            Float4::saveu(gates_i + j, Float4::loadu(gates_i + j) + Float4::loadu(b + j));
+        }
+        for (; j < M; j++) {
+            gates_i[j] += b[j];
+        }
+    }
+    const float *rb_h = b + M;
+
+    for (int t = 0; t < seq_len; t++) {
+        int ti = reverse ? seq_len - 1 - t : t;
+        auto gates_t = gates_buf + ti * batch_size * M;
+        auto y_t     = y + ti * batch_size * hidden_size;
+
+        // sgemm for recurrence weight of z and r, accumulated into the gates
+        // weights: [2*hidden_size, hidden_size]
+        // inputs: [batch, hidden_size]
+        conv_sgemm_tn_col_major_prepack_a(2 * hidden_size, batch_size, hidden_size, r_zr, hidden_size, h_t,
+                hidden_size, gates_t, M, nullptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+
+        if (linear_before_reset) {
+            X86GRUActivateZR(gates_t, h_t, nullptr, batch_size, hidden_size);
+            // the reset gate scales Ht-1*(Rh^T) + Rbh, keep the recurrence apart
+            conv_sgemm_tn_col_major_prepack_a(hidden_size, batch_size, hidden_size, r_h, hidden_size, h_t,
+                    hidden_size, step_buf, hidden_size, fake_bias_ptr, ActivationType_None, gemm_buf,
+                    conv_gemm_conf_);
+            X86GRUActivateH(gates_t, step_buf, rb_h, h_t, y_t, batch_size, hidden_size);
+        } else {
+            X86GRUActivateZR(gates_t, h_t, step_buf, batch_size, hidden_size);
+            // (rt (.) Ht-1)*(Rh^T), accumulated into the hidden gate
+            conv_sgemm_tn_col_major_prepack_a(hidden_size, batch_size, hidden_size, r_h, hidden_size, step_buf,
+                    hidden_size, gates_t + 2 * hidden_size, M, nullptr, ActivationType_None, gemm_buf,
+                    conv_gemm_conf_);
+            X86GRUActivateH(gates_t, nullptr, rb_h, h_t, y_t, batch_size, hidden_size);
+        }
+    }
+    return TNN_OK;
+}
+
+X86GRUONNXLayerAcc::~X86GRUONNXLayerAcc() {}
+
+Status X86GRUONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    if (inputs.size() < 4) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs");
+    }
+    for (int i = 1; i < inputs.size(); i++) {
+        if (inputs[i]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+            return Status(TNNERR_LAYER_ERR, "GRU only supports float weights");
+        }
+    }
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // weights for gates, [num_direction, 3 * hidden_size, input_size]
+    auto w_dims = inputs[1]->GetBlobDesc().dims;
+    int w_direction_size = DimsVectorUtils::Count(w_dims, 1);
+    float *w_ptr = (float *)((char*)(inputs[1]->GetHandle().base) + inputs[1]->GetHandle().bytes_offset);
+
+    // recurrence weights, [num_direction, 3 * hidden_size, hidden_size]
+    auto r_dims = inputs[2]->GetBlobDesc().dims;
+    int r_direction_size = DimsVectorUtils::Count(r_dims, 1);
+    float *r_ptr = (float *)((char*)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset);
+
+    int k_c     = conv_gemm_conf_.K_c_;
+    int m_block = conv_gemm_conf_.m_block_;
+    int hidden_size = r_dims[2];
+
+    // gate weights, rows of z, r and h are already the M dimension of the gemm
+    size_t w_pack_size = ROUND_UP(w_dims[2], k_c) * ROUND_UP(w_dims[1], m_block);
+    // align pointer of packed weights, since gemm use aligned load for input A
+    RawBuffer w_temp_buffer(w_dims[0] * w_pack_size * sizeof(float), 32);
+    for (int d = 0; d < w_dims[0]; d++) {
+        conv_pack_col_a_t(w_dims[1], w_dims[2], w_ptr + d * w_direction_size, w_dims[2],
+                          w_temp_buffer.force_to<float *>() + d * w_pack_size, conv_gemm_conf_);
+    }
+
+    // recurrence weights, z and r share one gemm, h runs after the reset gate
+    size_t r_zr_pack_size = ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    size_t r_h_pack_size  = ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+    RawBuffer r_zr_temp_buffer(r_dims[0] * r_zr_pack_size * sizeof(float), 32);
+    RawBuffer r_h_temp_buffer(r_dims[0] * r_h_pack_size * sizeof(float), 32);
+    for (int d = 0; d < r_dims[0]; d++) {
+        float *r_src = r_ptr + d * r_direction_size;
+        conv_pack_col_a_t(2 * hidden_size, hidden_size, r_src, hidden_size,
+                          r_zr_temp_buffer.force_to<float *>() + d * r_zr_pack_size, conv_gemm_conf_);
+        conv_pack_col_a_t(hidden_size, hidden_size, r_src + 2 * hidden_size * hidden_size, hidden_size,
+                          r_h_temp_buffer.force_to<float *>() + d * r_h_pack_size, conv_gemm_conf_);
+    }
+
+    w_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_zr_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_h_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_w_    = w_temp_buffer;
+    buffer_r_zr_ = r_zr_temp_buffer;
+    buffer_r_h_  = r_h_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<GRUONNXLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    // bias for gate and recurrence, [num_directions, 6*hidden_size]
+    auto b_dims     = inputs[3]->GetBlobDesc().dims;
+    int hidden_size = b_dims[1] / 6;
+    int bias_size   = hidden_size * 4;
+    RawBuffer b_temp_buffer(b_dims[0] * bias_size * sizeof(float));
+
+    float *b_ptr = (float *)((char*)(inputs[3]->GetHandle().base) + inputs[3]->GetHandle().bytes_offset);
+
+    for (int d = 0; d < b_dims[0]; d++) {
+        float *wb_d  = b_ptr + d * b_dims[1];
+        float *rb_d  = wb_d + 3 * hidden_size;
+        float *b_dst = b_temp_buffer.force_to<float *>() + d * bias_size;
+
+        for (int i = 0; i < hidden_size; i++) {
+            b_dst[i + 0 * hidden_size] = wb_d[i + 0 * hidden_size] + rb_d[i + 0 * hidden_size];
+            b_dst[i + 1 * hidden_size] = wb_d[i + 1 * hidden_size] + rb_d[i + 1 * hidden_size];
+            // Rbh is scaled by the reset gate if linear_before_reset, keep it apart then
+            b_dst[i + 2 * hidden_size] = wb_d[i + 2 * hidden_size] +
+                                         (layer_param->linear_before_reset ? 0.f : rb_d[i + 2 * hidden_size]);
+            b_dst[i + 3 * hidden_size] = rb_d[i + 2 * hidden_size];
+        }
+    }
+    b_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_b_ = b_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param   = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto T           = input_dims[0];                          // length of sequence
+    const auto batch       = input_dims[1];                          // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);  // input dimension
+    const auto hidden_size = layer_param->hidden_size;               // output dimension
+    // block size for gemm
+    int k_c     = conv_gemm_conf_.K_c_;
+    int m_block = conv_gemm_conf_.m_block_;
+
+    //X shape [sequence batch_size input_size]
+    float *x = (float *)((char*)(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset);
+
+    //Y shape [sequence batch_size num_directions *hidden_size]
+    float *y = (float *)((char*)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
+
+    float *w    = buffer_w_.force_to<float *>();
+    float *r_zr = buffer_r_zr_.force_to<float *>();
+    float *r_h  = buffer_r_h_.force_to<float *>();
+    float *b    = buffer_b_.force_to<float *>();
+    size_t w_pack_size    = ROUND_UP(input_size, k_c) * ROUND_UP(3 * hidden_size, m_block);
+    size_t r_zr_pack_size = ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    size_t r_h_pack_size  = ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+
+    //Y_h, [num_directions, batch_size, hidden_size]
+    float *h_t = nullptr;
+    RawBuffer temp_h_t;
+    if (outputs.size() >= 2) {
+        h_t = (float *)((char*)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+    } else {
+        temp_h_t = RawBuffer(num_directions * batch * hidden_size * sizeof(float));
+        h_t      = temp_h_t.force_to<float *>();
+    }
+
+    //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
+    if (inputs.size() >= 5) {
+        auto h_0 = (float *)((char*)(inputs[4]->GetHandle().base) + inputs[4]->GetHandle().bytes_offset);
+        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
+    } else {
+        memset((void *)h_t, 0, num_directions * batch * hidden_size * sizeof(float));
+    }
+
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        return GRUOneDirection(x, y, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size, layer_param->direction);
+    } else if (layer_param->direction == 2) {
+        //Y shape [num_directions sequence batch_size hidden_size]
+        RawBuffer y_temp(num_directions * T * batch * hidden_size * sizeof(float));
+        auto y0 = y_temp.force_to<float *>();
+        auto y1 = y0 + T * batch * hidden_size;
+        RETURN_ON_NEQ(GRUOneDirection(x, y0, w, r_zr, r_h, b, h_t, T, batch, input_size, hidden_size, 0), TNN_OK);
+
+        auto h_t1 = h_t + batch * hidden_size;
+        RETURN_ON_NEQ(GRUOneDirection(x, y1, w + w_pack_size, r_zr + r_zr_pack_size, r_h + r_h_pack_size,
+                                      b + 4 * hidden_size, h_t1, T, batch, input_size, hidden_size, 1),
+                      TNN_OK);
+
+        //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
+        for (int i = 0; i < T * batch; i++) {
+            memcpy(y + i * num_directions * hidden_size, y0 + i * hidden_size, hidden_size * sizeof(float));
+            memcpy(y + i * num_directions * hidden_size + hidden_size, y1 + i * hidden_size,
+                   hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRUONNX has invalid direction param");
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GRUONNX, LAYER_GRU);
+}  // namespace TNN_NS
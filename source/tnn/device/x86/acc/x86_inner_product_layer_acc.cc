@@ -16,6 +16,7 @@
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/string_format.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/acc/compute/x86_compute_int8.h"
 #include "tnn/device/x86/acc/x86_inner_product_layer_acc.h"
@@ -68,6 +69,7 @@ Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
     }
 
     RETURN_ON_NEQ(ret, TNN_OK);
+    int8_arch_ = X86Int8GemmArch(arch_);
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
@@ -104,17 +106,22 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
                 size_t weight_count = ROUND_UP(output_dims[1], oc_rup) * input_stride;
                 int data_byte_size = DataTypeUtils::GetBytesSize(res->weight_handle.GetDataType());
 
-                RawBuffer temp_buffer(weight_count * data_byte_size, oc_rup * 4);
-                float *dst = temp_buffer.force_to<float *>();
+                auto pack_func = [&](RawBuffer &packed) {
+                    RawBuffer temp_buffer(weight_count * data_byte_size, oc_rup * 4);
+                    float *dst = temp_buffer.force_to<float *>();
 
-                if (arch_ == avx2) {
-                    PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                } else if (arch_ == sse42) {
-                    PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
-                }
+                    if (arch_ == avx2) {
+                        PackC8(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    } else if (arch_ == sse42) {
+                        PackC4(dst, src, input_stride, input_stride, input_stride, output_dims[1]);
+                    }
 
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    packed = temp_buffer;
+                    return TNN_OK;
+                };
+                auto tag = "fc_gemv" + VectorToString(std::vector<int>{arch_, (int)input_stride, output_dims[1]});
+                RETURN_ON_NEQ(GetSharedPackedWeight(res->weight_handle, tag, pack_func, buffer_weight_), TNN_OK);
             } else {
                 int k_c = conv_gemm_conf_.K_c_;
                 int m_block = conv_gemm_conf_.m_block_;
@@ -123,14 +130,19 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
                 size_t weight_pack_size = ROUND_UP(K, k_c) * ROUND_UP(M, m_block);
                 const float *src = res->weight_handle.force_to<float *>();
 
-                // align pointer of packed weights, since gemm use aligned load for input A
-                RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
-                float *dst = temp_buffer.force_to<float *>();
+                auto pack_func = [&](RawBuffer &packed) {
+                    // align pointer of packed weights, since gemm use aligned load for input A
+                    RawBuffer temp_buffer(weight_pack_size * sizeof(float), 32);
+                    float *dst = temp_buffer.force_to<float *>();
 
-                conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
+                    conv_pack_col_a_t(M, K, src, K, dst, conv_gemm_conf_);
 
-                temp_buffer.SetDataType(DATA_TYPE_FLOAT);
-                buffer_weight_ = temp_buffer;
+                    temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+                    packed = temp_buffer;
+                    return TNN_OK;
+                };
+                auto tag = "fc_gemm_a" + VectorToString(std::vector<int>{K, M, k_c, m_block});
+                RETURN_ON_NEQ(GetSharedPackedWeight(res->weight_handle, tag, pack_func, buffer_weight_), TNN_OK);
             }
         } else if (res->weight_handle.GetDataType() == DATA_TYPE_INT8) {
             // trans nchw to nhwc4
@@ -141,32 +153,38 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
             size_t hw_size = DimsVectorUtils::Count(input_dims, 2);
 
             int data_byte_size = DataTypeUtils::GetBytesSize(res->weight_handle.GetDataType());
-            RawBuffer temp_buffer(oc_r4 * ic_r4 * hw_size * data_byte_size);
             const int8_t *weight_ptr = res->weight_handle.force_to<const int8_t*>();
 
-            int i = 0;
-            for (; i < oc; i++) {
-                auto w_src_oc = weight_ptr + i * ic * hw_size;
-                auto w_dst_oc = temp_buffer.force_to<int8_t *>() + i * ic_r4 * hw_size;
-                for (int hw = 0; hw < hw_size; hw++) {
-                    auto w_src_hw = w_src_oc + hw;
-                    auto w_dst_hw = w_dst_oc + hw * ic_r4;
-                    int j = 0;
-                    for (; j < ic; j++) {
-                        w_dst_hw[j] = w_src_hw[j * hw_size];
-                    }
-                    for (; j < ic_r4; j++) {
-                        w_dst_hw[j] = 0;
+            auto pack_func = [&](RawBuffer &packed) {
+                RawBuffer temp_buffer(oc_r4 * ic_r4 * hw_size * data_byte_size);
+
+                int i = 0;
+                for (; i < oc; i++) {
+                    auto w_src_oc = weight_ptr + i * ic * hw_size;
+                    auto w_dst_oc = temp_buffer.force_to<int8_t *>() + i * ic_r4 * hw_size;
+                    for (int hw = 0; hw < hw_size; hw++) {
+                        auto w_src_hw = w_src_oc + hw;
+                        auto w_dst_hw = w_dst_oc + hw * ic_r4;
+                        int j = 0;
+                        for (; j < ic; j++) {
+                            w_dst_hw[j] = w_src_hw[j * hw_size];
+                        }
+                        for (; j < ic_r4; j++) {
+                            w_dst_hw[j] = 0;
+                        }
                     }
                 }
-            }
-            for (; i < oc_r4; i++) {
-                auto w_dst_oc = temp_buffer.force_to<int8_t *>() + i * ic_r4 * hw_size;
-                memset(w_dst_oc, 0, ic_r4 * hw_size * data_byte_size);
-            }
+                for (; i < oc_r4; i++) {
+                    auto w_dst_oc = temp_buffer.force_to<int8_t *>() + i * ic_r4 * hw_size;
+                    memset(w_dst_oc, 0, ic_r4 * hw_size * data_byte_size);
+                }
 
-            temp_buffer.SetDataType(DATA_TYPE_INT8);
-            buffer_weight_ = temp_buffer;
+                temp_buffer.SetDataType(DATA_TYPE_INT8);
+                packed = temp_buffer;
+                return TNN_OK;
+            };
+            auto tag = "fc_int8" + VectorToString(std::vector<int>{(int)oc, (int)ic, (int)hw_size});
+            RETURN_ON_NEQ(GetSharedPackedWeight(res->weight_handle, tag, pack_func, buffer_weight_), TNN_OK);
         } else {
             LOGE("Error: DataType %d not support\n", res->weight_handle.GetDataType());
             return Status(TNNERR_MODEL_ERR, "innerproduct res DataType is not supported");
@@ -192,6 +210,15 @@ Status X86InnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
             memcpy(temp_buffer.force_to<float *>(), res->bias_handle.force_to<float *>(), bias_handle_size);
         }
         buffer_bias_ = temp_buffer;
+
+        // vnni kernels shift the input to u8, fold 128 * sum(weight) into bias
+        if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8 &&
+            (int8_arch_ == avx512_vnni || int8_arch_ == avx_vnni)) {
+            size_t ic_r4   = ROUND_UP(inputs[0]->GetBlobDesc().dims[1], 4);
+            size_t hw_size = DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims, 2);
+            X86Int8VnniCompensation(buffer_bias_.force_to<int32_t *>(), buffer_weight_.force_to<int8_t *>(),
+                                    dims_output[1], ic_r4 * hw_size);
+        }
     }
 
     // alloc scale buffer for int8 kernel
@@ -281,10 +308,22 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
         int oc_r4 = ROUND_UP(output_dims[1], 4);
         int hw    = DimsVectorUtils::Count(input_dims, 2);
 
+        auto gemv_func = X86GemvInt8;
+#ifdef TNN_X86_AVX512_VNNI_ENABLE
+        if (int8_arch_ == avx512_vnni) {
+            gemv_func = X86AVX512VNNIGemvInt8;
+        }
+#endif
+#ifdef TNN_X86_AVX_VNNI_ENABLE
+        if (int8_arch_ == avx_vnni) {
+            gemv_func = X86AVXVNNIGemvInt8;
+        }
+#endif
+
         for (int n = 0; n < output_dims[0]; n++) {
             auto input_ptr  = input_data + n * ic_r4 * hw;
             auto output_ptr = output_data + n * oc_r4;
-            X86GemvInt8(output_ptr, input_ptr, weight_data, bias_data, scale_data, ic_r4 * hw, oc_r4);
+            gemv_func(output_ptr, input_ptr, weight_data, bias_data, scale_data, ic_r4 * hw, oc_r4);
         }
     } else {
         return Status(TNNERR_MODEL_ERR, "blob type is unsupported");
@@ -40,6 +40,8 @@ protected:
     RawBuffer buffer_scale_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
     InnerProductCompute impl_;
+    // int8 gemv isa, may be avx512_vnni or avx_vnni
+    x86_isa_t int8_arch_ = sse42;
     std::shared_ptr<LayerResource> fc_acc_f32_resource_ = nullptr;
 };
 
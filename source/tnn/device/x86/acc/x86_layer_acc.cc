@@ -41,6 +41,15 @@ Status X86LayerAcc::Init(Context *context, LayerParam *param, LayerResource *res
     return Reshape(inputs, outputs);
 }
 
+Status X86LayerAcc::GetSharedPackedWeight(const RawBuffer &source, const std::string &tag,
+                                          PackedWeightCache::PackFunction pack_func, RawBuffer &packed) {
+    std::shared_ptr<RawBuffer> shared_packed;
+    RETURN_ON_NEQ(PackedWeightCache::Get(source, DEVICE_X86, tag, pack_func, shared_packed), TNN_OK);
+    shared_packed_weights_.push_back(shared_packed);
+    packed = *shared_packed;
+    return TNN_OK;
+}
+
 std::vector<DataFormat> X86LayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
     std::vector<DataFormat> support_list;
     if (dims_size == 4) {
@@ -52,6 +61,14 @@ std::vector<DataFormat> X86LayerAcc::SupportDataFormat(DataType data_type, int d
     return support_list;
 }
 
+std::vector<DataFormat> X86LayerAcc::SupportBlockedDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    auto support_list = X86LayerAcc::SupportDataFormat(data_type, dims_size, blob_type);
+    if (dims_size == 4 && data_type == DATA_TYPE_FLOAT && (cpu_with_isa(avx2) || cpu_with_isa(avx))) {
+        support_list.push_back(DATA_FORMAT_NC8HW8);
+    }
+    return support_list;
+}
+
 Status X86LayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Status status;
 #if TNN_PROFILE
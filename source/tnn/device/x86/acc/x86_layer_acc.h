@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "tnn/core/abstract_layer_acc.h"
@@ -22,6 +24,7 @@
 #include "tnn/device/x86/x86_util.h"
 #include "tnn/device/x86/x86_context.h"
 #include "tnn/device/x86/acc/compute/jit/utils/cpu_isa.h"
+#include "tnn/utils/packed_weight_cache.h"
 
 namespace TNN_NS {
 using namespace x86;
@@ -50,14 +53,27 @@ public:
 #endif
 
 protected:
+    // @brief get the weight packed by pack_func, instances created from the same model
+    // share one packed weight if source and tag match, tag must describe everything the
+    // packed layout depends on.
+    Status GetSharedPackedWeight(const RawBuffer &source, const std::string &tag,
+                                 PackedWeightCache::PackFunction pack_func, RawBuffer &packed);
+
+    // @brief return device layer acc support data format
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type);
+
+    // @brief data formats of accs that also run on the blocked DATA_FORMAT_NC8HW8 layout,
+    // fp32 blobs of 4 dims are stored as [n][c/8][h][w][8], the blocked layout needs avx.
+    std::vector<DataFormat> SupportBlockedDataFormat(DataType data_type, int dims_size, BlobType blob_type);
+
     LayerParam* param_          = nullptr;
     LayerResource* resource_    = nullptr;
     X86Context *context_           = nullptr;
     x86_isa_t arch_;
 
 private:
-    // @brief return device layer acc support data format
-    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type);
+    // keep the shared packed weights alive
+    std::vector<std::shared_ptr<RawBuffer>> shared_packed_weights_;
 };
 
 #define DECLARE_X86_ACC(type_string, layer_type)                                                                   \
@@ -67,10 +83,35 @@ private:
         virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;  \
     }
 
-#define REGISTER_X86_ACC(type_string, layer_type)                                                               \
+#define DECLARE_X86_ACC_WITH_FUNC(type_string, layer_type, extra_funcs)                                            \
+    class X86##type_string##LayerAcc : public X86LayerAcc {                                                        \
+    public:                                                                                                        \
+        virtual ~X86##type_string##LayerAcc(){};                                                                   \
+        virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;  \
+        extra_funcs                                                                                                \
+    }
+
+#define REGISTER_X86_ACC(type_string, layer_type)                                                             \
     X86TypeLayerAccRegister<TypeLayerAccCreator<X86##type_string##LayerAcc>> g_x86_##layer_type##_acc_register( \
         layer_type);                                                                                            \
 
+class X86TypeLayerLayoutCreator {
+public:
+    static std::shared_ptr<ImplementedLayout> UpdateImplementedLayout(LayerType layer_type, DataFormat layout) {
+        // make sure x86 device has been registered
+        TypeDeviceRegister<X86Device> x86_device_register(DEVICE_X86);
+        auto implemented_layout = GetDevice(DEVICE_X86)->GetImplementedLayout(layer_type);
+        auto updated_layout     = std::make_shared<ImplementedLayout>(*implemented_layout);
+        updated_layout->layouts.push_back(layout);
+        return updated_layout;
+    }
+};
+
+// layers run on DATA_FORMAT_NCHW by default, register the extra layouts an acc implements
+#define REGISTER_X86_LAYOUT(layer_type, layout)                                                                        \
+    X86TypeLayerLayoutRegister g_x86_##layer_type##_##layout##_layout_register(                                        \
+        layer_type, X86TypeLayerLayoutCreator::UpdateImplementedLayout(layer_type, layout));
+
 } // TNN_NS
 
 #endif // TNN_SOURCE_TNN_DEVICE_X86_X86_LAYER_ACC_H_
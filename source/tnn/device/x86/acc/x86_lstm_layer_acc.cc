@@ -17,6 +17,7 @@
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_lstm_layer_acc.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
 #include "tnn/utils/omp_utils.h"
 namespace TNN_NS {
 
@@ -61,9 +62,113 @@ static void X86LSTMActivate(const float *gates, float *h_t, float *c_t, float *y
     }
 }
 
+// batches up to this size run the recurrence as gemv over the packed weights, one pass of the weights
+// serves the whole batch, larger batches use the prepacked sgemm.
+static const int kLSTMGemvMaxBatch = 2;
+
+// load the 4 gates of pack hidden units from [units, 4] into one vector per gate
+template <typename VEC, int pack>
+static inline void X86LSTMLoadGates(const float *gates, int units, VEC &I, VEC &O, VEC &F, VEC &C) {
+    float gates_t[4 * pack] = {0};
+    for (int u = 0; u < units; u++) {
+        gates_t[0 * pack + u] = gates[u * 4 + 0];
+        gates_t[1 * pack + u] = gates[u * 4 + 1];
+        gates_t[2 * pack + u] = gates[u * 4 + 2];
+        gates_t[3 * pack + u] = gates[u * 4 + 3];
+    }
+    I = VEC::loadu(gates_t + 0 * pack);
+    O = VEC::loadu(gates_t + 1 * pack);
+    F = VEC::loadu(gates_t + 2 * pack);
+    C = VEC::loadu(gates_t + 3 * pack);
+}
+
+template <typename VEC, int pack>
+static inline void X86LSTMActivateGates(VEC I, VEC O, VEC F, VEC C, int units, float *c, float *y) {
+    I = VEC::sigmoid(I);
+    O = VEC::sigmoid(O);
+    F = VEC::sigmoid(F);
+    C = VEC::tanh(C);
+    if (units == pack) {
+        VEC cell2_vec = F * VEC::loadu(c) + I * C;
+        VEC::saveu(c, cell2_vec);
+        VEC::saveu(y, O * VEC::tanh(cell2_vec));
+    } else {
+        float c_pad[pack] = {0}, h_pad[pack];
+        memcpy(c_pad, c, units * sizeof(float));
+        VEC cell2_vec = F * VEC::loadu(c_pad) + I * C;
+        VEC::saveu(c_pad, cell2_vec);
+        VEC::saveu(h_pad, O * VEC::tanh(cell2_vec));
+        memcpy(c, c_pad, units * sizeof(float));
+        memcpy(y, h_pad, units * sizeof(float));
+    }
+}
+
+// one step of the recurrence for small batches, gates += R * h_t and the gate activations fused
+// r_gemv: [hidden_size / pack, hidden_size, 4 * pack], rows of pack hidden units in gate order i, o, f, c
+// gates: [batch, hidden_size, 4], the input projection with bias
+// two batches share each weight load, so the packed weights are streamed once per batch pair.
+template <typename VEC, int pack>
+static void X86LSTMStepGemv(const float *r_gemv, const float *gates, const float *h_t, float *c_t, float *y,
+                            int batch, int hidden_size) {
+    const int blocks = UP_DIV(hidden_size, pack);
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int jb = 0; jb < blocks; jb++) {
+        const int j       = jb * pack;
+        const int units   = MIN(hidden_size - j, pack);
+        const float *w_jb = r_gemv + jb * hidden_size * 4 * pack;
+        int b = 0;
+        for (; b + 1 < batch; b += 2) {
+            const float *h0 = h_t + b * hidden_size;
+            const float *h1 = h0 + hidden_size;
+            VEC I0, O0, F0, C0, I1, O1, F1, C1;
+            X86LSTMLoadGates<VEC, pack>(gates + (b * hidden_size + j) * 4, units, I0, O0, F0, C0);
+            X86LSTMLoadGates<VEC, pack>(gates + ((b + 1) * hidden_size + j) * 4, units, I1, O1, F1, C1);
+
+            const float *w = w_jb;
+            for (int k = 0; k < hidden_size; k++) {
+                VEC h0_k(h0[k]);
+                VEC h1_k(h1[k]);
+                VEC w_i = VEC::load(w);
+                VEC w_o = VEC::load(w + pack);
+                VEC w_f = VEC::load(w + 2 * pack);
+                VEC w_c = VEC::load(w + 3 * pack);
+                VEC::mla(I0, w_i, h0_k);
+                VEC::mla(O0, w_o, h0_k);
+                VEC::mla(F0, w_f, h0_k);
+                VEC::mla(C0, w_c, h0_k);
+                VEC::mla(I1, w_i, h1_k);
+                VEC::mla(O1, w_o, h1_k);
+                VEC::mla(F1, w_f, h1_k);
+                VEC::mla(C1, w_c, h1_k);
+                w += 4 * pack;
+            }
+            X86LSTMActivateGates<VEC, pack>(I0, O0, F0, C0, units, c_t + b * hidden_size + j,
+                                            y + b * hidden_size + j);
+            X86LSTMActivateGates<VEC, pack>(I1, O1, F1, C1, units, c_t + (b + 1) * hidden_size + j,
+                                            y + (b + 1) * hidden_size + j);
+        }
+        for (; b < batch; b++) {
+            const float *h0 = h_t + b * hidden_size;
+            VEC I, O, F, C;
+            X86LSTMLoadGates<VEC, pack>(gates + (b * hidden_size + j) * 4, units, I, O, F, C);
+
+            const float *w = w_jb;
+            for (int k = 0; k < hidden_size; k++) {
+                VEC h_k(h0[k]);
+                VEC::mla(I, VEC::load(w), h_k);
+                VEC::mla(O, VEC::load(w + pack), h_k);
+                VEC::mla(F, VEC::load(w + 2 * pack), h_k);
+                VEC::mla(C, VEC::load(w + 3 * pack), h_k);
+                w += 4 * pack;
+            }
+            X86LSTMActivateGates<VEC, pack>(I, O, F, C, units, c_t + b * hidden_size + j, y + b * hidden_size + j);
+        }
+    }
+}
+
 Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
-                              const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                              int input_size, int hidden_size, int reverse) {
+                              const float *r_gemv, const float *b, float *h_t, float *c_t, int seq_len,
+                              int batch_size, int input_size, int hidden_size, int reverse) {
     int k_c = conv_gemm_conf_.K_c_;
     int n_block = conv_gemm_conf_.n_block_;
 
@@ -86,21 +191,30 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
     float *fake_bias_ptr = fake_bias.force_to<float *>();
     conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M,
             fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
-    
+
+    // add bias for all timesteps at once
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int i = 0; i < N; i++) {
+        auto gates_i = gates_buf + i * M;
+        for (int j = 0; j < hidden_size; j++) {
+            Float4::saveu(gates_i + j * 4, Float4::loadu(gates_i + j * 4) + Float4::loadu(b + j * 4));
+        }
+    }
+
     for (int t = 0; t < seq_len; t++) {
         int ti = reverse ? seq_len - 1 - t : t;
         auto gates_t = gates_buf +  ti * batch_size * 4 * hidden_size;
         auto y_t = y + ti * batch_size * hidden_size;
 
-        // add bias
-        OMP_PARALLEL_FOR_GUIDED_
-        for (int i = 0; i < batch_size; i++) {
-            auto gates_b = gates_t + i * 4 * hidden_size;
-            for (int j = 0; j < hidden_size; j++) {
-                auto gates_j = gates_b + j * 4;
-                auto bias_j = b + j * 4;
-                Float4::saveu(gates_j, Float4::loadu(gates_j) + Float4::loadu(bias_j));
+        if (r_gemv) {
+            // y_t holds the new h until all units of the step are done
+            if (arch_ == avx2) {
+                X86LSTMStepGemv<Float8, 8>(r_gemv, gates_t, h_t, c_t, y_t, batch_size, hidden_size);
+            } else {
+                X86LSTMStepGemv<Float4, 4>(r_gemv, gates_t, h_t, c_t, y_t, batch_size, hidden_size);
             }
+            memcpy(h_t, y_t, batch_size * hidden_size * sizeof(float));
+            continue;
         }
 
         // sgemm for recurrence weight
@@ -235,11 +349,43 @@ Status X86LSTMONNXLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs
     return TNN_OK;
 }
 
+Status X86LSTMONNXLayerAcc::allocateBufferWeightGemv(const std::vector<Blob *> &inputs) {
+    // recurrence weights, [num_direction, 4 * hidden_size, hidden_size]
+    auto r_dims = inputs[2]->GetBlobDesc().dims;
+    int r_direction_size = DimsVectorUtils::Count(r_dims, 1);
+    float *r_ptr = (float *)((char*)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset);
+
+    int hidden_size = r_dims[2];
+    int pack        = arch_ == avx2 ? 8 : 4;
+    int blocks      = UP_DIV(hidden_size, pack);
+    size_t r_gemv_size = blocks * hidden_size * 4 * pack;
+    RawBuffer r_temp_buffer(r_dims[0] * r_gemv_size * sizeof(float), 32);
+
+    for (int d = 0; d < r_dims[0]; d++) {
+        float *r_src = r_ptr + d * r_direction_size;
+        float *r_dst = r_temp_buffer.force_to<float *>() + d * r_gemv_size;
+        for (int jb = 0; jb < blocks; jb++) {
+            for (int k = 0; k < hidden_size; k++) {
+                float *dst_k = r_dst + (jb * hidden_size + k) * 4 * pack;
+                for (int g = 0; g < 4; g++) {
+                    for (int u = 0; u < pack; u++) {
+                        int j = jb * pack + u;
+                        dst_k[g * pack + u] = j < hidden_size ? r_src[(g * hidden_size + j) * hidden_size + k] : 0.f;
+                    }
+                }
+            }
+        }
+    }
+    r_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_r_gemv_ = r_temp_buffer;
+
+    return TNN_OK;
+}
+
 Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
     int num_directions = layer_param->direction >=2 ? 2 : 1;
     
-    bool reverse = false;
     if (inputs.size() < 4) {
         return Status(TNNERR_LAYER_ERR, "LSTM has invalid inputs");
     }
@@ -255,8 +401,8 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     const auto T = input_dims[0]; // length of sequence
     const auto batch = input_dims[1];  // batch_size
     const auto input_size = DimsVectorUtils::Count(input_dims, 2); // input dimension
-    const auto output_dims = outputs[0]->GetBlobDesc().dims;
     const auto hidden_size = layer_param->hidden_size; // output dimension
+    const int state_size = num_directions * batch * hidden_size;
     // block size for gemm
     int k_c = conv_gemm_conf_.K_c_;
     int m_block = conv_gemm_conf_.m_block_;
@@ -276,40 +422,69 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     float *r = (float *)buffer_r_.force_to<float *>();
     auto r_dims = inputs[2]->GetBlobDesc().dims;
     size_t r_pack_size = ROUND_UP(r_dims[2], k_c) * ROUND_UP(r_dims[1], m_block);
+
+    float *r_gemv = nullptr;
+    int r_gemv_pack = arch_ == avx2 ? 8 : 4;
+    size_t r_gemv_size = UP_DIV(hidden_size, r_gemv_pack) * hidden_size * 4 * r_gemv_pack;
+    if (batch <= kLSTMGemvMaxBatch) {
+        if (!buffer_r_gemv_.GetBytesSize()) {
+            RETURN_ON_NEQ(allocateBufferWeightGemv(inputs), TNN_OK);
+        }
+        r_gemv = buffer_r_gemv_.force_to<float *>();
+    }
     
     //B[iofc] Concatenation of [Wb[iofc], Rb[iofc]], [num_directions, 8*hidden_size]
     float *b = (float *)buffer_b_.force_to<float *>();
     
-    //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
-    auto h_t = (float *)((char*)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
-    //initial_c, initial value of the cell, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
-    auto c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
+    //Y_h and Y_c, shape [num_directions, batch_size, hidden_size]
+    float *h_t = nullptr, *c_t = nullptr;
+    RawBuffer temp_h_t, temp_c_t;
+    if (outputs.size() >= 3) {
+        h_t = (float *)((char*)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+        c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
+    } else {
+        temp_h_t = RawBuffer(state_size * sizeof(float));
+        temp_c_t = RawBuffer(state_size * sizeof(float));
+        h_t      = temp_h_t.force_to<float *>();
+        c_t      = temp_c_t.force_to<float *>();
+    }
 
-    if (inputs.size() >= 6) {
+    //initial_h and initial_c, initial value of the hidden and the cell, shape [num_directions, batch_size, hidden_size]
+    //If not specified - the state kept from the last forward if stateful, assumed to be 0 otherwise.
+    const bool stateful = context_->GetEnableStatefulRecurrence() && !blob_h0;
+    if (blob_h0) {
         auto h_0 = (float *)((char*)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
         auto c_0 = (float *)((char*)(blob_c0->GetHandle().base) + blob_c0->GetHandle().bytes_offset);
-        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
-        memcpy((void *)c_t, c_0, num_directions * batch * hidden_size * sizeof(float));
+        memcpy((void *)h_t, h_0, state_size * sizeof(float));
+        memcpy((void *)c_t, c_0, state_size * sizeof(float));
+    } else if (stateful && state_version_ == context_->GetRecurrentStateVersion() &&
+               state_h_.GetBytesSize() == state_size * sizeof(float)) {
+        memcpy((void *)h_t, state_h_.force_to<float *>(), state_size * sizeof(float));
+        memcpy((void *)c_t, state_c_.force_to<float *>(), state_size * sizeof(float));
     } else {
-        memset((void *)h_t, 0, num_directions * batch * hidden_size * sizeof(float));
-        memset((void *)c_t, 0, num_directions * batch * hidden_size * sizeof(float));
+        memset((void *)h_t, 0, state_size * sizeof(float));
+        memset((void *)c_t, 0, state_size * sizeof(float));
     }
     
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTMOneDirection(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        RETURN_ON_NEQ(LSTMOneDirection(x, y, w, r, r_gemv, b, h_t, c_t, T, batch, input_size, hidden_size,
+                                       layer_param->direction), TNN_OK);
     } else if (layer_param->direction == 2) {
         //Y shape [num_directions sequence batch_size hidden_size]
         auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
         auto y0 = y_temp.get();
         auto y1 = y0 + T * batch * hidden_size;
-        LSTMOneDirection(x, y0, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, 0);
+        RETURN_ON_NEQ(LSTMOneDirection(x, y0, w, r, r_gemv, b, h_t, c_t, T, batch, input_size, hidden_size, 0),
+                      TNN_OK);
         
         auto w1 = w + w_pack_size;
         auto r1 = r + r_pack_size;
+        auto r_gemv1 = r_gemv ? r_gemv + r_gemv_size : nullptr;
         auto b1 = b + 4 * hidden_size;
         auto h_t1 = h_t + batch * hidden_size;
         auto c_t1 = c_t + batch * hidden_size;
-        LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1);
+        RETURN_ON_NEQ(LSTMOneDirection(x, y1, w1, r1, r_gemv1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1),
+                      TNN_OK);
         
         //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
         for (int i = 0; i < T*batch; i++) {
@@ -324,6 +499,16 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         return Status(TNNERR_PARAM_ERR, "LSTMONNX has invalid direction param");
     }
 
+    if (stateful) {
+        if (state_h_.GetBytesSize() != state_size * sizeof(float)) {
+            state_h_ = RawBuffer(state_size * sizeof(float));
+            state_c_ = RawBuffer(state_size * sizeof(float));
+        }
+        memcpy(state_h_.force_to<float *>(), h_t, state_size * sizeof(float));
+        memcpy(state_c_.force_to<float *>(), c_t, state_size * sizeof(float));
+        state_version_ = context_->GetRecurrentStateVersion();
+    }
+
     return TNN_OK;
 }
 
@@ -30,14 +30,24 @@ public:
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 protected:
-    Status LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
+    Status LSTMOneDirection(const float *x, float *y, const float *w, const float *r, const float *r_gemv,
                            const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
                            int input_size, int hidden_size, int reverse);
+    // pack recurrence weights for the gemv recurrence of small batches
+    Status allocateBufferWeightGemv(const std::vector<Blob *> &inputs);
 
     RawBuffer buffer_w_;
     RawBuffer buffer_r_;
+    // recurrence weights of pack hidden units x 4 gates per row, pack is 8 for avx2 and 4 otherwise
+    // [num_directions, hidden_size / pack, hidden_size, 4 * pack]
+    RawBuffer buffer_r_gemv_;
     RawBuffer buffer_b_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
+
+    // h and c carried to the next forward if stateful recurrence is enabled
+    RawBuffer state_h_;
+    RawBuffer state_c_;
+    int state_version_ = -1;
 };
 
 }  // namespace TNN_NS
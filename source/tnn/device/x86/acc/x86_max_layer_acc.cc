@@ -19,5 +19,6 @@ namespace TNN_NS {
 DECLARE_X86_BINARY_OP_ACC(Max, X86BinaryOpType::kMAX);
 
 REGISTER_X86_ACC(Max, LAYER_MAXIMUM);
+REGISTER_X86_LAYOUT(LAYER_MAXIMUM, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
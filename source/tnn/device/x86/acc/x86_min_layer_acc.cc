@@ -19,5 +19,6 @@ namespace TNN_NS {
 DECLARE_X86_BINARY_OP_ACC(Min, X86BinaryOpType::kMIN);
 
 REGISTER_X86_ACC(Min, LAYER_MINIMUM);
+REGISTER_X86_LAYOUT(LAYER_MINIMUM, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
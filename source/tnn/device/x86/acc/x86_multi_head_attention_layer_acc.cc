@@ -0,0 +1,175 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/Float8.h"
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+// offset of the matrix at index b of batch_dims in an input of dims broadcast to batch_dims
+static int BatchOffset(const DimsVector &dims, const DimsVector &batch_dims, int b) {
+    const int rank   = (int)dims.size() - 2;
+    const int offset = (int)batch_dims.size() - rank;
+    int matrix_offset = 0;
+    int stride        = dims[rank] * dims[rank + 1];
+    for (int i = (int)batch_dims.size() - 1; i >= 0; --i) {
+        const int index = b % batch_dims[i];
+        b /= batch_dims[i];
+        if (i >= offset) {
+            matrix_offset += dims[i - offset] == 1 ? 0 : index * stride;
+            stride *= dims[i - offset];
+        }
+    }
+    return matrix_offset;
+}
+
+// one query row of the attention, the scores of the row stay in cache from q * k to the product with v
+// q: [head_dim], k: [head_dim, seq_k], v: [seq_k, v_dim], mask: seq_k values at mask_step
+template <typename VEC, int pack>
+static void AttentionRow(const float *q, const float *k, const float *v, const float *mask, int mask_step,
+                         float *output, float *scores, int head_dim, int seq_k, int v_dim, float scale) {
+    // scores = q * k * scale + mask
+    int j = 0;
+    for (; j + pack - 1 < seq_k; j += pack) {
+        VEC acc(0.f);
+        for (int d = 0; d < head_dim; ++d) {
+            VEC::mla(acc, VEC::loadu(k + d * seq_k + j), VEC(q[d]));
+        }
+        VEC::saveu(scores + j, acc * VEC(scale));
+    }
+    for (; j < seq_k; ++j) {
+        float acc = 0.f;
+        for (int d = 0; d < head_dim; ++d) {
+            acc += q[d] * k[d * seq_k + j];
+        }
+        scores[j] = acc * scale;
+    }
+    if (mask) {
+        for (j = 0; j < seq_k; ++j) {
+            scores[j] += mask[j * mask_step];
+        }
+    }
+
+    // softmax without the division, the sum scales the output instead
+    float max_score = -FLT_MAX;
+    for (j = 0; j < seq_k; ++j) {
+        max_score = std::max(max_score, scores[j]);
+    }
+    VEC max_v(max_score);
+    VEC sum_v(0.f);
+    for (j = 0; j + pack - 1 < seq_k; j += pack) {
+        VEC exp_v = VEC::exp(VEC::loadu(scores + j) - max_v);
+        VEC::saveu(scores + j, exp_v);
+        sum_v = sum_v + exp_v;
+    }
+    float sum = VEC::reduce_add(sum_v);
+    for (; j < seq_k; ++j) {
+        scores[j] = expf(scores[j] - max_score);
+        sum += scores[j];
+    }
+    const float inv_sum = 1.f / sum;
+
+    // output = scores * v / sum
+    int e = 0;
+    for (; e + pack - 1 < v_dim; e += pack) {
+        VEC acc(0.f);
+        for (j = 0; j < seq_k; ++j) {
+            VEC::mla(acc, VEC::loadu(v + j * v_dim + e), VEC(scores[j]));
+        }
+        VEC::saveu(output + e, acc * VEC(inv_sum));
+    }
+    for (; e < v_dim; ++e) {
+        float acc = 0.f;
+        for (j = 0; j < seq_k; ++j) {
+            acc += scores[j] * v[j * v_dim + e];
+        }
+        output[e] = acc * inv_sum;
+    }
+}
+
+Status X86MultiHeadAttentionLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<MultiHeadAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: layer acc dont support datatype: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: layer acc dont support datatype");
+    }
+
+    auto q_dims      = inputs[0]->GetBlobDesc().dims;
+    auto k_dims      = inputs[1]->GetBlobDesc().dims;
+    auto v_dims      = inputs[2]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    DimsVector batch_dims(output_dims.begin(), output_dims.end() - 2);
+
+    const int batch    = DimsVectorUtils::Count(batch_dims);
+    const int seq_q    = q_dims[q_dims.size() - 2];
+    const int head_dim = q_dims.back();
+    const int seq_k    = k_dims.back();
+    const int v_dim    = v_dims.back();
+    const float scale  = layer_param->scale;
+
+    const float *q = (float *)((char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset);
+    const float *k = (float *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+    const float *v = (float *)((char *)inputs[2]->GetHandle().base + inputs[2]->GetHandle().bytes_offset);
+    float *output  = (float *)((char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset);
+
+    const float *mask = nullptr;
+    DimsVector mask_dims;
+    int mask_row_step = 0, mask_col_step = 0;
+    if (inputs.size() > 3) {
+        mask      = (float *)((char *)inputs[3]->GetHandle().base + inputs[3]->GetHandle().bytes_offset);
+        mask_dims = inputs[3]->GetBlobDesc().dims;
+        mask_dims.insert(mask_dims.begin(), output_dims.size() - mask_dims.size(), 1);
+        mask_col_step = mask_dims.back() == 1 ? 0 : 1;
+        mask_row_step = mask_dims[mask_dims.size() - 2] == 1 ? 0 : mask_dims.back();
+    }
+
+    auto func = AttentionRow<Float8, 8>;
+    if (arch_ == sse42) {
+        func = AttentionRow<Float4, 4>;
+    }
+
+    // scores of one row per thread
+    const int scores_size = ROUND_UP(seq_k, 8);
+    float *workspace = reinterpret_cast<float *>(
+        context_->GetSharedWorkSpace(OMP_MAX_THREADS_NUM_ * scores_size * sizeof(float)));
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int row = 0; row < batch * seq_q; ++row) {
+        const int b = row / seq_q;
+        const int i = row % seq_q;
+        const float *q_row    = q + BatchOffset(q_dims, batch_dims, b) + i * head_dim;
+        const float *k_b      = k + BatchOffset(k_dims, batch_dims, b);
+        const float *v_b      = v + BatchOffset(v_dims, batch_dims, b);
+        const float *mask_row = mask ? mask + BatchOffset(mask_dims, batch_dims, b) + i * mask_row_step : nullptr;
+        func(q_row, k_b, v_b, mask_row, mask_col_step, output + row * v_dim, workspace + OMP_TID_ * scores_size,
+             head_dim, seq_k, v_dim, scale);
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+}  // namespace TNN_NS
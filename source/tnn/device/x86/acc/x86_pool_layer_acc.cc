@@ -30,6 +30,10 @@ using namespace x86;
 
 X86PoolLayerAcc::~X86PoolLayerAcc() {}
 
+std::vector<DataFormat> X86PoolLayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
 Status X86PoolLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     PoolingLayerParam *param = dynamic_cast<PoolingLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -38,11 +42,16 @@ Status X86PoolLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::ve
     auto dims_input  = input->GetBlobDesc().dims;
     auto dims_output = output->GetBlobDesc().dims;
 
-    int corner_l_ = 0, corner_t_ = 0, corner_r_ = dims_output[3], corner_b_ = dims_output[2];
+    corner_l_ = 0;
+    corner_t_ = 0;
+    corner_r_ = dims_output[3];
+    corner_b_ = dims_output[2];
     for (; corner_l_ * param->strides[0] - param->pads[0] < 0; corner_l_++)
         ;
     for (; corner_t_ * param->strides[1] - param->pads[2] < 0; corner_t_++)
         ;
+    corner_l_ = MIN(corner_l_, dims_output[3]);
+    corner_t_ = MIN(corner_t_, dims_output[2]);
     for (; (corner_r_ - 1) * param->strides[0] - param->pads[0] + param->kernels[0] > dims_input[3] &&
             corner_r_ > corner_l_;
         corner_r_--)
@@ -62,6 +71,10 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
 
     auto pool_type = param->pool_type;
 
+    if (outputs[0]->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        return DoForwardNC8HW8(inputs, outputs);
+    }
+
     auto input = inputs[0];
     auto output = outputs[0];
 
@@ -143,5 +156,37 @@ Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     return TNN_OK;
 }
 
+// the blocked layout is already what the pooling kernels work on, no pack or unpack is needed
+Status X86PoolLayerAcc::DoForwardNC8HW8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<PoolingLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    auto dims_input  = inputs[0]->GetBlobDesc().dims;
+    auto dims_output = outputs[0]->GetBlobDesc().dims;
+    auto input_ptr   = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_ptr  = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    const int c_block = UP_DIV(dims_output[1], 8) * dims_output[0];
+    const size_t src_hw = dims_input[3] * dims_input[2];
+    const size_t dst_hw = dims_output[3] * dims_output[2];
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int c = 0; c < c_block; c++) {
+        auto src_c = input_ptr + c * src_hw * 8;
+        auto dst_c = output_ptr + c * dst_hw * 8;
+        if (param->pool_type == 0) {
+            X86MaxPooling<Float8, 8>(src_c, dims_input[3], dims_input[2], dst_c, dims_output[3], dims_output[2],
+                                     param->kernels[0], param->kernels[1], param->strides[0], param->strides[1],
+                                     param->pads[0], param->pads[2], corner_l_, corner_r_, corner_t_, corner_b_);
+        } else {
+            X86AvgPooling<Float8, 8>(src_c, dims_input[3], dims_input[2], dst_c, dims_output[3], dims_output[2],
+                                     param->kernels[0], param->kernels[1], param->strides[0], param->strides[1],
+                                     param->pads[0], param->pads[2]);
+        }
+    }
+    return TNN_OK;
+}
+
 REGISTER_X86_ACC(Pool, LAYER_POOLING);
+REGISTER_X86_LAYOUT(LAYER_POOLING, DATA_FORMAT_NC8HW8);
 }
@@ -28,7 +28,12 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+protected:
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) override;
+
 private:
+    Status DoForwardNC8HW8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     int corner_l_;
     int corner_r_;
     int corner_t_;
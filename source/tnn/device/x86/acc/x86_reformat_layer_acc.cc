@@ -29,7 +29,22 @@ Status X86ReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResou
     CHECK_PARAM_NULL(reformat_param);
 
     scale_buffer_.resize(inputs.size());
-    if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
+    if (reformat_param->src_format != reformat_param->dst_format &&
+        reformat_param->src_type == reformat_param->dst_type) {
+        if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->src_format == DATA_FORMAT_NC8HW8 &&
+            reformat_param->dst_format == DATA_FORMAT_NCHW) {
+            reformat_param->type = NC8HW8FP32_2_NCHWFP32;
+        } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->src_format == DATA_FORMAT_NCHW &&
+                   reformat_param->dst_format == DATA_FORMAT_NC8HW8) {
+            reformat_param->type = NCHWFP32_2_NC8HW8FP32;
+        } else {
+            LOGE("X86ReformatLayerAcc::Init Error: src_fmt: %d, dst_fmt: %d, src_type: %d, dst_type: %d\n",
+                 reformat_param->src_format, reformat_param->dst_format, reformat_param->src_type,
+                 reformat_param->dst_type);
+            return Status(TNNERR_MODEL_ERR, "X86ReformatLayerAcc::Init unsupport reformat type");
+        }
+        return TNN_OK;
+    } else if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
         reformat_param->type = DEQUANT_ONLY;
         for (auto blob : outputs) {
             blob->GetBlobDesc().data_format = DATA_FORMAT_NCHW;
@@ -47,6 +62,11 @@ Status X86ReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResou
 
 X86ReformatLayerAcc::~X86ReformatLayerAcc() {}
 
+std::vector<DataFormat> X86ReformatLayerAcc::SupportDataFormat(DataType data_type, int dims_size,
+                                                                BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
 Status X86ReformatLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<ReformatLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
@@ -88,7 +108,13 @@ Status X86ReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
         int batch   = dims[0];
         int channel = dims[1];
         int hw      = DimsVectorUtils::Count(dims, 2);
-        if (param->type == DEQUANT_ONLY) {
+        if (param->type == NC8HW8FP32_2_NCHWFP32) {
+            UnpackNC8HW8(handle_ptr<float *>(outputs[i]->GetHandle()), handle_ptr<float *>(inputs[i]->GetHandle()),
+                         batch, channel, hw);
+        } else if (param->type == NCHWFP32_2_NC8HW8FP32) {
+            PackNC8HW8(handle_ptr<float *>(outputs[i]->GetHandle()), handle_ptr<float *>(inputs[i]->GetHandle()),
+                       batch, channel, hw);
+        } else if (param->type == DEQUANT_ONLY) {
             X86Int8ToFloat(handle_ptr<float *>(outputs[i]->GetHandle()),
                            handle_ptr<int8_t *>(inputs[i]->GetHandle()),
                            scale_buffer_[i].force_to<float *>(), batch, channel, hw);
@@ -102,5 +128,6 @@ Status X86ReformatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
 }
 
 REGISTER_X86_ACC(Reformat, LAYER_REFORMAT);
+REGISTER_X86_LAYOUT(LAYER_REFORMAT, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
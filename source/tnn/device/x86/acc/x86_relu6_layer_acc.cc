@@ -38,5 +38,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_RELU6, avx2, unary2_kernel_avx<X86_RELU6_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_RELU6, sse42, unary2_kernel_sse<X86_RELU6_OP>);
 DECLARE_X86_UNARY2_ACC(Relu6, LAYER_RELU6);
 REGISTER_X86_ACC(Relu6, LAYER_RELU6);
+REGISTER_X86_LAYOUT(LAYER_RELU6, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -49,4 +49,5 @@ Status X86ReluLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
 }
 
 REGISTER_X86_ACC(Relu, LAYER_RELU);
+REGISTER_X86_LAYOUT(LAYER_RELU, DATA_FORMAT_NC8HW8);
 }   // namespace TNN_NS
\ No newline at end of file
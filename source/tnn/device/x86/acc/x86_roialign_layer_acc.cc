@@ -0,0 +1,168 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(RoiAlign, LAYER_ROIALIGN);
+
+struct RoiAlignPreCalc {
+    int pos[4];
+    float w[4];
+};
+
+// bilinear sample positions and weights of one roi, shared by all channels
+static void RoiAlignPreCalcBilinear(int height, int width, int pooled_height, int pooled_width, float roi_start_h,
+                                    float roi_start_w, float bin_size_h, float bin_size_w, int grid_h, int grid_w,
+                                    std::vector<RoiAlignPreCalc> &pre_calc) {
+    int index = 0;
+    for (int ph = 0; ph < pooled_height; ph++) {
+        for (int pw = 0; pw < pooled_width; pw++) {
+            for (int iy = 0; iy < grid_h; iy++) {
+                const float yy = roi_start_h + ph * bin_size_h + (iy + .5f) * bin_size_h / grid_h;
+                for (int ix = 0; ix < grid_w; ix++) {
+                    float x = roi_start_w + pw * bin_size_w + (ix + .5f) * bin_size_w / grid_w;
+                    float y = yy;
+
+                    RoiAlignPreCalc &pc = pre_calc[index++];
+                    if (y < -1.0 || y > height || x < -1.0 || x > width) {
+                        pc = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+                        continue;
+                    }
+
+                    y = std::max(y, 0.f);
+                    x = std::max(x, 0.f);
+
+                    int y_low = static_cast<int>(y);
+                    int x_low = static_cast<int>(x);
+                    int y_high, x_high;
+                    if (y_low >= height - 1) {
+                        y_high = y_low = height - 1;
+                        y      = (float)y_low;
+                    } else {
+                        y_high = y_low + 1;
+                    }
+                    if (x_low >= width - 1) {
+                        x_high = x_low = width - 1;
+                        x      = (float)x_low;
+                    } else {
+                        x_high = x_low + 1;
+                    }
+
+                    const float ly = y - y_low;
+                    const float lx = x - x_low;
+                    const float hy = 1.f - ly;
+                    const float hx = 1.f - lx;
+                    pc.pos[0] = y_low * width + x_low;
+                    pc.pos[1] = y_low * width + x_high;
+                    pc.pos[2] = y_high * width + x_low;
+                    pc.pos[3] = y_high * width + x_high;
+                    pc.w[0]   = hy * hx;
+                    pc.w[1]   = hy * lx;
+                    pc.w[2]   = ly * hx;
+                    pc.w[3]   = ly * lx;
+                }
+            }
+        }
+    }
+}
+
+Status X86RoiAlignLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<RoiAlignLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (inputs.size() < 3) {
+        LOGE("Error: invalid inputs count\n");
+        return Status(TNNERR_LAYER_ERR, "RoiAlign layer's inputs size must >= 3");
+    }
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: X86RoiAlignLayerAcc don't support data type: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: X86RoiAlignLayerAcc don't support data type");
+    }
+
+    const auto &input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto &output_dims = outputs[0]->GetBlobDesc().dims;
+    const int num_roi_cols  = inputs[1]->GetBlobDesc().dims[1];
+    const int num_rois      = output_dims[0];
+    const int channels      = output_dims[1];
+    const int pooled_height = output_dims[2];
+    const int pooled_width  = output_dims[3];
+    const int pooled_area   = pooled_height * pooled_width;
+    const int height        = input_dims[2];
+    const int width         = input_dims[3];
+
+    auto input_data         = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto rois_data          = handle_ptr<float *>(inputs[1]->GetHandle());
+    auto batch_indices_data = handle_ptr<int *>(inputs[2]->GetHandle());
+    auto output_data        = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    const float spatial_scale = param->spatial_scale;
+    std::vector<RoiAlignPreCalc> pre_calc;
+    for (int n = 0; n < num_rois; ++n) {
+        const float *roi  = rois_data + n * num_roi_cols;
+        // Do not using rounding; this implementation detail is critical
+        float roi_start_w = roi[0] * spatial_scale;
+        float roi_start_h = roi[1] * spatial_scale;
+        float roi_width   = std::max(roi[2] * spatial_scale - roi_start_w, 1.f);
+        float roi_height  = std::max(roi[3] * spatial_scale - roi_start_h, 1.f);
+        float bin_size_h  = roi_height / pooled_height;
+        float bin_size_w  = roi_width / pooled_width;
+
+        const int grid_h = param->sampling_ratio > 0 ? param->sampling_ratio
+                                                     : static_cast<int>(std::ceil(roi_height / pooled_height));
+        const int grid_w = param->sampling_ratio > 0 ? param->sampling_ratio
+                                                     : static_cast<int>(std::ceil(roi_width / pooled_width));
+        const int count  = grid_h * grid_w;
+
+        pre_calc.resize(count * pooled_area);
+        RoiAlignPreCalcBilinear(height, width, pooled_height, pooled_width, roi_start_h, roi_start_w, bin_size_h,
+                                bin_size_w, grid_h, grid_w, pre_calc);
+
+        const float *input_n = input_data + batch_indices_data[n] * channels * height * width;
+        float *output_n      = output_data + n * channels * pooled_area;
+        const bool avg_mode  = param->mode == 1;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int c = 0; c < channels; ++c) {
+            const float *src          = input_n + c * height * width;
+            float *dst                = output_n + c * pooled_area;
+            const RoiAlignPreCalc *pc = pre_calc.data();
+            for (int p = 0; p < pooled_area; ++p) {
+                float val = 0;
+                for (int i = 0; i < count; ++i, ++pc) {
+                    if (avg_mode) {
+                        val += pc->w[0] * src[pc->pos[0]] + pc->w[1] * src[pc->pos[1]] +
+                               pc->w[2] * src[pc->pos[2]] + pc->w[3] * src[pc->pos[3]];
+                    } else {
+                        float sample = std::max(std::max(pc->w[0] * src[pc->pos[0]], pc->w[1] * src[pc->pos[1]]),
+                                                std::max(pc->w[2] * src[pc->pos[2]], pc->w[3] * src[pc->pos[3]]));
+                        val = i == 0 ? sample : std::max(val, sample);
+                    }
+                }
+                dst[p] = avg_mode ? val / count : val;
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(RoiAlign, LAYER_ROIALIGN);
+
+}  // namespace TNN_NS
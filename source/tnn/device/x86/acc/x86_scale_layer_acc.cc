@@ -20,7 +20,13 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Scale, LAYER_SCALE);
+DECLARE_X86_ACC_WITH_FUNC(Scale, LAYER_SCALE,
+                          virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size,
+                                                                            BlobType blob_type) override;);
+
+std::vector<DataFormat> X86ScaleLayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
 
 Status X86ScaleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     
@@ -42,6 +48,10 @@ Status X86ScaleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
     RawBuffer bias_handle  = resource->bias_handle;
     bool has_bias          = bias_handle.GetDataCount() > 0; 
 
+    if (output_blob->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        x86_fma_func = X86_FMA_NC8HW8;
+    }
+
     x86_fma_func(handle_ptr<float *>(input_blob->GetHandle()),
             handle_ptr<float *>(output_blob->GetHandle()),
             scale_handle.force_to<float *>(), bias_handle.force_to<float *>(),
@@ -51,5 +61,6 @@ Status X86ScaleLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std:
 }
 
 REGISTER_X86_ACC(Scale, LAYER_SCALE);
+REGISTER_X86_LAYOUT(LAYER_SCALE, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
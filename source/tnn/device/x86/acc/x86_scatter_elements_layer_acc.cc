@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(ScatterElements, LAYER_SCATTER_ELEMENTS);
+
+Status X86ScatterElementsLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ScatterElementsLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        LOGE("Error: X86ScatterElementsLayerAcc don't support data type: %d\n", outputs[0]->GetBlobDesc().data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: X86ScatterElementsLayerAcc don't support data type");
+    }
+
+    const auto &data_dims    = inputs[0]->GetBlobDesc().dims;
+    const auto &indices_dims = inputs[1]->GetBlobDesc().dims;
+    auto data_ptr            = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto indices_ptr         = handle_ptr<int *>(inputs[1]->GetHandle());
+    auto update_ptr          = handle_ptr<float *>(inputs[2]->GetHandle());
+    auto output_ptr          = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    if (output_ptr != data_ptr) {
+        memcpy(output_ptr, data_ptr, DimsVectorUtils::Count(data_dims) * sizeof(float));
+    }
+    const int num_indices = DimsVectorUtils::Count(indices_dims);
+    if (num_indices == 0) {
+        return TNN_OK;
+    }
+
+    const int num_dims = (int)data_dims.size();
+    const int axis     = param->axis;
+    DimsVector data_strides(num_dims, 1);
+    for (int i = num_dims - 2; i >= 0; --i) {
+        data_strides[i] = data_strides[i + 1] * data_dims[i + 1];
+    }
+    const int axis_limit  = data_dims[axis];
+    const int axis_stride = data_strides[axis];
+
+    // updates are applied in order so that repeated indices behave like the naive kernel,
+    // the offset of each row is computed once and the last axis is walked linearly
+    const int width = indices_dims[num_dims - 1];
+    const int rows  = num_indices / width;
+    for (int r = 0; r < rows; ++r) {
+        int remain      = r;
+        int base_offset = 0;
+        for (int d = num_dims - 2; d >= 0; --d) {
+            if (d != axis) {
+                base_offset += (remain % indices_dims[d]) * data_strides[d];
+            }
+            remain /= indices_dims[d];
+        }
+        const int *indices  = indices_ptr + r * width;
+        const float *update = update_ptr + r * width;
+        for (int w = 0; w < width; ++w) {
+            const int idx    = indices[w] < 0 ? indices[w] + axis_limit : indices[w];
+            const int offset = base_offset + idx * axis_stride + (axis == num_dims - 1 ? 0 : w);
+            if (param->op == 0) {
+                output_ptr[offset] = update[w];
+            } else {
+                output_ptr[offset] += update[w];
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(ScatterElements, LAYER_SCATTER_ELEMENTS);
+
+}  // namespace TNN_NS
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTPLUS, avx2, unary2_kernel_avx<X86_SOFTPLUS_
 X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTPLUS, sse42, unary2_kernel_sse<X86_SOFTPLUS_OP>);
 DECLARE_X86_UNARY2_ACC(Softplus, LAYER_SOFTPLUS);
 REGISTER_X86_ACC(Softplus, LAYER_SOFTPLUS);
+REGISTER_X86_LAYOUT(LAYER_SOFTPLUS, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
@@ -36,5 +36,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTSIGN, avx2, unary2_kernel_avx<X86_SOFTSIGN_
 X86_REGISTER_UNARY2_KERNEL(LAYER_SOFTSIGN, sse42, unary2_kernel_sse<X86_SOFTSIGN_OP>);
 DECLARE_X86_UNARY2_ACC(Softsign, LAYER_SOFTSIGN);
 REGISTER_X86_ACC(Softsign, LAYER_SOFTSIGN);
+REGISTER_X86_LAYOUT(LAYER_SOFTSIGN, DATA_FORMAT_NC8HW8);
 
 }  // namespace TNN_NS
@@ -0,0 +1,24 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_binary_op_layer_acc.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_BINARY_OP_ACC(SquaredDifference, X86BinaryOpType::kSQUARED_DIFFERENCE);
+
+REGISTER_X86_ACC(SquaredDifference, LAYER_SQUARED_DIFFERENCE);
+REGISTER_X86_LAYOUT(LAYER_SQUARED_DIFFERENCE, DATA_FORMAT_NC8HW8);
+
+}   // namespace TNN_NS
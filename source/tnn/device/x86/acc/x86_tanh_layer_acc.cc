@@ -34,5 +34,6 @@ X86_REGISTER_UNARY2_KERNEL(LAYER_TANH, avx2, unary2_kernel_avx<X86_TANH_OP>);
 X86_REGISTER_UNARY2_KERNEL(LAYER_TANH, sse42, unary2_kernel_sse<X86_TANH_OP>);
 DECLARE_X86_UNARY2_ACC(Tanh, LAYER_TANH);
 REGISTER_X86_ACC(Tanh, LAYER_TANH);
+REGISTER_X86_LAYOUT(LAYER_TANH, DATA_FORMAT_NC8HW8);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC_WITH_FUNC(Tile, LAYER_REPEAT,
+                          virtual Status InferRuntimeOutputShape(const std::vector<Blob *> &inputs,
+                                                                 const std::vector<Blob *> &outputs););
+
+Status X86TileLayerAcc::InferRuntimeOutputShape(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    auto *layer_param = dynamic_cast<TileLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (inputs.size() >= 2) {
+        if (inputs[1]->GetBlobDesc().data_type != DATA_TYPE_INT32) {
+            return Status(TNNERR_PARAM_ERR, "TileLayer input(reps) has invalid data type");
+        }
+        auto dim_count = DimsVectorUtils::Count(inputs[1]->GetBlobDesc().dims);
+        auto dim_data  = handle_ptr<int *>(inputs[1]->GetHandle());
+        DimsVector reps;
+        for (int i = 0; i < dim_count; i++) {
+            reps.push_back(dim_data[i]);
+        }
+        layer_param->reps = reps;
+    }
+
+    outputs[0]->GetBlobDesc().dims = DimsFunctionUtils::Tile(inputs[0]->GetBlobDesc().dims, layer_param->reps);
+    return TNN_OK;
+}
+
+Status X86TileLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto input_dims        = inputs[0]->GetBlobDesc().dims;
+    const auto output_dims = outputs[0]->GetBlobDesc().dims;
+    while (input_dims.size() < output_dims.size()) {
+        input_dims.insert(input_dims.begin(), 1);
+    }
+    if (output_dims.empty() || DimsVectorUtils::Count(output_dims) == 0) {
+        return TNN_OK;
+    }
+
+    const int ele_size    = DataTypeUtils::GetBytesSize(outputs[0]->GetBlobDesc().data_type);
+    auto input_data       = handle_ptr<char *>(inputs[0]->GetHandle());
+    auto output_data      = handle_ptr<char *>(outputs[0]->GetHandle());
+    const int dims_size   = (int)output_dims.size();
+    const int input_width = input_dims[dims_size - 1];
+    const int row_bytes   = input_width * ele_size;
+    const int reps_width  = output_dims[dims_size - 1] / input_width;
+    const int rows        = DimsVectorUtils::Count(output_dims, 0, dims_size - 1);
+
+    // each output row repeats one input row along the last axis
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int r = 0; r < rows; ++r) {
+        int remain       = r;
+        int input_offset = 0;
+        int input_stride = input_width;
+        for (int d = dims_size - 2; d >= 0; --d) {
+            input_offset += (remain % output_dims[d]) % input_dims[d] * input_stride;
+            remain /= output_dims[d];
+            input_stride *= input_dims[d];
+        }
+        const char *src = input_data + (size_t)input_offset * ele_size;
+        char *dst       = output_data + (size_t)r * reps_width * row_bytes;
+        for (int k = 0; k < reps_width; ++k) {
+            memcpy(dst + (size_t)k * row_bytes, src, row_bytes);
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(Tile, LAYER_REPEAT);
+
+}  // namespace TNN_NS
@@ -0,0 +1,129 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <utility>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC_WITH_FUNC(TopK, LAYER_TOPK,
+                          virtual Status InferRuntimeOutputShape(const std::vector<Blob *> &inputs,
+                                                                 const std::vector<Blob *> &outputs););
+
+Status X86TopKLayerAcc::InferRuntimeOutputShape(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    auto *layer_param = dynamic_cast<TopKLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (inputs.size() >= 2) {
+        if (inputs[1]->GetBlobDesc().data_type != DATA_TYPE_INT32) {
+            return Status(TNNERR_PARAM_ERR, "TopK input(shape) has invalid data type");
+        }
+        if (DimsVectorUtils::Count(inputs[1]->GetBlobDesc().dims) != 1) {
+            return Status(TNNERR_PARAM_ERR, "TopK input(k) must have one element");
+        }
+        layer_param->k = handle_ptr<int *>(inputs[1]->GetHandle())[0];
+    }
+    if (outputs.size() != 2) {
+        return Status(TNNERR_PARAM_ERR, "TopKLayer output blobs size != 2");
+    }
+
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = input_dims;
+    if (layer_param->k > 0) {
+        output_dims[layer_param->axis] = std::min(layer_param->k, input_dims[layer_param->axis]);
+    }
+    outputs[0]->GetBlobDesc().dims = output_dims;
+    outputs[1]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+// select the k best of every column along axis with a partial sort, the result is in the
+// same order as the naive heap based implementation: best first if sorted, else reversed
+template <typename T>
+static void X86TopK(const T *input, T *output, int *output_index, const DimsVector &input_dims, int topk, int axis,
+                    bool largest, bool sorted) {
+    const int axis_size  = input_dims[axis];
+    const int inner_size = DimsVectorUtils::Count(input_dims, axis + 1);
+    const int outer_size = DimsVectorUtils::Count(input_dims, 0, axis);
+
+    auto better = [largest](const std::pair<T, int> &a, const std::pair<T, int> &b) {
+        if (a.first != b.first) {
+            return largest ? a.first > b.first : a.first < b.first;
+        }
+        return a.second < b.second;
+    };
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int oi = 0; oi < outer_size * inner_size; ++oi) {
+        const int o  = oi / inner_size;
+        const int i  = oi % inner_size;
+        const T *src = input + o * axis_size * inner_size + i;
+        std::vector<std::pair<T, int>> column(axis_size);
+        for (int k = 0; k < axis_size; ++k) {
+            column[k] = std::make_pair(src[k * inner_size], k);
+        }
+        std::partial_sort(column.begin(), column.begin() + topk, column.end(), better);
+
+        T *dst     = output + o * topk * inner_size + i;
+        int *index = output_index + o * topk * inner_size + i;
+        for (int k = 0; k < topk; ++k) {
+            const auto &record     = column[sorted ? k : topk - 1 - k];
+            dst[k * inner_size]   = record.first;
+            index[k * inner_size] = record.second;
+        }
+    }
+}
+
+Status X86TopKLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<TopKLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (outputs.size() != 2) {
+        LOGE("Error: TopKLayer must have 2 output blobs\n");
+        return Status(TNNERR_PARAM_ERR, "Error: TopKLayer must have 2 output blobs");
+    }
+
+    auto input_dims = inputs[0]->GetBlobDesc().dims;
+    if (param->axis >= input_dims.size()) {
+        LOGE("Error: TopKLayer the axis exceeds input dims\n");
+        return Status(TNNERR_PARAM_ERR, "Error: TopKLayer the axis exceeds input dims");
+    }
+    if (param->k <= 0) {
+        LOGE("Error: TopKLayer k <= 0\n");
+        return Status(TNNERR_PARAM_ERR, "Error: TopKLayer k <= 0");
+    }
+
+    const int topk  = std::min(param->k, input_dims[param->axis]);
+    auto index_data = handle_ptr<int *>(outputs[1]->GetHandle());
+    auto data_type  = inputs[0]->GetBlobDesc().data_type;
+    if (data_type == DATA_TYPE_FLOAT) {
+        X86TopK<float>(handle_ptr<float *>(inputs[0]->GetHandle()), handle_ptr<float *>(outputs[0]->GetHandle()),
+                       index_data, input_dims, topk, param->axis, param->largest, param->sorted);
+    } else if (data_type == DATA_TYPE_INT32) {
+        X86TopK<int>(handle_ptr<int *>(inputs[0]->GetHandle()), handle_ptr<int *>(outputs[0]->GetHandle()),
+                     index_data, input_dims, topk, param->axis, param->largest, param->sorted);
+    } else {
+        LOGE("Error: X86TopKLayerAcc don't support data type: %d\n", data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: X86TopKLayerAcc don't support data type");
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(TopK, LAYER_TOPK);
+
+}  // namespace TNN_NS
@@ -31,13 +31,20 @@ Status X86_UNARY2_CALCULATE(DimsVector &dims, const float *src, float *dst, Laye
 
 X86Unary2LayerAcc::~X86Unary2LayerAcc() {}
 
+std::vector<DataFormat> X86Unary2LayerAcc::SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) {
+    return SupportBlockedDataFormat(data_type, dims_size, blob_type);
+}
+
 Status X86Unary2LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
 
     auto dims = output->GetBlobDesc().dims;
+    // unary ops are elementwise, the blocked layout is computed with its padded channels
+    if (output->GetBlobDesc().data_format == DATA_FORMAT_NC8HW8) {
+        dims[1] = ROUND_UP(dims[1], 8);
+    }
 
-    int count        = DimsVectorUtils::Count(dims);
     auto input_data  = handle_ptr<float *>(input->GetHandle());
     auto output_data = handle_ptr<float *>(output->GetHandle());
 
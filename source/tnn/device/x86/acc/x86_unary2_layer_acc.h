@@ -94,6 +94,8 @@ public:
     static Status GetUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t &kernel);
 
 protected:
+    virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size, BlobType blob_type) override;
+
     // std::shared_ptr<X86_UNARY2_OP> op_;
     LayerType type_;
 
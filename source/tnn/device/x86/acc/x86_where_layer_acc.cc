@@ -0,0 +1,98 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(Where, LAYER_WHERE);
+
+// element stride of each output axis in a broadcast input, 0 for broadcast axes
+static DimsVector WhereBroadcastStrides(DimsVector input_dims, const DimsVector &output_dims) {
+    while (input_dims.size() < output_dims.size()) {
+        input_dims.insert(input_dims.begin(), 1);
+    }
+    DimsVector strides(output_dims.size(), 0);
+    int stride = 1;
+    for (int i = (int)output_dims.size() - 1; i >= 0; --i) {
+        strides[i] = input_dims[i] == output_dims[i] ? stride : 0;
+        stride *= input_dims[i];
+    }
+    return strides;
+}
+
+Status X86WhereLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // X, Y, condition order for input
+    auto data_type = outputs[0]->GetBlobDesc().data_type;
+    if (data_type != DATA_TYPE_FLOAT && data_type != DATA_TYPE_INT32) {
+        LOGE("Error: X86WhereLayerAcc don't support data type: %d\n", data_type);
+        return Status(TNNERR_MODEL_ERR, "Error: X86WhereLayerAcc don't support data type");
+    }
+
+    // float and int32 are both selected as 32-bit words
+    auto x_data      = handle_ptr<int *>(inputs[0]->GetHandle());
+    auto y_data      = handle_ptr<int *>(inputs[1]->GetHandle());
+    auto cond_data   = handle_ptr<char *>(inputs[2]->GetHandle());
+    auto output_data = handle_ptr<int *>(outputs[0]->GetHandle());
+
+    const auto &output_dims = outputs[0]->GetBlobDesc().dims;
+    const int count         = DimsVectorUtils::Count(output_dims);
+    if (count == 0) {
+        return TNN_OK;
+    }
+
+    if (DimsVectorUtils::Equal(inputs[0]->GetBlobDesc().dims, output_dims) &&
+        DimsVectorUtils::Equal(inputs[1]->GetBlobDesc().dims, output_dims) &&
+        DimsVectorUtils::Equal(inputs[2]->GetBlobDesc().dims, output_dims)) {
+        OMP_PARALLEL_FOR_
+        for (int i = 0; i < count; ++i) {
+            output_data[i] = cond_data[i] != 0 ? x_data[i] : y_data[i];
+        }
+        return TNN_OK;
+    }
+
+    const auto x_strides    = WhereBroadcastStrides(inputs[0]->GetBlobDesc().dims, output_dims);
+    const auto y_strides    = WhereBroadcastStrides(inputs[1]->GetBlobDesc().dims, output_dims);
+    const auto cond_strides = WhereBroadcastStrides(inputs[2]->GetBlobDesc().dims, output_dims);
+    const int dims_size     = (int)output_dims.size();
+    const int width         = output_dims[dims_size - 1];
+    const int rows          = count / width;
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (int r = 0; r < rows; ++r) {
+        int remain = r, x_offset = 0, y_offset = 0, cond_offset = 0;
+        for (int d = dims_size - 2; d >= 0; --d) {
+            const int index = remain % output_dims[d];
+            remain /= output_dims[d];
+            x_offset += index * x_strides[d];
+            y_offset += index * y_strides[d];
+            cond_offset += index * cond_strides[d];
+        }
+        const int *x     = x_data + x_offset;
+        const int *y     = y_data + y_offset;
+        const char *cond = cond_data + cond_offset;
+        const int xs = x_strides[dims_size - 1], ys = y_strides[dims_size - 1], cs = cond_strides[dims_size - 1];
+        int *dst     = output_data + r * width;
+        for (int w = 0; w < width; ++w) {
+            dst[w] = cond[w * cs] != 0 ? x[w * xs] : y[w * ys];
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(Where, LAYER_WHERE);
+
+}  // namespace TNN_NS
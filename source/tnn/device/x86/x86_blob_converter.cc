@@ -53,6 +53,21 @@ Status X86BlobConverterAcc::GetBlobConvertFunc(MatType mat_type, DataType data_t
     return TNN_OK;
 }
 
+// blocked nc8hw8 blobs are converted through an nchw copy of the blob
+static bool IsBlockedBlob(Blob *blob) {
+    auto desc = blob->GetBlobDesc();
+    return desc.data_type == DATA_TYPE_FLOAT && desc.data_format == DATA_FORMAT_NC8HW8;
+}
+
+static std::shared_ptr<Blob> CreateNCHWBlob(Blob *blob, std::vector<float> &nchw_data) {
+    auto desc = blob->GetBlobDesc();
+    nchw_data.resize(DimsVectorUtils::Count(desc.dims));
+    desc.data_format = DATA_FORMAT_NCHW;
+    BlobHandle handle;
+    handle.base = nchw_data.data();
+    return std::make_shared<Blob>(desc, handle);
+}
+
 Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
     Status ret = TNN_OK;
     if (blob_ == nullptr) {
@@ -87,6 +102,13 @@ Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param,
         } else {
             return ret;
         }
+    } else if (IsBlockedBlob(blob_)) {
+        auto dims = desc.dims;
+        std::vector<float> nchw_data;
+        auto nchw_blob = CreateNCHWBlob(blob_, nchw_data);
+        UnpackNC8HW8(nchw_data.data(), handle_ptr<float *>(blob_->GetHandle()), dims[0], dims[1],
+                     DimsVectorUtils::Count(dims, 2));
+        return DefaultBlobConverterAcc(nchw_blob.get()).ConvertToMatAsync(image, param, command_queue);
     } else {
         return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, command_queue);
     }
@@ -130,6 +152,13 @@ Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
         } else {
             return ret;
         }
+    } else if (IsBlockedBlob(blob_)) {
+        auto dims = desc.dims;
+        std::vector<float> nchw_data;
+        auto nchw_blob = CreateNCHWBlob(blob_, nchw_data);
+        RETURN_ON_NEQ(DefaultBlobConverterAcc(nchw_blob.get()).ConvertFromMatAsync(image, param, command_queue), TNN_OK);
+        PackNC8HW8(handle_ptr<float *>(blob_->GetHandle()), nchw_data.data(), dims[0], dims[1],
+                   DimsVectorUtils::Count(dims, 2));
     } else {
         return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, command_queue);
     }
@@ -145,6 +174,65 @@ Status X86BlobConverterAcc::ConvertFromMat(Mat &image, MatConvertParam param, vo
     return ConvertFromMatAsync(image, param, command_queue);
 }
 
+// the fused path handles float nchw blobs of host images, bilinear resize needs 2 pixels at least
+static bool CanCropAndResizeToBlob(Mat &image, Blob *blob, const std::vector<CropParam> &crops) {
+    auto desc     = blob->GetBlobDesc();
+    auto mat_type = image.GetMatType();
+    auto channel  = DimsFunctionUtils::GetDim(desc.dims, 1);
+
+    int mat_channel = 0;
+    if (mat_type == NGRAY) {
+        mat_channel = 1;
+    } else if (mat_type == N8UC3 || mat_type == NNV12 || mat_type == NNV21) {
+        mat_channel = 3;
+    } else if (mat_type == N8UC4) {
+        mat_channel = 4;
+    }
+
+    if (desc.data_type != DATA_TYPE_FLOAT || desc.data_format != DATA_FORMAT_NCHW || mat_channel == 0 ||
+        channel > mat_channel ||
+        (image.GetDeviceType() != DEVICE_X86 && image.GetDeviceType() != DEVICE_NAIVE)) {
+        return false;
+    }
+    for (auto &crop : crops) {
+        if (crop.width < 2 || crop.height < 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Status X86BlobConverterAcc::ConvertFromMatWithPreprocess(Mat &image, MatPreprocessParam preprocess,
+                                                         MatConvertParam param, void *command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    auto dims = blob_->GetBlobDesc().dims;
+    if (image.GetBatch() != DimsFunctionUtils::GetDim(dims, 0)) {
+        return BlobConverterAcc::ConvertFromMatWithPreprocess(image, preprocess, param, command_queue);
+    }
+    // the same crop of every image
+    return ConvertFromMatWithBoxes(image, std::vector<CropParam>(image.GetBatch(), preprocess.crop),
+                                   preprocess.interp_type, param, command_queue);
+}
+
+Status X86BlobConverterAcc::ConvertFromMatWithBoxes(Mat &image, const std::vector<CropParam> &boxes,
+                                                    InterpType interp_type, MatConvertParam param,
+                                                    void *command_queue) {
+    if (blob_ == nullptr) {
+        return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
+    }
+    if (!CanCropAndResizeToBlob(image, blob_, boxes)) {
+        return BlobConverterAcc::ConvertFromMatWithBoxes(image, boxes, interp_type, param, command_queue);
+    }
+
+    auto dims = blob_->GetBlobDesc().dims;
+    x86::CropAndResizeToBlob(image, boxes, interp_type, param, handle_ptr<float *>(blob_->GetHandle()),
+                             DimsFunctionUtils::GetDim(dims, 1), DimsFunctionUtils::GetDim(dims, 3),
+                             DimsFunctionUtils::GetDim(dims, 2));
+    return TNN_OK;
+}
+
 DECLARE_BLOB_CONVERTER_CREATER(X86);
 REGISTER_BLOB_CONVERTER(X86, DEVICE_X86);
 
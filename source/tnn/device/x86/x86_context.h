@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 
+#include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -52,7 +54,9 @@ public:
 
 private:
     int num_threads_ = 1;
-    std::vector<RawBuffer> work_space_;
+    // work space for each worker of the parallel layer executor
+    std::map<int, std::vector<RawBuffer>> work_space_;
+    std::mutex work_space_mutex_;
 };
 
 }  // namespace TNN_NS
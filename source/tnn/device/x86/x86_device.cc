@@ -30,6 +30,8 @@ BlobMemorySizeInfo X86Device::Calculate1DMemorySize(BlobDesc &desc) {
     int count      = 0;
     if (desc.data_type == DATA_TYPE_INT8) {
         count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * DimsVectorUtils::Count(desc.dims, 2);
+    } else if (desc.data_format == DATA_FORMAT_NC8HW8) {
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], 8) * DimsVectorUtils::Count(desc.dims, 2);
     } else {
         count = DimsVectorUtils::Count(desc.dims);
     }
@@ -85,6 +87,10 @@ Status X86Device::Free(void* handle) {
 }
 
 std::shared_ptr<const ImplementedLayout> X86Device::GetImplementedLayout(LayerType type) {
+    auto &layer_layout_map = GetLayerLayoutMap();
+    if (layer_layout_map.count(type) > 0) {
+        return layer_layout_map[type];
+    }
     auto layouts = new ImplementedLayout();
     layouts->layouts.push_back(DATA_FORMAT_NCHW);
     return std::shared_ptr<ImplementedLayout>(layouts);
@@ -136,6 +142,16 @@ std::map<LayerType, std::shared_ptr<LayerAccCreator>>& X86Device::GetLayerCreato
     return layer_creator_map;
 }
 
+Status X86Device::RegisterLayerLayout(LayerType type, std::shared_ptr<ImplementedLayout> layout) {
+    GetLayerLayoutMap()[type] = layout;
+    return TNN_OK;
+}
+
+std::map<LayerType, std::shared_ptr<ImplementedLayout>>& X86Device::GetLayerLayoutMap() {
+    static std::map<LayerType, std::shared_ptr<ImplementedLayout>> layer_layout_map;
+    return layer_layout_map;
+}
+
 TypeDeviceRegister<X86Device> g_x86_device_register(DEVICE_X86);
 
 } // namespace TNN_NS
@@ -58,9 +58,12 @@ public:
 
     static Status RegisterLayerAccCreator(LayerType type, LayerAccCreator* creator);
 
+    static Status RegisterLayerLayout(LayerType type, std::shared_ptr<ImplementedLayout> layout);
+
 private:
     BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc);
     static std::map<LayerType, std::shared_ptr<LayerAccCreator>> &GetLayerCreatorMap();
+    static std::map<LayerType, std::shared_ptr<ImplementedLayout>> &GetLayerLayoutMap();
 };
 
 // @brief X86TypeLayerAccRegister register X86TypeLayerAccCreator
@@ -72,6 +75,13 @@ public:
     }
 };
 
+class X86TypeLayerLayoutRegister {
+public:
+    explicit X86TypeLayerLayoutRegister(LayerType type, std::shared_ptr<ImplementedLayout> layout) {
+        X86Device::RegisterLayerLayout(type, layout);
+    }
+};
+
 } // namespace TNN_NS
 
 #endif // TNN_SOURCE_TNN_DEVICE_X86_X86_DEVICE_H
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <type_traits>
+#include <vector>
 
 #include "tnn/core/macro.h"
 #include "tnn/device/x86/x86_common.h"
@@ -1870,5 +1871,244 @@ void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src
     }
 }
 
+/*
+crop and resize
+*/
+
+struct FusedSourceRows {
+    // first pixel of the crop for bgr and gray images, the whole image for nv12 and nv21
+    const uint8_t* src;
+    int src_w;
+    int src_h;
+    // bytes between two rows returned by GetFusedSourceRows
+    int stride;
+    bool is_yuv;
+    bool is_nv12;
+    int crop_x;
+    int crop_y;
+    int crop_w;
+    // nv12 and nv21 rows converted to bgr, two pairs of rows at most
+    uint8_t* scratch;
+    uint8_t* bgr;
+    int cached_first;
+    int cached_last;
+};
+
+// return crop row `row`, the next row follows at rows.stride if count is 2. rows of nv12 and nv21 images are
+// converted by pairs sharing one uv row and kept until other rows are needed.
+static const uint8_t* GetFusedSourceRows(FusedSourceRows& rows, int row, int count) {
+    if (!rows.is_yuv) {
+        return rows.src + rows.stride * row;
+    }
+
+    int first = (rows.crop_y + row) & ~1;
+    int last  = (rows.crop_y + row + count - 1) & ~1;
+    if (first != rows.cached_first || last > rows.cached_last) {
+        for (int y = first; y <= last; y += 2) {
+            const uint8_t* yptr  = rows.src + y * rows.src_w + rows.crop_x;
+            const uint8_t* vuptr = rows.src + rows.src_w * rows.src_h + (y / 2) * rows.src_w + rows.crop_x;
+            memcpy(rows.scratch, yptr, rows.crop_w);
+            memcpy(rows.scratch + rows.crop_w, yptr + rows.src_w, rows.crop_w);
+            memcpy(rows.scratch + rows.crop_w * 2, vuptr, rows.crop_w);
+
+            uint8_t* bgr = rows.bgr + (y - first) * rows.stride;
+            if (rows.is_nv12) {
+                NV12ToBGR(rows.scratch, bgr, 2, rows.crop_w);
+            } else {
+                NV21ToBGR(rows.scratch, bgr, 2, rows.crop_w);
+            }
+        }
+        rows.cached_first = first;
+        rows.cached_last  = last;
+    }
+    return rows.bgr + (rows.crop_y + row - first) * rows.stride;
+}
+
+// crop every box of src and resize it to w x h, nv12 and nv21 are converted to bgr on the fly. the rows of all
+// boxes are spread over the threads, each row is resized into a per thread buffer and passed to
+// row_func(box, dy, row) while still in cache. box i reads src batch i, or batch 0 if src has one batch.
+template <int schannel, typename RowFunc>
+static void CropAndResizeRows(const uint8_t* src, int src_batch, int src_w, int src_h, bool is_yuv, bool is_nv12,
+                              const std::vector<CropParam>& crops, InterpType interp_type, int w, int h,
+                              RowFunc row_func) {
+    const int box_count = (int)crops.size();
+    const bool linear   = interp_type == INTERP_TYPE_LINEAR;
+    const int buf_size  = w + h + w + h;
+    std::vector<int> bufs(buf_size * box_count);
+    int max_crop_w = 0;
+    for (int i = 0; i < box_count; ++i) {
+        int* buf = nullptr;
+        if (linear) {
+            GetResizeBuf(crops[i].width, crops[i].height, w, h, schannel, &buf);
+        } else {
+            GetResizeBufNearset(crops[i].width, crops[i].height, w, h, schannel, &buf);
+        }
+        memcpy(bufs.data() + i * buf_size, buf, buf_size * sizeof(int));
+        delete[] buf;
+        max_crop_w = std::max(max_crop_w, crops[i].width);
+    }
+
+    const int src_plane = is_yuv ? src_w * src_h * 3 / 2 : src_w * src_h * schannel;
+    // simd loads and stores may touch a few bytes past the end of a row
+    const int row_size  = w * schannel + 16;
+    const int yuv_size  = max_crop_w * 3 + 16;
+    const int bgr_size  = max_crop_w * 3 * 4 + 16;
+
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    short* rows0        = new short[row_size * max_num_threads];
+    short* rows1        = new short[row_size * max_num_threads];
+    uint8_t* resized    = new uint8_t[row_size * max_num_threads];
+    uint8_t* yuv_rows   = is_yuv ? new uint8_t[(yuv_size + bgr_size) * max_num_threads] : nullptr;
+    short** rows0_t     = new short*[max_num_threads];
+    short** rows1_t     = new short*[max_num_threads];
+    int* prev_sy        = new int[max_num_threads];
+    int* box_t          = new int[max_num_threads];
+    std::vector<FusedSourceRows> rows_t(max_num_threads);
+    for (int t = 0; t < max_num_threads; ++t) {
+        rows0_t[t] = rows0 + t * row_size;
+        rows1_t[t] = rows1 + t * row_size;
+        box_t[t]   = -1;
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int i = 0; i < box_count * h; i++) {
+        int thread_id = OMP_TID_;
+        int box       = i / h;
+        int dy        = i % h;
+        auto& rows    = rows_t[thread_id];
+        auto& crop    = crops[box];
+        if (box != box_t[thread_id]) {
+            const uint8_t* src_b = src + (src_batch == 1 ? 0 : box) * src_plane;
+            rows.src_w           = src_w;
+            rows.src_h           = src_h;
+            rows.is_yuv          = is_yuv;
+            rows.is_nv12         = is_nv12;
+            rows.crop_x          = crop.top_left_x;
+            rows.crop_y          = crop.top_left_y;
+            rows.crop_w          = crop.width;
+            rows.cached_first    = -1;
+            rows.cached_last     = -1;
+            if (is_yuv) {
+                rows.src     = src_b;
+                rows.stride  = crop.width * 3;
+                rows.scratch = yuv_rows + thread_id * (yuv_size + bgr_size);
+                rows.bgr     = rows.scratch + yuv_size;
+            } else {
+                rows.src    = src_b + (crop.top_left_y * src_w + crop.top_left_x) * schannel;
+                rows.stride = src_w * schannel;
+            }
+            prev_sy[thread_id] = -2;
+            box_t[thread_id]   = box;
+        }
+
+        int* buf    = bufs.data() + box * buf_size;
+        int* xofs   = buf;
+        int* yofs   = buf + w;
+        uint8_t* Dp = resized + thread_id * row_size;
+        if (linear) {
+            short* ialpha    = (short*)(buf + w + h);
+            short* ibeta     = (short*)(buf + w + h + w);
+            int sy           = yofs[dy];
+            const uint8_t* S = GetFusedSourceRows(rows, sy, 2);
+            // S points to row sy, pass the previous row relative to it
+            int prev = prev_sy[thread_id] < 0 ? -2 : prev_sy[thread_id] - sy;
+            ResizeGetAdjacentRows<schannel>(0, prev, &rows0_t[thread_id], &rows1_t[thread_id], xofs, S,
+                                            rows.stride, w, ialpha);
+            prev_sy[thread_id] = sy;
+            ResizeCalculateOneRow(rows0_t[thread_id], rows1_t[thread_id], ibeta[dy * 2], ibeta[dy * 2 + 1], w,
+                                  schannel, Dp);
+        } else {
+            uint8_t* ialpha  = (uint8_t*)(buf + w + h);
+            uint8_t* ibeta   = (uint8_t*)(buf + w + h + w);
+            int sy           = (ibeta[dy] == 0) ? yofs[dy] + 1 : yofs[dy];
+            const uint8_t* S = GetFusedSourceRows(rows, sy, 1);
+            for (int dx = 0; dx < w; ++dx) {
+                int sx = (ialpha[dx] == 0) ? xofs[dx] + schannel : xofs[dx];
+                for (int dc = 0; dc < schannel; ++dc) {
+                    Dp[dx * schannel + dc] = S[sx + dc];
+                }
+            }
+        }
+        row_func(box, dy, Dp);
+    }
+
+    delete[] rows0;
+    delete[] rows1;
+    delete[] resized;
+    delete[] yuv_rows;
+    delete[] rows0_t;
+    delete[] rows1_t;
+    delete[] prev_sy;
+    delete[] box_t;
+}
+
+template <int schannel>
+static void NormalizeRowToBlob(const uint8_t* src, int w, float* dst, int channel, int plane, const float* scale,
+                               const float* bias, bool reverse_channel) {
+    for (int c = 0; c < channel; ++c) {
+        int sc           = (reverse_channel && schannel >= 3 && c < 3) ? 2 - c : c;
+        const uint8_t* S = src + sc;
+        float* D         = dst + c * plane;
+        const float s    = scale[c];
+        const float b    = bias[c];
+        for (int dx = 0; dx < w; ++dx) {
+            D[dx] = S[dx * schannel] * s + b;
+        }
+    }
+}
+
+template <int schannel>
+static void CropAndResizeImpl(Mat& src, bool is_yuv, bool is_nv12, const std::vector<CropParam>& crops,
+                              InterpType interp_type, uint8_t* dst, int w, int h) {
+    const int row_bytes = w * schannel;
+    CropAndResizeRows<schannel>((const uint8_t*)src.GetData(), src.GetBatch(), src.GetWidth(), src.GetHeight(),
+                                is_yuv, is_nv12, crops, interp_type, w, h,
+                                [&](int box, int dy, const uint8_t* row) {
+                                    memcpy(dst + (box * h + dy) * row_bytes, row, row_bytes);
+                                });
+}
+
+template <int schannel>
+static void CropAndResizeToBlobImpl(Mat& src, bool is_yuv, bool is_nv12, const std::vector<CropParam>& crops,
+                                    InterpType interp_type, const MatConvertParam& param, float* dst, int channel,
+                                    int w, int h) {
+    const int plane = w * h;
+    CropAndResizeRows<schannel>((const uint8_t*)src.GetData(), src.GetBatch(), src.GetWidth(), src.GetHeight(),
+                                is_yuv, is_nv12, crops, interp_type, w, h,
+                                [&](int box, int dy, const uint8_t* row) {
+                                    NormalizeRowToBlob<schannel>(row, w, dst + box * channel * plane + dy * w,
+                                                                 channel, plane, param.scale.data(),
+                                                                 param.bias.data(), param.reverse_channel);
+                                });
+}
+
+void CropAndResize(Mat& src, const std::vector<CropParam>& crops, InterpType interp_type, uint8_t* dst, int w,
+                   int h) {
+    auto mat_type = src.GetMatType();
+    if (mat_type == NGRAY) {
+        CropAndResizeImpl<1>(src, false, false, crops, interp_type, dst, w, h);
+    } else if (mat_type == N8UC3) {
+        CropAndResizeImpl<3>(src, false, false, crops, interp_type, dst, w, h);
+    } else if (mat_type == N8UC4) {
+        CropAndResizeImpl<4>(src, false, false, crops, interp_type, dst, w, h);
+    } else if (mat_type == NNV12 || mat_type == NNV21) {
+        CropAndResizeImpl<3>(src, true, mat_type == NNV12, crops, interp_type, dst, w, h);
+    }
+}
+
+void CropAndResizeToBlob(Mat& src, const std::vector<CropParam>& crops, InterpType interp_type,
+                         const MatConvertParam& param, float* dst, int channel, int w, int h) {
+    auto mat_type = src.GetMatType();
+    if (mat_type == NGRAY) {
+        CropAndResizeToBlobImpl<1>(src, false, false, crops, interp_type, param, dst, channel, w, h);
+    } else if (mat_type == N8UC3) {
+        CropAndResizeToBlobImpl<3>(src, false, false, crops, interp_type, param, dst, channel, w, h);
+    } else if (mat_type == N8UC4) {
+        CropAndResizeToBlobImpl<4>(src, false, false, crops, interp_type, param, dst, channel, w, h);
+    } else if (mat_type == NNV12 || mat_type == NNV21) {
+        CropAndResizeToBlobImpl<3>(src, true, mat_type == NNV12, crops, interp_type, param, dst, channel, w, h);
+    }
+}
+
 }  // namespace x86
 }  // namespace TNN_NS
@@ -469,6 +469,22 @@ int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
     return 0;
 }
 
+int PackNC8HW8(float *dst, const float *src, int batch, int channel, int hw) {
+    const int channel_r8 = ROUND_UP(channel, 8);
+    for (int b = 0; b < batch; b++) {
+        PackC8(dst + b * channel_r8 * hw, src + b * channel * hw, hw, hw, hw, channel);
+    }
+    return 0;
+}
+
+int UnpackNC8HW8(float *dst, const float *src, int batch, int channel, int hw) {
+    const int channel_r8 = ROUND_UP(channel, 8);
+    for (int b = 0; b < batch; b++) {
+        UnpackC8(dst + b * channel * hw, src + b * channel_r8 * hw, hw, hw, hw, channel);
+    }
+    return 0;
+}
+
 template<typename T>
 int MatTranspose(T *dst, const T *src, size_t M, size_t N) {
     for (size_t m = 0; m < M; m++) {
@@ -506,5 +522,28 @@ int PackINT8Weight(int8_t *src, int8_t *dst, int input_channel, int output_chann
     return 0;
 }
 
+int PackINT8WeightVnni(int8_t *src, int8_t *dst, int input_channel, int output_channel, int height, int width) {
+    const int oc_16       = (output_channel + 15) / 16;
+    const int ic_calc     = input_channel < 4 ? input_channel : ROUND_UP(input_channel, 4);
+    const int crs_round16 = ROUND_UP(ic_calc * height * width, 16);
+    memset(dst, 0, oc_16 * 16 * crs_round16);
+    for (int o = 0; o < output_channel; o++) {
+        auto zo = o / 16, ro = o % 16;
+        for (int h = 0; h < height; h++) {
+            for (int w = 0; w < width; w++) {
+                for (int i = 0; i < input_channel; i++) {
+                    // to: [o/16][h][w][i/4][o16][i4]
+                    auto o_dst = dst + zo * 16 * crs_round16 + ro * 4;
+                    auto ri    = ((h * width + w) * ic_calc + i) % 4;
+                    auto zi    = ((h * width + w) * ic_calc + i) / 4;
+                    o_dst[zi * 4 * 16 + ri] =
+                        src[o * input_channel * height * width + i * height * width + h * width + w];
+                }
+            }
+        }
+    }
+    return 0;
+}
+
 }  // namespace x86
 }  // namespace TNN
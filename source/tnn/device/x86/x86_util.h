@@ -56,11 +56,18 @@ int UnpackC4(float *dst, const float *src, size_t hw, size_t src_hw_stride, size
 
 int UnpackC8(float *dst, const float *src, size_t hw, size_t src_hw_stride, size_t dst_hw_stride, size_t channel);
 
+// @brief convert a whole fp32 tensor between nchw and the blocked nc8hw8 layout
+int PackNC8HW8(float *dst, const float *src, int batch, int channel, int hw);
+
+int UnpackNC8HW8(float *dst, const float *src, int batch, int channel, int hw);
+
 template<typename T>
 int MatTranspose(T *dst, const T *src, size_t M, size_t N);
 
 int PackINT8Weight(int8_t *src, int8_t *dst, int input_channel, int output_channel, int height, int width);
 
+int PackINT8WeightVnni(int8_t *src, int8_t *dst, int input_channel, int output_channel, int height, int width);
+
 template<typename T>
 T handle_ptr(BlobHandle &handle) {
     return reinterpret_cast<T>(((char*)handle.base) + handle.bytes_offset);
@@ -75,6 +75,12 @@ Status BaseLayerBuilder::Forward(){
     return TNN_OK;
 }
 
+LayerForwardStep BaseLayerBuilder::GetForwardStep() {
+    LayerForwardStep step;
+    step.layer = this;
+    return step;
+}
+
 //@brief get all input tensors
 std::vector<std::shared_ptr<ForeignTensor>> BaseLayerBuilder::GetInputTensors() {
     std::vector<std::shared_ptr<ForeignTensor>> input_tensors;
@@ -50,6 +50,9 @@ public:
 
     //@brief layer infer
     virtual Status Forward();
+
+    //@brief the foreign network runs the layer, always use Forward
+    virtual LayerForwardStep GetForwardStep();
 protected:
 
     //@brief Build the foreign network 
@@ -35,6 +35,12 @@ public:
     // @brief different interpreter has different order param
     virtual Status Interpret(std::vector<std::string>& params) = 0;
 
+    // @brief params hold the model file path instead of the model content, the file is
+    // mapped into memory and the weights are used in place
+    virtual Status SetMapModelFile(bool map_model_file) {
+        return map_model_file ? Status(TNNERR_LOAD_MODEL, "model type does not support mapping model file") : TNN_OK;
+    };
+
     // @brief interpret extra config, such as conv winograd for specific conv layer
     virtual Status InterpretConfig(std::map<std::string, std::string>& config_map) {
         return TNN_OK;
@@ -38,6 +38,15 @@ public:
         }                                                                                                              \
         *param_ptr = *this;                                                                                            \
         return param;                                                                                                  \
+    }                                                                                                                  \
+    virtual bool CopyFrom(LayerParam* other) {                                                                         \
+        param_type* other_ptr = dynamic_cast<param_type*>(other);                                                      \
+        if (nullptr == other_ptr) {                                                                                    \
+            LOGE("dynamic cast to %s failed\n", #param_type);                                                          \
+            return false;                                                                                              \
+        }                                                                                                              \
+        *this = *other_ptr;                                                                                            \
+        return true;                                                                                                   \
     }
 
 struct LayerParam {
@@ -100,6 +109,15 @@ struct LayerNormLayerParam : public LayerParam {
     PARAM_COPY(LayerNormLayerParam)
 };
 
+struct MultiHeadAttentionLayerParam : public LayerParam {
+    // scale of q * k before the softmax
+    float scale = 1.0f;
+    // axis of the fused softmax, must resolve to the last axis of the scores
+    int softmax_axis = -1;
+
+    PARAM_COPY(MultiHeadAttentionLayerParam)
+};
+
 struct GridSampleLayerParam : public LayerParam {
     // 1: nereast 2: bilinear/linear 3: cubic
     int mode = 2;
@@ -443,6 +461,27 @@ struct HardSigmoidLayerParam : public LayerParam {
     PARAM_COPY(HardSigmoidLayerParam)
 };
 
+// one step of a fused elementwise program
+struct FusedElementwiseStep {
+    // layer type of the step, an activation or a binary elementwise layer
+    int type = 0;
+    // input of the fused layer used as the other operand of binary steps, -1 for activations
+    int operand = -1;
+    // the operand is the left hand side of the binary step, operand - value for sub
+    bool operand_first = false;
+    // min and max of clip, alpha and beta of hard sigmoid
+    float alpha = 0.0f;
+    float beta  = 0.0f;
+};
+
+// created by the elementwise fusion optimizer, the steps are applied in order to a running value that
+// starts as input 0 broadcast to the output
+struct FusedElementwiseLayerParam : public LayerParam {
+    std::vector<FusedElementwiseStep> steps;
+
+    PARAM_COPY(FusedElementwiseLayerParam)
+};
+
 typedef enum {
     // only data_type
     QUANT_ONLY   = 0,
@@ -462,6 +501,9 @@ typedef enum {
     // nchw <-> nc4hw4 int32
     NC4HW4INT32_2_NCHWINT32 = 10,
     NCHWINT32_2_NC4HW4INT32 = 11,
+    // nchw <-> nc8hw8 fp32 for x86
+    NC8HW8FP32_2_NCHWFP32 = 12,
+    NCHWFP32_2_NC8HW8FP32 = 13,
     // to be continued
 } ReformatType;
 
@@ -617,6 +659,16 @@ struct LSTMONNXLayerParam : public LayerParam {
     PARAM_COPY(LSTMONNXLayerParam)
 };
 
+struct GRUONNXLayerParam : public LayerParam {
+    int hidden_size = 0;
+    // 0: forward 1:reverse 2:bidirection
+    int direction = 0;
+    // apply the reset gate after the recurrence matmul of the hidden gate
+    int linear_before_reset = 0;
+
+    PARAM_COPY(GRUONNXLayerParam)
+};
+
 struct ExpandLayerParam : public LayerParam {
     std::vector<int> shape;
 
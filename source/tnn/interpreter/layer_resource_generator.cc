@@ -531,6 +531,42 @@ class LSTMONNXLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+/*
+ * Generate W, R, B and the optional initial_h of GRU
+ */
+class GRUONNXLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerConstantResource(LayerParam* param, LayerResource** resource,
+                                            std::vector<Blob*>& inputs, ConstantResource* consts) {
+        LOGD("GRUONNXLayerResourceGenerator\n");
+        for (int i = 1; i < inputs.size(); i++) {
+            auto blob_name = inputs[i]->GetBlobDesc().name;
+            auto data_type = inputs[i]->GetBlobDesc().data_type;
+            auto count     = DimsVectorUtils::Count(inputs[i]->GetBlobDesc().dims);
+            if (consts->count(blob_name) > 0) {
+                continue;
+            }
+            if (data_type == DATA_TYPE_FLOAT) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(float));
+                buffer->SetBufferDims(inputs[i]->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_FLOAT);
+                InitRandom(buffer->force_to<float *>(), count, 1.0f);
+                (*consts)[blob_name] = buffer;
+            } else if (data_type == DATA_TYPE_HALF) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(fp16_t));
+                buffer->SetBufferDims(inputs[i]->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_HALF);
+                InitRandom(buffer->force_to<fp16_t *>(), count, fp16_t(1));
+                (*consts)[blob_name] = buffer;
+            }
+        }
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        return TNN_OK;
+    }
+};
+
 /*
  * Generate weights for Binary
  */
@@ -592,5 +628,6 @@ REGISTER_LAYER_RESOURCE(HdrGuide, LAYER_HDRGUIDE);
 REGISTER_LAYER_RESOURCE(MatMul, LAYER_MATMUL);
 
 REGISTER_LAYER_CONSTANT_RESOURCE(LSTMONNX, LAYER_LSTMONNX);
+REGISTER_LAYER_CONSTANT_RESOURCE(GRUONNX, LAYER_GRU);
 
 }  // namespace TNN_NS
@@ -32,7 +32,7 @@ RawBuffer::RawBuffer() :
   bytes_size_(0),
   data_type_(DATA_TYPE_FLOAT) {}
 
-RawBuffer::RawBuffer(int bytes_size) {
+RawBuffer::RawBuffer(size_t bytes_size) {
     if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memset(buff_.get(), 0, bytes_size);
@@ -43,11 +43,11 @@ RawBuffer::RawBuffer(int bytes_size) {
     bytes_size_ = bytes_size;
 }
 
-RawBuffer::RawBuffer(int bytes_size, DimsVector dims) : RawBuffer(bytes_size){
+RawBuffer::RawBuffer(size_t bytes_size, DimsVector dims) : RawBuffer(bytes_size){
     this->dims_ = dims;
 }
 
-RawBuffer::RawBuffer(int bytes_size, char *buffer) {
+RawBuffer::RawBuffer(size_t bytes_size, char *buffer) {
     if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memcpy(buff_.get(), buffer, bytes_size);
@@ -58,10 +58,15 @@ RawBuffer::RawBuffer(int bytes_size, char *buffer) {
     bytes_size_ = bytes_size;
 }
 
-RawBuffer::RawBuffer(int bytes_size, char* buffer, DimsVector dims) : RawBuffer(bytes_size, buffer) {
+RawBuffer::RawBuffer(size_t bytes_size, char* buffer, DimsVector dims) : RawBuffer(bytes_size, buffer) {
           this->dims_ = dims;
 }
 
+RawBuffer::RawBuffer(size_t bytes_size, shared_ptr<char> buffer) {
+    buff_       = bytes_size > 0 ? buffer : nullptr;
+    bytes_size_ = bytes_size;
+}
+
 RawBuffer::RawBuffer(const RawBuffer &buf) {
     this->bytes_size_ = buf.bytes_size_;
     this->data_type_  = buf.data_type_;
@@ -77,10 +82,14 @@ DimsVector RawBuffer::GetBufferDims() const {
     return this->dims_;
 }
 
+std::weak_ptr<char> RawBuffer::GetWeakReference() const {
+    return buff_;
+}
+
 void* aligned_malloc(size_t bytes_size, size_t alignment) {
     void* origin_ptr;
     void** align_ptr;
-    int offset = alignment - 1 + sizeof(void*);
+    size_t offset = alignment - 1 + sizeof(void*);
 
     origin_ptr = (void*)malloc(bytes_size + offset);
     align_ptr = (void**)(((size_t)(origin_ptr) + offset) & ~(alignment - 1));
@@ -92,7 +101,7 @@ void aligned_free(void *align_ptr) {
     free(((void**)align_ptr)[-1]);
 }
 
-RawBuffer::RawBuffer(int bytes_size, int alignment) {
+RawBuffer::RawBuffer(size_t bytes_size, int alignment) {
     buff_ = shared_ptr<char>(static_cast<char*>(aligned_malloc(bytes_size, alignment)), &aligned_free);
     memset(buff_.get(), 0, bytes_size);
     bytes_size_ = bytes_size;
@@ -137,7 +146,7 @@ RawBuffer &RawBuffer::operator=(RawBuffer buf) {
     return *this;
 }
 
-void RawBuffer::buffer(char *buf, int bytes_size) {
+void RawBuffer::buffer(char *buf, size_t bytes_size) {
     if (bytes_size > bytes_size_) {
         return;
     }
@@ -156,11 +165,11 @@ DataType RawBuffer::GetDataType() const {
     return data_type_;
 }
 
-int RawBuffer::GetBytesSize() const {
+size_t RawBuffer::GetBytesSize() const {
     return bytes_size_;
 }
 
-int RawBuffer::GetDataCount() const {
+size_t RawBuffer::GetDataCount() const {
     int elem_size = DataTypeUtils::GetBytesSize(data_type_);
     return elem_size > 0 ? bytes_size_ / elem_size : 0;
 }
@@ -215,9 +224,9 @@ RawBuffer ConvertHalfToBFP16(RawBuffer &buf) {
 }
 
 std::shared_ptr<float> GetFloatFromRawBuffer(const RawBuffer &raw_buffer) {
-    int element_size = 0;
-    DataType type    = raw_buffer.GetDataType();
-    int bytes        = raw_buffer.GetBytesSize();
+    size_t element_size = 0;
+    DataType type       = raw_buffer.GetDataType();
+    size_t bytes        = raw_buffer.GetBytesSize();
     if (0 == bytes)
         return nullptr;
 
@@ -240,7 +249,7 @@ std::shared_ptr<float> GetFloatFromRawBuffer(const RawBuffer &raw_buffer) {
 
 RawBuffer ConvertFloatToFP16(RawBuffer &buf) {
     if (buf.GetBytesSize() > 0 && buf.GetDataType() == DATA_TYPE_FLOAT) {
-        int data_count = buf.GetDataCount();
+        auto data_count = buf.GetDataCount();
         RawBuffer buf_fp16(data_count * sizeof(fp16_t));
         buf_fp16.SetDataType(DATA_TYPE_HALF);
         buf_fp16.SetBufferDims(buf.GetBufferDims());
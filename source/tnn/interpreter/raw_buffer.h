@@ -30,28 +30,33 @@ using std::shared_ptr;
 class RawBuffer {
 public:
     RawBuffer();
-    explicit RawBuffer(int bytes_size);
-    RawBuffer(int bytes_size, DimsVector dims);
-    RawBuffer(int bytes_size, char *buffer);
-    RawBuffer(int bytes_size, char* buffer, DimsVector dims);
+    explicit RawBuffer(size_t bytes_size);
+    RawBuffer(size_t bytes_size, DimsVector dims);
+    RawBuffer(size_t bytes_size, char *buffer);
+    RawBuffer(size_t bytes_size, char* buffer, DimsVector dims);
+    // @brief wrap the memory of buffer without copy, buffer keeps the memory alive
+    RawBuffer(size_t bytes_size, shared_ptr<char> buffer);
     RawBuffer(const RawBuffer &buf);
-    RawBuffer(int bytes_size, int alignment);
+    RawBuffer(size_t bytes_size, int alignment);
     RawBuffer &operator=(RawBuffer buf);
     ~RawBuffer();
 
-    void buffer(char *buf, int bytes_size);
+    void buffer(char *buf, size_t bytes_size);
     void SetDataType(DataType data_type);
     void SetBufferDims(DimsVector shape);
 
 
 
     DataType GetDataType() const;
-    int GetBytesSize() const;
-    int GetDataCount() const;
+    size_t GetBytesSize() const;
+    size_t GetDataCount() const;
     DimsVector GetBufferDims() const;
 
     void Permute(size_t outter, size_t inner);
 
+    // @brief weak reference to the buffer memory, expires when all copies are released
+    std::weak_ptr<char> GetWeakReference() const;
+
     template <typename T>
     T force_to() {
         return reinterpret_cast<T>(buff_ ? buff_.get() : nullptr);
@@ -64,7 +69,7 @@ public:
 
 private:
     shared_ptr<char> buff_ = nullptr;
-    int bytes_size_        = 0;
+    size_t bytes_size_     = 0;
     DataType data_type_    = DATA_TYPE_FLOAT;
     DimsVector dims_ = {};
 };
@@ -13,12 +13,15 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/interpreter/tnn/model_interpreter.h"
+#include <stdint.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <sstream>
 
 #include "tnn/core/common.h"
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/mapped_file.h"
 #include "tnn/utils/md5.h"
 
 namespace TNN_NS {
@@ -26,6 +29,43 @@ namespace TNN_NS {
 TypeModelInterpreterRegister<TypeModelInterpreterCreator<ModelInterpreter>> g_tnn_model_interpreter_register(
     MODEL_TYPE_TNN);
 
+// @brief MappedDeserializer reads raw buffers as views of the mapped model file
+class MappedDeserializer : public Deserializer {
+public:
+    MappedDeserializer(std::istream &is, std::shared_ptr<MappedFile> mapped_file)
+        : Deserializer(is), mapped_file_(mapped_file) {}
+
+    virtual void GetRaw(TNN_NS::RawBuffer &value) {
+        TNN_NS::DataType data_type;
+        size_t length = 0;
+        DimsVector dims;
+        if (!GetRawHeader(data_type, length, dims)) {
+            return;
+        }
+
+        auto offset = static_cast<int64_t>(_istream.tellg());
+        if (offset < 0 || offset + length > mapped_file_->GetSize()) {
+            LOGE("MappedDeserializer got truncated raw buffer\n");
+            _istream.setstate(std::ios::failbit);
+            return;
+        }
+
+        // the view keeps the mapping alive, data not aligned like heap memory is copied
+        char *data = mapped_file_->GetData() + offset;
+        if (reinterpret_cast<uintptr_t>(data) % 16 == 0) {
+            value = TNN_NS::RawBuffer(length, std::shared_ptr<char>(mapped_file_, data));
+        } else {
+            value = TNN_NS::RawBuffer(length, data);
+        }
+        value.SetDataType(data_type);
+        value.SetBufferDims(dims);
+        _istream.seekg(length, std::ios::cur);
+    }
+
+private:
+    std::shared_ptr<MappedFile> mapped_file_;
+};
+
 std::string ModelInterpreter::Transfer(std::string content) {
     return content;
 }
@@ -56,7 +96,8 @@ ModelInterpreter::ModelInterpreter(const ModelInterpreter &interp) {
 
     *(this->net_resource_) = *interp.net_resource_;
 
-    this->params_md5_ = interp.params_md5_;
+    this->params_md5_     = interp.params_md5_;
+    this->map_model_file_ = interp.map_model_file_;
 }
 
 ModelInterpreter &ModelInterpreter::operator=(ModelInterpreter interp) {
@@ -77,7 +118,8 @@ ModelInterpreter &ModelInterpreter::operator=(ModelInterpreter interp) {
     }
     *(this->net_resource_) = *interp.net_resource_;
 
-    this->params_md5_ = interp.params_md5_;
+    this->params_md5_     = interp.params_md5_;
+    this->map_model_file_ = interp.map_model_file_;
 
     return *this;
 }
@@ -123,14 +165,21 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
     }
 
     auto &model_content = params.size() > 1 ? params[1] : empty_content;
-    status              = InterpretModel(model_content);
+    std::string model_md5;
+    if (map_model_file_ && !model_content.empty()) {
+        status = InterpretModelFile(model_content, model_md5);
+    } else {
+        status = InterpretModel(model_content);
+    }
     if (status != TNN_OK) {
         return status;
     }
 
-    for (const auto& item : params) {
-        params_md5_.push_back(md5(item));
-        LOGD("model params md5: %s\n", md5(item).c_str());
+    for (int i = 0; i < params.size(); ++i) {
+        // the md5 of a mapped model is computed from the file content instead of its path
+        auto item_md5 = (i == 1 && !model_md5.empty()) ? model_md5 : md5(params[i]);
+        params_md5_.push_back(item_md5);
+        LOGD("model params md5: %s\n", item_md5.c_str());
     }
 
     if (!config_map.empty()) {
@@ -139,6 +188,11 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
     return status;
 }
 
+Status ModelInterpreter::SetMapModelFile(bool map_model_file) {
+    map_model_file_ = map_model_file;
+    return TNN_OK;
+}
+
 // Interpret the extra config map
 Status ModelInterpreter::InterpretConfig(std::map<std::string, std::string>& config_map) {
     NetStructure *structure = GetNetStructure();
@@ -398,8 +452,6 @@ Status ModelInterpreter::InterpretLayer(const std::string &layer_str) {
 }
 
 Status ModelInterpreter::InterpretModel(std::string &model_content) {
-    NetResource *net_resource = GetNetResource();
-
     const auto model_length = model_content.length();
     if (model_length <= 0) {
 #ifdef GENERATE_RESOURCE
@@ -412,6 +464,35 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 
     std::istringstream content_stream;
     content_stream.str(model_content);
+    return InterpretModelStream(content_stream, GetDeserializer(content_stream));
+}
+
+Status ModelInterpreter::InterpretModelFile(const std::string &model_path, std::string &model_md5) {
+    auto mapped_file = std::make_shared<MappedFile>();
+    RETURN_ON_NEQ(mapped_file->Open(model_path), TNN_OK);
+    if (mapped_file->GetSize() == 0) {
+        std::string empty_content = "";
+        return InterpretModel(empty_content);
+    }
+
+    // weights are read as views of the mapping, the last view released unmaps the file
+    MemoryStreamBuf stream_buf(mapped_file->GetData(), mapped_file->GetSize());
+    std::istream content_stream(&stream_buf);
+    auto deserializer = std::make_shared<MappedDeserializer>(content_stream, mapped_file);
+    RETURN_ON_NEQ(InterpretModelStream(content_stream, deserializer), TNN_OK);
+
+    MD5 md5_context;
+    const size_t chunk_size = 1 << 30;
+    for (size_t offset = 0; offset < mapped_file->GetSize(); offset += chunk_size) {
+        auto length = std::min(chunk_size, mapped_file->GetSize() - offset);
+        md5_context.update(mapped_file->GetData() + offset, static_cast<MD5::size_type>(length));
+    }
+    model_md5 = md5_context.finalize().hexdigest();
+    return TNN_OK;
+}
+
+Status ModelInterpreter::InterpretModelStream(std::istream &content_stream, std::shared_ptr<Deserializer> deserializer) {
+    NetResource *net_resource = GetNetResource();
 
     uint32_t magic_version_number = 0;
     content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
@@ -420,7 +501,6 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
     }
 
     res_header header;
-    auto deserializer = GetDeserializer(content_stream);
     header.deserialize(*deserializer);
     if (header.layer_cnt_ < 0 || header.layer_cnt_ >= 10000) {
         LOGE("tnnmodel is invalid, maybe you should upgrade TNN\n");
@@ -99,6 +99,9 @@ public:
     // model contents.
     virtual Status Interpret(std::vector<std::string>& params);
 
+    // @brief params hold the model file path instead of the model content
+    virtual Status SetMapModelFile(bool map_model_file);
+
     // @brief interpret extra config, such as conv winograd for specific conv layer
     virtual Status InterpretConfig(std::map<std::string, std::string>& config_map);
 
@@ -117,6 +120,8 @@ private:
 protected:
     virtual Status InterpretProto(std::string& content);
     virtual Status InterpretModel(std::string& model_content);
+    virtual Status InterpretModelFile(const std::string& model_path, std::string& model_md5);
+    Status InterpretModelStream(std::istream& content_stream, std::shared_ptr<Deserializer> deserializer);
     virtual Status InterpretInput(const std::string& inputs_content);
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
@@ -129,6 +134,7 @@ protected:
 
 protected:
     uint32_t version_magic_number = 0;
+    bool map_model_file_          = false;
 };
 
 }  // namespace TNN_NS
@@ -51,6 +51,10 @@ void ModelPacker::SetVersion(int version) {
     model_version_ = version;
 }
 
+void ModelPacker::SetRawAlignment(int alignment) {
+    raw_alignment_ = alignment;
+}
+
 std::shared_ptr<LayerInfo> ModelPacker::FindLayerInfo(std::string layer_name) {
     std::shared_ptr<LayerInfo> layer_info;
 
@@ -208,6 +212,7 @@ Status ModelPacker::PackModel(std::string file_path) {
 
     int resource_count = 0;
     auto serializer    = GetSerializer(write_stream);
+    serializer->SetRawAlignment(raw_alignment_);
     auto ret           = PackLayers(serializer, false, resource_count);
     if (ret != TNN_OK) {
         write_stream.close();
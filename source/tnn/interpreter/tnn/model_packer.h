@@ -32,6 +32,10 @@ public:
     // @brief set the model version to pack
     void SetVersion(int version);
 
+    // @brief align the weights to alignment bytes in the model file, so they can be used
+    // in place when the model file is mapped. 0 keeps the format readable by older versions.
+    void SetRawAlignment(int alignment);
+
 private:
     std::shared_ptr<LayerInfo> FindLayerInfo(std::string layer_name);
     Status PackProto(std::string file_path);
@@ -42,6 +46,7 @@ private:
 
 protected:
     int model_version_ = 1;
+    int raw_alignment_ = 0;
 
     virtual std::string Transfer(std::string content);
     virtual uint32_t GetMagicNumber();
@@ -17,6 +17,7 @@
 
 #include <string>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <typeinfo>
 #include "tnn/core/common.h"
@@ -28,11 +29,19 @@
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
     static const uint32_t g_version_magic_number_v2 = 0x0FABC0004;
+    // raw buffer with 64 bit length and padding before the data, so the data can be
+    // aligned in the model file and used in place once the file is mapped into memory
+    static const uint32_t g_version_magic_number_v3 = 0x0FABC0006;
 
     class Serializer {
     public:
         explicit Serializer(std::ostream &os) : _ostream(os) {}
 
+        // @brief align raw buffer data to alignment bytes from the stream start, 0 means no alignment
+        void SetRawAlignment(int alignment) {
+            _raw_alignment = alignment;
+        }
+
         void PutBool(bool value) {
             return put_basic_t<bool>(value);
         }
@@ -47,18 +56,23 @@ namespace TNN_NS {
         }
 
         virtual void PutRaw(TNN_NS::RawBuffer &value) {
-            int length = value.GetBytesSize();
+            size_t length = value.GetBytesSize();
             auto data_type = (TNN_NS::DataType)value.GetDataType();
             DimsVector  dims  = value.GetBufferDims();
             char *buffer = value.force_to<char *>();
             PutRaw(length, buffer, dims, data_type);
         }
         
-        void PutRaw(int length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
+        void PutRaw(size_t length, char* buffer, std::vector<int> dims, DataType data_type = DATA_TYPE_FLOAT)
         {
-            PutInt(g_version_magic_number_v2);
+            const bool use_v3 = _raw_alignment > 0 || length > (size_t)std::numeric_limits<int>::max();
+            PutInt(use_v3 ? g_version_magic_number_v3 : g_version_magic_number_v2);
             PutInt(data_type);
-            PutInt(static_cast<int>(length));
+            if (use_v3) {
+                put_basic_t<int64_t>(static_cast<int64_t>(length));
+            } else {
+                PutInt(static_cast<int>(length));
+            }
             if (length <= 0) {
                 return;
             }
@@ -70,6 +84,18 @@ namespace TNN_NS {
             }
             if (_ostream.bad())
                 return;
+
+            if (use_v3) {
+                int padding = 0;
+                if (_raw_alignment > 0) {
+                    auto data_pos = static_cast<int64_t>(_ostream.tellp()) + sizeof(int);
+                    padding       = static_cast<int>((_raw_alignment - data_pos % _raw_alignment) % _raw_alignment);
+                }
+                PutInt(padding);
+                for (int i = 0; i < padding; ++i) {
+                    _ostream.put(0);
+                }
+            }
  
             _ostream.write(reinterpret_cast<char *>(buffer),
                            static_cast<std::streamsize>(length));
@@ -79,6 +105,7 @@ namespace TNN_NS {
 
     protected:
         std::ostream &_ostream;
+        int _raw_alignment = 0;
         
         template <typename T>
         void put_basic_t(T value);
@@ -139,21 +166,13 @@ namespace TNN_NS {
         }
 
         virtual void GetRaw(TNN_NS::RawBuffer &value) {
-            auto magic_number  = static_cast<uint32_t>(GetInt());
-            auto data_type = (TNN_NS::DataType)GetInt();
-            int length = GetInt();
-            if (length <= 0) {
+            TNN_NS::DataType data_type;
+            size_t length = 0;
+            DimsVector dims;
+            if (!GetRawHeader(data_type, length, dims)) {
                 return;
             }
 
-            DimsVector dims;
-            if(magic_number == g_version_magic_number_v2) {
-                int size = GetInt();
-                for (int i = 0; i < size; ++i) {
-                    dims.push_back(GetInt());
-                }
-            }
- 
             value = TNN_NS::RawBuffer(length);
             value.SetDataType(data_type);
             value.SetBufferDims(dims);
@@ -168,6 +187,34 @@ namespace TNN_NS {
 
     protected:
         std::istream &_istream;
+
+        // @brief read the raw buffer fields before its data, return false if the buffer is empty
+        bool GetRawHeader(TNN_NS::DataType &data_type, size_t &length, DimsVector &dims) {
+            auto magic_number = static_cast<uint32_t>(GetInt());
+            data_type         = (TNN_NS::DataType)GetInt();
+            if (magic_number == g_version_magic_number_v3) {
+                auto length_v3 = get_basic_t<int64_t>();
+                length         = length_v3 > 0 ? static_cast<size_t>(length_v3) : 0;
+            } else {
+                int length_v2 = GetInt();
+                length        = length_v2 > 0 ? static_cast<size_t>(length_v2) : 0;
+            }
+            if (length <= 0) {
+                return false;
+            }
+
+            if (magic_number == g_version_magic_number_v2 || magic_number == g_version_magic_number_v3) {
+                int size = GetInt();
+                for (int i = 0; i < size; ++i) {
+                    dims.push_back(GetInt());
+                }
+            }
+            if (magic_number == g_version_magic_number_v3) {
+                int padding = GetInt();
+                _istream.ignore(padding);
+            }
+            return true;
+        }
         
         template <typename T>
         T get_basic_t();
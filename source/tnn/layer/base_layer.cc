@@ -177,6 +177,10 @@ Status BaseLayer::Reshape() {
             }
         }
     }
+    return ReshapeAcc();
+}
+
+Status BaseLayer::ReshapeAcc() {
     if (layer_acc_ != NULL) {
         auto status = layer_acc_->ReloadConstantBlobs(input_blobs_, true);
         RETURN_ON_NEQ(status, TNN_OK);
@@ -224,6 +228,21 @@ Status BaseLayer::Forward() {
     }
 }
 
+LayerForwardStep BaseLayer::GetForwardStep() {
+    LayerForwardStep step;
+    step.layer = this;
+    // constant folding infers shapes in forward, keep it on the generic path
+    if (layer_acc_ == NULL || runtime_model_ != RUNTIME_MODE_NORMAL) {
+        return step;
+    }
+    step.acc     = layer_acc_;
+    step.inputs  = &input_blobs_;
+    step.outputs = &output_blobs_;
+    step.run_acc = !IsOutputConstant() ||
+                   (input_blobs_[0]->GetBlobDesc().device_type == DEVICE_CUDA && !enable_const_folder_);
+    return step;
+}
+
 void BaseLayer::SetLayerName(std::string layer_name) {
     layer_name_ = layer_name;
 }
@@ -232,6 +251,10 @@ std::string BaseLayer::GetLayerName() {
     return layer_name_;
 }
 
+LayerParam* BaseLayer::GetLayerParam() {
+    return param_;
+}
+
 //@brief get all input blobs
 std::vector<Blob*> BaseLayer::GetInputBlobs() {
     return input_blobs_;
@@ -30,6 +30,19 @@
 
 namespace TNN_NS {
 
+class BaseLayer;
+
+//@brief forward step of a layer precompiled at reshape time, the network calls the acc directly
+//without copying the blob vectors. acc is null if the layer must be run by BaseLayer::Forward.
+struct LayerForwardStep {
+    BaseLayer* layer                  = nullptr;
+    AbstractLayerAcc* acc             = nullptr;
+    const std::vector<Blob*>* inputs  = nullptr;
+    const std::vector<Blob*>* outputs = nullptr;
+    // false if the outputs are constant and already computed
+    bool run_acc = true;
+};
+
 //@brief BaseLaye define the layer interface
 class BaseLayer {
 public:
@@ -46,12 +59,21 @@ public:
     //@brief Reshape recalculate the output tensor dims
     virtual Status Reshape();
 
+    //@brief reshape the layer acc only, the output dims and param are already up to date
+    Status ReshapeAcc();
+
     //@brief layer infer
     virtual Status Forward();
 
+    //@brief build the forward step used by the network, the blob pointers stay valid until the next Init
+    virtual LayerForwardStep GetForwardStep();
+
     //@brief get layer name
     std::string GetLayerName();
 
+    //@brief get layer param
+    LayerParam* GetLayerParam();
+
     //@brief set laye name
     void SetLayerName(std::string layer_name);
 
@@ -0,0 +1,65 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+Status FusedElementwiseLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+// the output is all inputs broadcast together, as the chain of layers it replaces
+Status FusedElementwiseLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    auto layer_param = dynamic_cast<FusedElementwiseLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    for (const auto &step : layer_param->steps) {
+        if (step.operand >= (int)input_blobs_.size()) {
+            LOGE_IF(!ignore_error, "Error: FusedElementwise step has invalid operand %d\n", step.operand);
+            return Status(TNNERR_PARAM_ERR, "FusedElementwise step has invalid operand");
+        }
+    }
+
+    DimsVector output_dims;
+    for (auto blob : input_blobs_) {
+        auto dims = blob->GetBlobDesc().dims;
+        if (dims.size() > output_dims.size()) {
+            output_dims.insert(output_dims.begin(), dims.size() - output_dims.size(), 1);
+        }
+        const int offset = (int)(output_dims.size() - dims.size());
+        for (int i = 0; i < dims.size(); ++i) {
+            int &dim = output_dims[offset + i];
+            if (dim == 1) {
+                dim = dims[i];
+            } else if (dims[i] != 1 && dims[i] != dim) {
+                LOGE_IF(!ignore_error, "Error: FusedElementwise has inputs of unbroadcastable dims (name: %s)\n",
+                        layer_param->name.c_str());
+                return Status(TNNERR_LAYER_ERR, "FusedElementwise has inputs of unbroadcastable dims");
+            }
+        }
+    }
+    output_blobs_[0]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(FusedElementwise, LAYER_FUSED_ELEMENTWISE);
+
+}  // namespace TNN_NS
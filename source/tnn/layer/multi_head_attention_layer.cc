@@ -0,0 +1,101 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/layer/base_layer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_LAYER(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+// broadcast the batch dims, all dims except the last two, of input to batch_dims
+static Status BroadcastBatchDims(const DimsVector &input_dims, DimsVector &batch_dims) {
+    DimsVector dims(input_dims.begin(), input_dims.end() - 2);
+    if (dims.size() > batch_dims.size()) {
+        batch_dims.insert(batch_dims.begin(), dims.size() - batch_dims.size(), 1);
+    }
+    const int offset = (int)(batch_dims.size() - dims.size());
+    for (int i = 0; i < dims.size(); ++i) {
+        int &dim = batch_dims[offset + i];
+        if (dim == 1) {
+            dim = dims[i];
+        } else if (dims[i] != 1 && dims[i] != dim) {
+            return Status(TNNERR_PARAM_ERR, "MultiHeadAttention has inputs of unbroadcastable batch dims");
+        }
+    }
+    return TNN_OK;
+}
+
+Status MultiHeadAttentionLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+// inputs: q [..., seq_q, head_dim], k [..., head_dim, seq_k], v [..., seq_k, v_dim] and an optional
+// mask broadcast to the scores [..., seq_q, seq_k], output: softmax(q * k * scale + mask) * v
+Status MultiHeadAttentionLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    auto layer_param = dynamic_cast<MultiHeadAttentionLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    if (input_blobs_.size() < 3) {
+        return Status(TNNERR_PARAM_ERR, "MultiHeadAttention needs inputs of q, k and v");
+    }
+    auto q_dims = input_blobs_[0]->GetBlobDesc().dims;
+    auto k_dims = input_blobs_[1]->GetBlobDesc().dims;
+    auto v_dims = input_blobs_[2]->GetBlobDesc().dims;
+    if (q_dims.size() < 2 || k_dims.size() < 2 || v_dims.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "MultiHeadAttention has inputs of invalid dims");
+    }
+    if (q_dims.back() != k_dims[k_dims.size() - 2] || k_dims.back() != v_dims[v_dims.size() - 2]) {
+        return Status(TNNERR_PARAM_ERR, "MultiHeadAttention has inputs of mismatched q, k and v");
+    }
+
+    DimsVector output_dims;
+    RETURN_ON_NEQ(BroadcastBatchDims(q_dims, output_dims), TNN_OK);
+    RETURN_ON_NEQ(BroadcastBatchDims(k_dims, output_dims), TNN_OK);
+    RETURN_ON_NEQ(BroadcastBatchDims(v_dims, output_dims), TNN_OK);
+
+    const int scores_rank = (int)output_dims.size() + 2;
+    const int softmax_axis = layer_param->softmax_axis < 0 ? layer_param->softmax_axis + scores_rank
+                                                           : layer_param->softmax_axis;
+    if (softmax_axis != scores_rank - 1) {
+        return Status(TNNERR_PARAM_ERR, "MultiHeadAttention only supports softmax on the last axis");
+    }
+
+    if (input_blobs_.size() > 3) {
+        auto mask_dims = input_blobs_[3]->GetBlobDesc().dims;
+        if (mask_dims.size() > scores_rank) {
+            return Status(TNNERR_PARAM_ERR, "MultiHeadAttention has mask of invalid dims");
+        }
+        mask_dims.insert(mask_dims.begin(), scores_rank - mask_dims.size(), 1);
+        const int seq_q = q_dims[q_dims.size() - 2];
+        const int seq_k = k_dims.back();
+        for (int i = 0; i < scores_rank; ++i) {
+            const int dim = i == scores_rank - 2 ? seq_q : (i == scores_rank - 1 ? seq_k : output_dims[i]);
+            if (mask_dims[i] != 1 && mask_dims[i] != dim) {
+                return Status(TNNERR_PARAM_ERR, "MultiHeadAttention has mask of unbroadcastable dims");
+            }
+        }
+    }
+
+    output_dims.push_back(q_dims[q_dims.size() - 2]);
+    output_dims.push_back(v_dims.back());
+    output_blobs_[0]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(MultiHeadAttention, LAYER_MULTI_HEAD_ATTENTION);
+
+}  // namespace TNN_NS
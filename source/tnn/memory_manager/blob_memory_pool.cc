@@ -125,6 +125,10 @@ int BlobMemoryPool::GetAllBlobMemorySize() {
     return all_blob_memory_size_;
 }
 
+int BlobMemoryPool::GetAllBlobMemorySize(MemoryAssignStrategy &strategy) {
+    return strategy.GetAllBlobMemorySize(blob_memory_library_);
+}
+
 void BlobMemoryPool::CalculateAllBlobMemorySize() {
     typename std::set<BlobMemory *>::iterator iter;
     all_blob_memory_size_ = 0;
@@ -36,6 +36,7 @@ public:
     BlobMemory *BorrowBlobMemory(int use_count, BlobMemorySizeInfo &size_info, bool use_new_memory = false);
     void RefundBlobMemory(BlobMemory *blob_memory);
     int GetAllBlobMemorySize();
+    int GetAllBlobMemorySize(MemoryAssignStrategy &strategy);
     Status AssignAllBlobMemory(MemoryAssignStrategy &strategy);
     virtual void ClearBlobMemoryPool();
     AbstractDevice *GetDevice();
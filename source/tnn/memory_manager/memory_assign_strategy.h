@@ -20,11 +20,14 @@
 
 namespace TNN_NS {
 
-enum MemoryAssignStragegyType { UNIFY = 0, SEPERATE = 1 };
+enum MemoryAssignStragegyType { UNIFY = 0, SEPERATE = 1, INTERVAL = 2 };
 
 class MemoryAssignStrategy {
 public:
     virtual Status AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) = 0;
+
+    // @brief bytes size needed by all blob memory, default lays them end to end
+    virtual int GetAllBlobMemorySize(std::set<BlobMemory*>& blob_memory_library);
 };
 
 }  // namespace TNN_NS
@@ -0,0 +1,178 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/memory_manager/memory_interval_assign_strategy.h"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// keep every blob memory aligned for simd load and store
+static const int64_t kIntervalMemoryAlignment = 64;
+
+struct IntervalMemoryItem {
+    BlobMemory* blob_memory = nullptr;
+    int64_t size            = 0;
+    int begin               = 0;
+    int end                 = 0;
+    int64_t offset          = 0;
+};
+
+static bool IsLifetimeOverlapped(const IntervalMemoryItem& a, const IntervalMemoryItem& b) {
+    return a.begin <= b.end && b.begin <= a.end;
+}
+
+// place the items in order, each item goes to the smallest gap left by the placed
+// items alive at the same time, or after all of them if no gap is large enough.
+static int64_t PlaceIntervalMemoryItems(std::vector<IntervalMemoryItem>& items, const std::vector<int>& order) {
+    int64_t arena_size = 0;
+    std::vector<int> placed;
+    std::vector<std::pair<int64_t, int64_t>> used;
+    for (auto index : order) {
+        auto& item = items[index];
+
+        used.clear();
+        for (auto other : placed) {
+            if (IsLifetimeOverlapped(item, items[other])) {
+                used.push_back(std::make_pair(items[other].offset, items[other].offset + items[other].size));
+            }
+        }
+        std::sort(used.begin(), used.end());
+
+        int64_t best_offset = -1;
+        int64_t best_gap    = LLONG_MAX;
+        int64_t prev_end    = 0;
+        for (auto& range : used) {
+            int64_t gap = range.first - prev_end;
+            if (gap >= item.size && gap < best_gap) {
+                best_gap    = gap;
+                best_offset = prev_end;
+            }
+            prev_end = std::max(prev_end, range.second);
+        }
+        item.offset = best_offset >= 0 ? best_offset : prev_end;
+        arena_size  = std::max(arena_size, item.offset + item.size);
+        placed.push_back(index);
+    }
+    return arena_size;
+}
+
+// greedy by size: the largest blob memory is placed first
+static std::vector<int> GreedyBySizeOrder(const std::vector<IntervalMemoryItem>& items) {
+    std::vector<int> order(items.size());
+    for (int i = 0; i < (int)items.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        if (items[a].size != items[b].size) {
+            return items[a].size > items[b].size;
+        }
+        return items[a].begin < items[b].begin;
+    });
+    return order;
+}
+
+// greedy by breadth: layers with the largest live memory are visited first, and
+// the blob memories alive there are placed from the largest one
+static std::vector<int> GreedyByBreadthOrder(const std::vector<IntervalMemoryItem>& items) {
+    std::vector<int> steps;
+    for (auto& item : items) {
+        steps.push_back(item.begin);
+    }
+    std::sort(steps.begin(), steps.end());
+    steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+
+    std::vector<std::pair<int64_t, int>> breadth;
+    for (auto step : steps) {
+        int64_t live_size = 0;
+        for (auto& item : items) {
+            if (item.begin <= step && step <= item.end) {
+                live_size += item.size;
+            }
+        }
+        breadth.push_back(std::make_pair(-live_size, step));
+    }
+    std::sort(breadth.begin(), breadth.end());
+
+    auto size_order = GreedyBySizeOrder(items);
+    std::vector<int> order;
+    std::vector<bool> visited(items.size(), false);
+    for (auto& iter : breadth) {
+        int step = iter.second;
+        for (auto index : size_order) {
+            if (!visited[index] && items[index].begin <= step && step <= items[index].end) {
+                visited[index] = true;
+                order.push_back(index);
+            }
+        }
+    }
+    return order;
+}
+
+MemoryIntervalAssignStrategy::MemoryIntervalAssignStrategy(void* data, const BlobMemoryLifetimeMap& lifetimes) {
+    all_blob_memory_data_ = data;
+    lifetimes_            = lifetimes;
+}
+
+int MemoryIntervalAssignStrategy::PlanBlobMemoryOffset(std::set<BlobMemory*>& blob_memory_library,
+                                                       const BlobMemoryLifetimeMap& lifetimes,
+                                                       std::map<BlobMemory*, int>& offsets) {
+    std::vector<IntervalMemoryItem> items;
+    for (auto blob_memory : blob_memory_library) {
+        IntervalMemoryItem item;
+        BlobMemorySizeInfo size_info = blob_memory->GetBlobMemorySizeInfo();
+        item.blob_memory = blob_memory;
+        item.size        = ROUND_UP(GetBlobMemoryBytesSize(size_info), kIntervalMemoryAlignment);
+        auto iter        = lifetimes.find(blob_memory);
+        item.begin       = iter != lifetimes.end() ? iter->second.begin : INT_MIN;
+        item.end         = iter != lifetimes.end() ? iter->second.end : INT_MAX;
+        items.push_back(item);
+    }
+
+    auto items_by_breadth = items;
+    int64_t size_by_size    = PlaceIntervalMemoryItems(items, GreedyBySizeOrder(items));
+    int64_t size_by_breadth = PlaceIntervalMemoryItems(items_by_breadth, GreedyByBreadthOrder(items_by_breadth));
+    if (size_by_breadth < size_by_size) {
+        items.swap(items_by_breadth);
+    }
+
+    offsets.clear();
+    for (auto& item : items) {
+        offsets[item.blob_memory] = (int)item.offset;
+    }
+    return (int)std::min(size_by_size, size_by_breadth);
+}
+
+Status MemoryIntervalAssignStrategy::AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) {
+    std::map<BlobMemory*, int> offsets;
+    PlanBlobMemoryOffset(blob_memory_library, lifetimes_, offsets);
+    for (auto& iter : offsets) {
+        BlobHandle handle;
+        handle.base         = all_blob_memory_data_;
+        handle.bytes_offset = iter.second;
+        iter.first->SetHandleFromExternal(handle);
+    }
+    return TNN_OK;
+}
+
+int MemoryIntervalAssignStrategy::GetAllBlobMemorySize(std::set<BlobMemory*>& blob_memory_library) {
+    std::map<BlobMemory*, int> offsets;
+    return PlanBlobMemoryOffset(blob_memory_library, lifetimes_, offsets);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,53 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_INTERVAL_ASSIGN_STRATEGY_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_INTERVAL_ASSIGN_STRATEGY_H_
+
+#include <map>
+
+#include "tnn/memory_manager/memory_assign_strategy.h"
+
+namespace TNN_NS {
+
+// @brief lifetime of a blob memory in layer index, both ends are included
+struct BlobMemoryLifetime {
+    int begin = 0;
+    int end   = 0;
+};
+
+typedef std::map<BlobMemory*, BlobMemoryLifetime> BlobMemoryLifetimeMap;
+
+// @brief MemoryIntervalAssignStrategy packs blob memories into one arena by offset.
+// Blob memories alive at the same time never overlap, others may share bytes.
+// Offsets are planned by greedy-by-size and greedy-by-breadth, the smaller arena wins.
+class MemoryIntervalAssignStrategy : public MemoryAssignStrategy {
+public:
+    MemoryIntervalAssignStrategy(void* data, const BlobMemoryLifetimeMap& lifetimes);
+    virtual Status AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library);
+    virtual int GetAllBlobMemorySize(std::set<BlobMemory*>& blob_memory_library);
+
+    // @brief plan the bytes offset of every blob memory, return the arena bytes size.
+    // blob memory without lifetime is treated as alive all the time.
+    static int PlanBlobMemoryOffset(std::set<BlobMemory*>& blob_memory_library, const BlobMemoryLifetimeMap& lifetimes,
+                                    std::map<BlobMemory*, int>& offsets);
+
+private:
+    void* all_blob_memory_data_;
+    BlobMemoryLifetimeMap lifetimes_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_INTERVAL_ASSIGN_STRATEGY_H_
@@ -0,0 +1,220 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_convert_int8_layers.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P2 priority: after all fuse, and before insert int8 reformat which has the same priority but sorts later
+    NetOptimizerRegister<NetOptimizerConvertInt8Layers> g_net_optimizer_convert_int8_layers(OptPriority::P2);
+
+    // layers with int8 kernels on the device and no weights
+    static const std::set<LayerType> kInt8Convertible = {LAYER_RELU, LAYER_POOLING, LAYER_UPSAMPLE, LAYER_CONCAT,
+                                                         LAYER_ADD};
+
+    static IntScaleResource *GetBlobScale(NetResource *resource, const std::string &blob) {
+        auto iter = resource->resource_map.find(blob + BLOB_SCALE_SUFFIX);
+        if (iter == resource->resource_map.end()) {
+            return nullptr;
+        }
+        return dynamic_cast<IntScaleResource *>(iter->second.get());
+    }
+
+    static std::shared_ptr<LayerResource> CreateBlobScale(const std::vector<float> &scales,
+                                                          const std::vector<int8_t> &zero_points) {
+        auto scale_res  = std::make_shared<IntScaleResource>();
+        const int count = (int)scales.size();
+
+        RawBuffer scale_handle(count * sizeof(float), {count});
+        memcpy(scale_handle.force_to<float *>(), scales.data(), count * sizeof(float));
+        scale_handle.SetDataType(DATA_TYPE_FLOAT);
+        scale_res->scale_handle = scale_handle;
+
+        RawBuffer zero_point_handle(count * sizeof(int8_t), {count});
+        memcpy(zero_point_handle.force_to<int8_t *>(), zero_points.data(), count * sizeof(int8_t));
+        zero_point_handle.SetDataType(DATA_TYPE_INT8);
+        scale_res->zero_point_handle = zero_point_handle;
+
+        RawBuffer bias_handle(count * sizeof(int32_t), {count});
+        bias_handle.SetDataType(DATA_TYPE_INT32);
+        scale_res->bias_handle = bias_handle;
+        return scale_res;
+    }
+
+    std::string NetOptimizerConvertInt8Layers::Strategy() {
+        return kNetOptimizerConvertInt8Layers;
+    }
+
+    bool NetOptimizerConvertInt8Layers::IsSupported(const NetworkConfig &net_config) {
+        return net_config.device_type == DEVICE_X86;
+    }
+
+    Status NetOptimizerConvertInt8Layers::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        if (structure->layers.size() <= 1 || !GetQuantizedInfoFromNetStructure(structure)) {
+            return TNN_OK;
+        }
+
+        // blob -> layers consuming it
+        std::map<std::string, std::vector<std::shared_ptr<LayerInfo>>> consumers;
+        for (auto &layer : structure->layers) {
+            for (const auto &input : layer->inputs) {
+                consumers[input].push_back(layer);
+            }
+        }
+
+        // blobs produced by int8 layers, including the layers converted below
+        std::set<std::string> int8_blobs;
+        for (auto &layer : structure->layers) {
+            if (!layer->param->quantized) {
+                if (!IsConvertible(layer, structure, resource, int8_blobs)) {
+                    continue;
+                }
+                // converting a layer whose consumers all stay in fp32 only moves the dequant behind it
+                bool feeds_int8 = false;
+                for (const auto &output : layer->outputs) {
+                    for (const auto &next : consumers[output]) {
+                        feeds_int8 |= next->param->quantized || kInt8Convertible.count(next->type) > 0;
+                    }
+                }
+                if (!feeds_int8 || !UpdateOutputScale(layer, resource)) {
+                    continue;
+                }
+                layer->param->quantized = true;
+                LOGD("NetOptimizerConvertInt8Layers: run layer %s in int8\n", layer->name.c_str());
+            }
+            int8_blobs.insert(layer->outputs.begin(), layer->outputs.end());
+        }
+
+        return TNN_OK;
+    }
+
+    bool NetOptimizerConvertInt8Layers::IsConvertible(std::shared_ptr<LayerInfo> &layer, NetStructure *structure,
+                                                      NetResource *resource,
+                                                      const std::set<std::string> &int8_blobs) {
+        if (kInt8Convertible.count(layer->type) == 0 || resource->resource_map.count(layer->name) > 0) {
+            return false;
+        }
+        if (layer->inputs.empty()) {
+            return false;
+        }
+        for (const auto &input : layer->inputs) {
+            if (int8_blobs.count(input) == 0 || !GetBlobScale(resource, input)) {
+                return false;
+            }
+        }
+        // model outputs keep the data type of the original model
+        for (const auto &output : layer->outputs) {
+            if (structure->outputs.count(output) > 0) {
+                return false;
+            }
+        }
+
+        if (layer->type == LAYER_POOLING) {
+            auto param = dynamic_cast<PoolingLayerParam *>(layer->param.get());
+            return param && param->is_adaptive_pool == 0 && (param->pool_type == 0 || param->pool_type == 1);
+        } else if (layer->type == LAYER_UPSAMPLE) {
+            auto param = dynamic_cast<UpsampleLayerParam *>(layer->param.get());
+            return param && (param->mode == 1 || param->mode == 2);
+        } else if (layer->type == LAYER_ADD) {
+            return layer->inputs.size() == 2;
+        }
+        return true;
+    }
+
+    bool NetOptimizerConvertInt8Layers::UpdateOutputScale(std::shared_ptr<LayerInfo> &layer, NetResource *resource) {
+        std::vector<IntScaleResource *> input_scales;
+        for (const auto &input : layer->inputs) {
+            input_scales.push_back(GetBlobScale(resource, input));
+        }
+        const auto input_scale_name  = layer->inputs[0] + BLOB_SCALE_SUFFIX;
+        const auto output_scale_name = layer->outputs[0] + BLOB_SCALE_SUFFIX;
+        const bool has_output_scale  = GetBlobScale(resource, layer->outputs[0]) != nullptr;
+
+        if (layer->type == LAYER_RELU || layer->type == LAYER_POOLING) {
+            // int8 relu and pooling never requantize, the output is in the scale of the input
+            resource->resource_map[output_scale_name] = resource->resource_map[input_scale_name];
+            return true;
+        } else if (layer->type == LAYER_UPSAMPLE) {
+            if (!has_output_scale) {
+                resource->resource_map[output_scale_name] = resource->resource_map[input_scale_name];
+            }
+            return true;
+        } else if (layer->type == LAYER_ADD) {
+            // the int8 add kernel indexes both input scales the same way and needs a calibrated output scale
+            return has_output_scale &&
+                   input_scales[0]->scale_handle.GetDataCount() == input_scales[1]->scale_handle.GetDataCount();
+        } else if (layer->type == LAYER_CONCAT) {
+            auto param      = dynamic_cast<ConcatLayerParam *>(layer->param.get());
+            bool per_tensor = std::all_of(input_scales.begin(), input_scales.end(), [](IntScaleResource *res) {
+                return res->scale_handle.GetDataCount() == 1;
+            });
+            bool per_channel = std::none_of(input_scales.begin(), input_scales.end(), [](IntScaleResource *res) {
+                return res->scale_handle.GetDataCount() == 1;
+            });
+            if (per_tensor) {
+                // per-tensor inputs are requantized to the output scale
+                if (!has_output_scale) {
+                    float max_scale = 0.f;
+                    for (auto res : input_scales) {
+                        max_scale = std::max(max_scale, res->scale_handle.force_to<float *>()[0]);
+                    }
+                    resource->resource_map[output_scale_name] = CreateBlobScale({max_scale}, {0});
+                }
+                return true;
+            } else if (per_channel && param && param->axis == 1) {
+                // per-channel inputs are copied, the output scale is the concat of the input scales
+                std::vector<float> scales;
+                std::vector<int8_t> zero_points;
+                for (auto res : input_scales) {
+                    const int count   = (int)res->scale_handle.GetDataCount();
+                    const float *data = res->scale_handle.force_to<float *>();
+                    scales.insert(scales.end(), data, data + count);
+                    if (res->zero_point_handle.GetDataCount() == count) {
+                        const int8_t *zero_point = res->zero_point_handle.force_to<int8_t *>();
+                        zero_points.insert(zero_points.end(), zero_point, zero_point + count);
+                    } else {
+                        zero_points.insert(zero_points.end(), count, 0);
+                    }
+                }
+                resource->resource_map[output_scale_name] = CreateBlobScale(scales, zero_points);
+                return true;
+            }
+        }
+        return false;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
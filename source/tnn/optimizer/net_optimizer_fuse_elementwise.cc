@@ -0,0 +1,269 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/optimizer/net_optimizer_fuse_elementwise.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P2 priority: runs after the pattern fusions of P1, which match some of the same layers
+    NetOptimizerRegister<NetOptimizerFuseElementwise> g_net_optimizer_fuse_elementwise(OptPriority::P2);
+
+    std::string NetOptimizerFuseElementwise::Strategy() {
+        return kNetOptimizerFuseElementwise;
+    }
+
+    bool NetOptimizerFuseElementwise::IsSupported(const NetworkConfig &net_config) {
+        // the elementwise layers run on the blocked layout themselves, a fused layer would add reformats
+        return net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO &&
+               net_config.data_format != DATA_FORMAT_NC8HW8;
+    }
+
+    // a layer of the chain applied to the running value
+    struct ChainStep {
+        FusedElementwiseStep step;
+        // blob of the other operand of binary layers
+        std::string operand;
+        // operand kept in the layer resource, it becomes a constant blob if the chain is fused
+        std::shared_ptr<RawBuffer> constant = nullptr;
+        std::string layer_name;
+    };
+
+    static bool IsFusedActivation(LayerType type) {
+        return type == LAYER_RELU || type == LAYER_RELU6 || type == LAYER_CLIP || type == LAYER_SIGMOID ||
+               type == LAYER_SWISH || type == LAYER_HARDSIGMOID || type == LAYER_TANH || type == LAYER_ABS ||
+               type == LAYER_NEG || type == LAYER_EXP;
+    }
+
+    static bool IsFusedBinary(LayerType type) {
+        return type == LAYER_ADD || type == LAYER_SUB || type == LAYER_MUL || type == LAYER_DIV ||
+               type == LAYER_MAXIMUM || type == LAYER_MINIMUM;
+    }
+
+    // constant operand of a single input binary layer as float, nullptr if its shape is resolved at reshape
+    static std::shared_ptr<RawBuffer> GetConstantOperand(NetResource *resource, const std::string &layer_name) {
+        auto iter = resource->resource_map.find(layer_name);
+        if (iter == resource->resource_map.end()) {
+            return nullptr;
+        }
+        auto layer_resource = std::dynamic_pointer_cast<EltwiseLayerResource>(iter->second);
+        if (!layer_resource || layer_resource->element_handle.GetDataCount() <= 0) {
+            return nullptr;
+        }
+
+        auto buffer = std::make_shared<RawBuffer>();
+        if (layer_resource->element_handle.GetDataType() == DATA_TYPE_HALF) {
+            *buffer = ConvertHalfHandle(layer_resource->element_handle);
+        } else if (layer_resource->element_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            *buffer = layer_resource->element_handle;
+        } else {
+            return nullptr;
+        }
+        if (buffer->GetBufferDims().empty()) {
+            if (buffer->GetDataCount() != 1) {
+                return nullptr;
+            }
+            buffer->SetBufferDims({1});
+        }
+        return buffer;
+    }
+
+    // the step of layer applied to the running value in blob value, false if layer can not join a chain
+    static bool GetChainStep(std::shared_ptr<LayerInfo> layer, const std::string &value, NetResource *resource,
+                             ChainStep &chain_step) {
+        auto param = layer->param;
+        if (!param || param->quantized || param->dynamic_range_quantized || layer->outputs.size() != 1 ||
+            resource->constant_layers.count(layer->name) > 0) {
+            return false;
+        }
+
+        auto &step      = chain_step.step;
+        step.type       = layer->type;
+        chain_step.layer_name = layer->name;
+        const auto &inputs    = layer->inputs;
+        if (IsFusedActivation(layer->type)) {
+            if (inputs.size() != 1 || inputs[0] != value) {
+                return false;
+            }
+            if (layer->type == LAYER_CLIP) {
+                auto clip_param = std::dynamic_pointer_cast<ClipLayerParam>(param);
+                if (!clip_param) {
+                    return false;
+                }
+                step.alpha = clip_param->min;
+                step.beta  = clip_param->max;
+            } else if (layer->type == LAYER_HARDSIGMOID) {
+                auto hard_sigmoid_param = std::dynamic_pointer_cast<HardSigmoidLayerParam>(param);
+                if (!hard_sigmoid_param) {
+                    return false;
+                }
+                step.alpha = hard_sigmoid_param->alpha;
+                step.beta  = hard_sigmoid_param->beta;
+            }
+            return true;
+        }
+
+        auto binary_param = std::dynamic_pointer_cast<MultidirBroadcastLayerParam>(param);
+        if (!IsFusedBinary(layer->type) || !binary_param) {
+            return false;
+        }
+        if (inputs.size() == 2) {
+            // x * x keeps the value as operand, only the first layer of a chain can see it twice
+            if (inputs[0] == value) {
+                chain_step.operand = inputs[1];
+            } else if (inputs[1] == value) {
+                chain_step.operand = inputs[0];
+                step.operand_first = true;
+            } else {
+                return false;
+            }
+            return true;
+        }
+        if (inputs.size() == 1 && inputs[0] == value) {
+            chain_step.constant = GetConstantOperand(resource, layer->name);
+            step.operand_first  = binary_param->weight_input_index == 0;
+            return chain_step.constant != nullptr;
+        }
+        return false;
+    }
+
+    Status NetOptimizerFuseElementwise::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        const int count                                     = (const int)layers_orig.size();
+        if (count <= 1) {
+            return TNN_OK;
+        }
+
+        // a blob inside a chain is read by the next layer of the chain only, net outputs count as a reader
+        std::map<std::string, int> reader_count;
+        std::map<std::string, int> reader_index;
+        for (int index = 0; index < count; index++) {
+            for (const auto &input : layers_orig[index]->inputs) {
+                reader_count[input]++;
+                reader_index[input] = index;
+            }
+        }
+        for (const auto &output : structure->outputs) {
+            reader_count[output]++;
+        }
+
+        std::vector<bool> removed(count, false);
+        std::vector<std::shared_ptr<LayerInfo>> fused_at(count, nullptr);
+        for (int index = 0; index < count; index++) {
+            auto layer = layers_orig[index];
+            if (removed[index] || layer->inputs.empty()) {
+                continue;
+            }
+
+            std::vector<ChainStep> steps(1);
+            if (!GetChainStep(layer, layer->inputs[0], resource, steps[0])) {
+                continue;
+            }
+            std::vector<int> chain = {index};
+            std::string value      = layer->outputs[0];
+            while (reader_count[value] == 1 && reader_index.count(value) > 0) {
+                const int next = reader_index[value];
+                ChainStep chain_step;
+                if (next <= chain.back() || removed[next] ||
+                    !GetChainStep(layers_orig[next], value, resource, chain_step)) {
+                    break;
+                }
+                steps.push_back(chain_step);
+                chain.push_back(next);
+                value = layers_orig[next]->outputs[0];
+            }
+            if (chain.size() < 2) {
+                continue;
+            }
+
+            bool name_conflict = false;
+            for (const auto &chain_step : steps) {
+                if (chain_step.constant &&
+                    resource->constant_map.count(chain_step.layer_name + "_fused_operand") > 0) {
+                    name_conflict = true;
+                }
+            }
+            if (name_conflict) {
+                continue;
+            }
+
+            // the fused layer takes the place of the last layer of the chain, where all operands are ready
+            auto last                = layers_orig[chain.back()];
+            auto fused_param         = std::make_shared<FusedElementwiseLayerParam>();
+            fused_param->type        = "FusedElementwise";
+            fused_param->name        = last->name;
+            auto fused_layer         = std::make_shared<LayerInfo>();
+            fused_layer->type        = LAYER_FUSED_ELEMENTWISE;
+            fused_layer->type_str    = "FusedElementwise";
+            fused_layer->name        = last->name;
+            fused_layer->inputs      = {layer->inputs[0]};
+            fused_layer->outputs     = last->outputs;
+            fused_layer->param       = fused_param;
+            for (auto &chain_step : steps) {
+                std::string operand = chain_step.operand;
+                if (chain_step.constant) {
+                    operand                          = chain_step.layer_name + "_fused_operand";
+                    resource->constant_map[operand] = chain_step.constant;
+                    structure->blobs.insert(operand);
+                }
+                if (!operand.empty()) {
+                    auto iter = std::find(fused_layer->inputs.begin(), fused_layer->inputs.end(), operand);
+                    chain_step.step.operand = (int)(iter - fused_layer->inputs.begin());
+                    if (iter == fused_layer->inputs.end()) {
+                        fused_layer->inputs.push_back(operand);
+                    }
+                }
+                fused_param->steps.push_back(chain_step.step);
+            }
+
+            for (auto chain_index : chain) {
+                removed[chain_index] = true;
+            }
+            fused_at[chain.back()] = fused_layer;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (int index = 0; index < count; index++) {
+            if (fused_at[index]) {
+                layers_fused.push_back(fused_at[index]);
+            } else if (!removed[index]) {
+                layers_fused.push_back(layers_orig[index]);
+            }
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
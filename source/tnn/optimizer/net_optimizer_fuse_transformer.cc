@@ -0,0 +1,472 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/optimizer/net_optimizer_fuse_transformer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/graph_matcher/graph_matcher.h"
+#include "tnn/optimizer/graph_matcher/graph_parser.h"
+#include "tnn/optimizer/graph_matcher/ir.h"
+#include "tnn/optimizer/graph_matcher/logger.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    NetOptimizerRegister<NetOptimizerFuseTransformer> g_net_optimizer_fuse_transformer(OptPriority::P1);
+
+    std::string NetOptimizerFuseTransformer::Strategy() {
+        return kNetOptimizerFuseTransformer;
+    }
+
+    bool NetOptimizerFuseTransformer::IsSupported(const NetworkConfig &net_config) {
+        return net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO;
+    }
+
+    // constant operand of a binary layer whose other input is a blob, converted to float
+    static std::shared_ptr<RawBuffer> GetElementOperand(NetResource *resource, std::shared_ptr<Node> node) {
+        auto param = std::dynamic_pointer_cast<MultidirBroadcastLayerParam>(node->info->param);
+        if (!param || node->info->inputs.size() != 1) {
+            return nullptr;
+        }
+        auto iter = resource->resource_map.find(node->info->name);
+        if (iter == resource->resource_map.end()) {
+            return nullptr;
+        }
+        auto layer_resource = std::dynamic_pointer_cast<EltwiseLayerResource>(iter->second);
+        if (!layer_resource || layer_resource->element_handle.GetDataCount() <= 0) {
+            return nullptr;
+        }
+
+        auto buffer = std::make_shared<RawBuffer>();
+        if (layer_resource->element_handle.GetDataType() == DATA_TYPE_HALF) {
+            *buffer = ConvertHalfHandle(layer_resource->element_handle);
+        } else if (layer_resource->element_handle.GetDataType() == DATA_TYPE_FLOAT) {
+            *buffer = layer_resource->element_handle;
+        } else {
+            return nullptr;
+        }
+        // without buffer dims the layer resolves the operand shape against its input at reshape, only
+        // scalars are unambiguous then
+        if (buffer->GetBufferDims().empty()) {
+            if (buffer->GetDataCount() != 1) {
+                return nullptr;
+            }
+            buffer->SetBufferDims({1});
+        }
+        return buffer;
+    }
+
+    static bool GetScalarOperand(NetResource *resource, std::shared_ptr<Node> node, float &value) {
+        auto buffer = GetElementOperand(resource, node);
+        if (!buffer || buffer->GetDataCount() != 1) {
+            return false;
+        }
+        value = buffer->force_to<float *>()[0];
+        return true;
+    }
+
+    static bool IsNear(float value, float expected) {
+        return std::fabs(value - expected) <= 1e-4f * std::max(1.0f, std::fabs(expected));
+    }
+
+    // number of reduced axes if they are the trailing axes {-n, ..., -1}, 0 otherwise
+    static int TrailingReduceDims(std::vector<int> axes) {
+        std::sort(axes.begin(), axes.end());
+        const int count = (int)axes.size();
+        for (int i = 0; i < count; i++) {
+            if (axes[i] != i - count) {
+                return 0;
+            }
+        }
+        return count;
+    }
+
+    static std::shared_ptr<Graph> ParsePattern(GraphParser &graph_parser, const std::string &graph_str) {
+        if (!graph_parser.parseFromString(graph_str)) {
+            return nullptr;
+        }
+        return graph_parser.getGraph();
+    }
+
+    Status NetOptimizerFuseTransformer::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        // building the graph is not free, skip the models without any of the decomposed subgraphs
+        bool has_candidate = false;
+        for (auto layer : structure->layers) {
+            if (layer->type == LAYER_REDUCE_MEAN || layer->type == LAYER_ERF || layer->type == LAYER_SOFTMAX) {
+                has_candidate = true;
+                break;
+            }
+        }
+        if (!has_candidate) {
+            return TNN_OK;
+        }
+
+        std::shared_ptr<Graph> graph = std::make_shared<Graph>();
+        auto status = graph->fromInterpreted(structure, resource);
+        if (status != TNN_OK) {
+            LOGE("%s", status.description().c_str());
+            return TNN_OK;
+        }
+
+        RETURN_ON_FAIL(FuseLayerNorm(graph, resource));
+        RETURN_ON_FAIL(FuseGELU(graph, resource));
+        RETURN_ON_FAIL(FuseAttention(graph, resource));
+
+        return TNN_OK;
+    }
+
+    /*
+     * graph(%x):
+     *      %mean = ReduceMean(%x)
+     *      %sub  = Sub(%x, %mean)
+     *      %pow  = Power(%sub)             or Mul(%sub, %sub)
+     *      %var  = ReduceMean(%pow)
+     *      %add  = Add(%var)               + eps
+     *      %std  = Sqrt(%add)
+     *      %div  = Div(%sub, %std)
+     *      %mul  = Mul(%div)               * gamma
+     *      %out  = Add(%mul)               + beta
+     *      return (%out)
+     * is replaced by LayerNorm(%x, gamma, beta)
+     */
+    Status NetOptimizerFuseTransformer::FuseLayerNorm(std::shared_ptr<Graph> graph, NetResource *resource) {
+        const std::vector<std::string> square_ops = {"%pow = Power(%sub)", "%pow = Mul(%sub, %sub)"};
+        for (const auto &square_op : square_ops) {
+            std::string graph_str = "graph(%x):\n"
+                                    "    %mean = ReduceMean(%x)\n"
+                                    "    %sub = Sub(%x, %mean)\n"
+                                    "    " + square_op + "\n"
+                                    "    %var = ReduceMean(%pow)\n"
+                                    "    %add = Add(%var)\n"
+                                    "    %std = Sqrt(%add)\n"
+                                    "    %div = Div(%sub, %std)\n"
+                                    "    %mul = Mul(%div)\n"
+                                    "    %out = Add(%mul)\n"
+                                    "    return (%out)\n";
+
+            GraphRegistry registry;
+            GraphParser graph_parser(&registry);
+            auto pattern = ParsePattern(graph_parser, graph_str);
+            if (!pattern) {
+                return Status(TNNERR_PARAM_ERR, "invalid pattern syntax.");
+            }
+
+            auto gen = [&](std::shared_ptr<AnchorGraph> in) -> std::shared_ptr<Graph> {
+                if (in->inputs().size() != 1 || in->outputs().size() != 1) {
+                    return nullptr;
+                }
+
+                auto mean_node = in->getNodeByTensorName(std::string("@mean"));
+                auto pow_node  = in->getNodeByTensorName(std::string("@pow"));
+                auto var_node  = in->getNodeByTensorName(std::string("@var"));
+                auto eps_node  = in->getNodeByTensorName(std::string("@add"));
+                                auto mul_node  = in->getNodeByTensorName(std::string("@mul"));
+                auto out_node  = in->getNodeByTensorName(std::string("@out"));
+                if (!mean_node || !pow_node || !var_node || !eps_node || !mul_node || !out_node) {
+                    WARN("node of interest not found in fuse layer norm optimizer");
+                    return nullptr;
+                }
+
+                auto mean_param = std::dynamic_pointer_cast<ReduceLayerParam>(mean_node->info->param);
+                auto var_param  = std::dynamic_pointer_cast<ReduceLayerParam>(var_node->info->param);
+                if (!mean_param || !var_param || mean_param->axis != var_param->axis || !mean_param->keep_dims ||
+                    !var_param->keep_dims || mean_param->all_reduce || var_param->all_reduce) {
+                    return nullptr;
+                }
+                const int reduce_dims_size = TrailingReduceDims(mean_param->axis);
+                if (reduce_dims_size <= 0) {
+                    return nullptr;
+                }
+
+                if (pow_node->info->type == LAYER_POWER) {
+                    auto pow_param = std::dynamic_pointer_cast<PowLayerParam>(pow_node->info->param);
+                    if (!pow_param || pow_param->exponent != 2.0f || pow_param->scale != 1.0f ||
+                        pow_param->shift != 0.0f) {
+                        return nullptr;
+                    }
+                }
+
+                float eps = 0.0f;
+                if (!GetScalarOperand(resource, eps_node, eps)) {
+                    return nullptr;
+                }
+
+                auto gamma = GetElementOperand(resource, mul_node);
+                auto beta  = GetElementOperand(resource, out_node);
+                if (!gamma || !beta) {
+                    return nullptr;
+                }
+                // LayerNorm reads scale and bias with the full count of the normalized axes
+                auto gamma_dims = gamma->GetBufferDims();
+                auto beta_dims  = beta->GetBufferDims();
+                while (!gamma_dims.empty() && gamma_dims.front() == 1) {
+                    gamma_dims.erase(gamma_dims.begin());
+                }
+                while (!beta_dims.empty() && beta_dims.front() == 1) {
+                    beta_dims.erase(beta_dims.begin());
+                }
+                if (gamma_dims != beta_dims || gamma_dims.size() != reduce_dims_size ||
+                    std::find(gamma_dims.begin(), gamma_dims.end(), 1) != gamma_dims.end()) {
+                    return nullptr;
+                }
+                gamma->SetBufferDims(gamma_dims);
+                beta->SetBufferDims(beta_dims);
+
+                INFO("found layer norm pattern at Node:%s", out_node->name().c_str());
+
+                const std::string name_prefix = out_node->info->name + "_";
+                const std::string in_name     = "input";
+                const std::string scale_name  = name_prefix + "layer_norm_scale";
+                const std::string bias_name   = name_prefix + "layer_norm_bias";
+
+                auto g = std::make_shared<Graph>();
+                g->getNodeOrCreatePlaceHolder(in_name);
+                RETURN_VALUE_ON_NEQ(g->createConst(scale_name, gamma), TNN_OK, nullptr);
+                RETURN_VALUE_ON_NEQ(g->createConst(bias_name, beta), TNN_OK, nullptr);
+
+                CREATE_NODE(layer_norm_node, g, LAYER_LAYER_NORM, NAMES({in_name, scale_name, bias_name}),
+                            {name_prefix + "layer_norm"});
+                RETURN_VALUE_ON_NEQ(layer_norm_node->createParam<LayerNormLayerParam>(), TNN_OK, nullptr);
+                layer_norm_node->param<LayerNormLayerParam>()->reduce_dims_size = reduce_dims_size;
+                layer_norm_node->param<LayerNormLayerParam>()->eps              = eps;
+
+                return g;
+            };
+
+            RETURN_ON_FAIL(graph->rewrite(pattern, gen));
+        }
+
+        return TNN_OK;
+    }
+
+    /*
+     * graph(%x):
+     *      %scale = Div(%x)                / sqrt(2), or Mul(%x) * 1 / sqrt(2)
+     *      %erf   = Erf(%scale)
+     *      %shift = Add(%erf)              + 1
+     *      %mul   = Mul(%x, %shift)
+     *      %half  = Mul(%mul)              * 0.5
+     *      return (%half)
+     * or the 0.5 applied to %x first, is replaced by GELU(%x)
+     */
+    Status NetOptimizerFuseTransformer::FuseGELU(std::shared_ptr<Graph> graph, NetResource *resource) {
+        std::vector<std::string> tails = {
+            "    %mul = Mul(%x, %shift)\n    %half = Mul(%mul)\n    return (%half)\n",
+            "    %mul = Mul(%shift, %x)\n    %half = Mul(%mul)\n    return (%half)\n",
+            "    %half = Mul(%x)\n    %out = Mul(%half, %shift)\n    return (%out)\n",
+            "    %half = Mul(%x)\n    %out = Mul(%shift, %half)\n    return (%out)\n",
+        };
+        std::vector<std::string> graph_strs;
+        for (const std::string scale_type : {"Div", "Mul"}) {
+            for (const auto &tail : tails) {
+                graph_strs.push_back("graph(%x):\n"
+                                     "    %scale = " + scale_type + "(%x)\n"
+                                     "    %erf = Erf(%scale)\n"
+                                     "    %shift = Add(%erf)\n" + tail);
+            }
+        }
+
+        for (const auto &graph_str : graph_strs) {
+            GraphRegistry registry;
+            GraphParser graph_parser(&registry);
+            auto pattern = ParsePattern(graph_parser, graph_str);
+            if (!pattern) {
+                return Status(TNNERR_PARAM_ERR, "invalid pattern syntax.");
+            }
+
+            auto gen = [&](std::shared_ptr<AnchorGraph> in) -> std::shared_ptr<Graph> {
+                if (in->inputs().size() != 1 || in->outputs().size() != 1) {
+                    return nullptr;
+                }
+
+                auto scale_node = in->getNodeByTensorName(std::string("@scale"));
+                auto shift_node = in->getNodeByTensorName(std::string("@shift"));
+                auto half_node  = in->getNodeByTensorName(std::string("@half"));
+                if (!scale_node || !shift_node || !half_node) {
+                    WARN("node of interest not found in fuse gelu optimizer");
+                    return nullptr;
+                }
+
+                float scale = 0.0f, shift = 0.0f, half = 0.0f;
+                if (!GetScalarOperand(resource, scale_node, scale) || !GetScalarOperand(resource, shift_node, shift) ||
+                    !GetScalarOperand(resource, half_node, half)) {
+                    return nullptr;
+                }
+                if (scale_node->info->type == LAYER_DIV) {
+                    auto div_param = std::dynamic_pointer_cast<MultidirBroadcastLayerParam>(scale_node->info->param);
+                    if (div_param->weight_input_index != 1 || !IsNear(scale, (float)std::sqrt(2.0))) {
+                        return nullptr;
+                    }
+                } else if (!IsNear(scale, (float)(1.0 / std::sqrt(2.0)))) {
+                    return nullptr;
+                }
+                if (!IsNear(shift, 1.0f) || !IsNear(half, 0.5f)) {
+                    return nullptr;
+                }
+
+                auto out_node = in->getNodeByTensorName(in->outputs()[0]->name);
+                if (!out_node) {
+                    return nullptr;
+                }
+                INFO("found gelu pattern at Node:%s", out_node->name().c_str());
+
+                const std::string in_name = "input";
+                auto g                    = std::make_shared<Graph>();
+                g->getNodeOrCreatePlaceHolder(in_name);
+                CREATE_NODE(gelu_node, g, LAYER_GELU, {in_name}, {out_node->info->name + "_gelu"});
+                RETURN_VALUE_ON_NEQ(gelu_node->createParam<LayerParam>(), TNN_OK, nullptr);
+
+                return g;
+            };
+
+            RETURN_ON_FAIL(graph->rewrite(pattern, gen));
+        }
+
+        return TNN_OK;
+    }
+
+    /*
+     * graph(%q, %k, %v, %mask):
+     *      %scores = MatMul(%q, %k)
+     *      %scaled = Div(%scores)          / c, or Mul(%scores) * c, or no scale
+     *      %masked = Add(%scaled, %mask)   or no mask
+     *      %probs  = Softmax(%masked)
+     *      %out    = MatMul(%probs, %v)
+     *      return (%out)
+     * is replaced by MultiHeadAttention(%q, %k, %v, %mask), the q, k, v projections and the head
+     * transposes around the core are left as they are.
+     */
+    Status NetOptimizerFuseTransformer::FuseAttention(std::shared_ptr<Graph> graph, NetResource *resource) {
+        const std::vector<std::string> scale_types = {"Div", "Mul", ""};
+        // 0: no mask, 1: mask added to the right, 2: mask added to the left
+        const std::vector<int> mask_types = {1, 2, 0};
+        for (const auto &scale_type : scale_types) {
+            for (const int mask_type : mask_types) {
+                const bool has_scale = !scale_type.empty();
+                const bool has_mask  = mask_type != 0;
+
+                std::string graph_str = has_mask ? "graph(%q, %k, %v, %mask):\n" : "graph(%q, %k, %v):\n";
+                graph_str += "    %scores = MatMul(%q, %k)\n";
+                std::string softmax_in = "%scores";
+                if (has_scale) {
+                    graph_str += "    %scaled = " + scale_type + "(%scores)\n";
+                    softmax_in = "%scaled";
+                }
+                if (has_mask) {
+                    graph_str += mask_type == 1 ? "    %masked = Add(" + softmax_in + ", %mask)\n"
+                                                : "    %masked = Add(%mask, " + softmax_in + ")\n";
+                    softmax_in = "%masked";
+                }
+                graph_str += "    %probs = Softmax(" + softmax_in + ")\n"
+                             "    %out = MatMul(%probs, %v)\n"
+                             "    return (%out)\n";
+
+                GraphRegistry registry;
+                GraphParser graph_parser(&registry);
+                auto pattern = ParsePattern(graph_parser, graph_str);
+                if (!pattern) {
+                    return Status(TNNERR_PARAM_ERR, "invalid pattern syntax.");
+                }
+
+                auto gen = [&](std::shared_ptr<AnchorGraph> in) -> std::shared_ptr<Graph> {
+                    if (in->inputs().size() != (has_mask ? 4 : 3) || in->outputs().size() != 1) {
+                        return nullptr;
+                    }
+
+                    auto scores_node = in->getNodeByTensorName(std::string("@scores"));
+                    auto probs_node  = in->getNodeByTensorName(std::string("@probs"));
+                    auto out_node    = in->getNodeByTensorName(std::string("@out"));
+                    if (!scores_node || !probs_node || !out_node) {
+                        WARN("node of interest not found in fuse attention optimizer");
+                        return nullptr;
+                    }
+
+                    auto scores_param = std::dynamic_pointer_cast<MatMulLayerParam>(scores_node->info->param);
+                    auto out_param    = std::dynamic_pointer_cast<MatMulLayerParam>(out_node->info->param);
+                    if (!scores_param || !out_param || scores_param->weight_position != -1 ||
+                        out_param->weight_position != -1) {
+                        return nullptr;
+                    }
+
+                    float scale = 1.0f;
+                    if (has_scale) {
+                        auto scale_node = in->getNodeByTensorName(std::string("@scaled"));
+                        float value     = 0.0f;
+                        if (!scale_node || !GetScalarOperand(resource, scale_node, value)) {
+                            return nullptr;
+                        }
+                        if (scale_node->info->type == LAYER_DIV) {
+                            auto div_param =
+                                std::dynamic_pointer_cast<MultidirBroadcastLayerParam>(scale_node->info->param);
+                            if (div_param->weight_input_index != 1 || value == 0.0f) {
+                                return nullptr;
+                            }
+                            scale = 1.0f / value;
+                        } else {
+                            scale = value;
+                        }
+                    }
+
+                    auto softmax_param = std::dynamic_pointer_cast<SoftmaxLayerParam>(probs_node->info->param);
+                    if (!softmax_param || softmax_param->axis < -1) {
+                        return nullptr;
+                    }
+
+                    INFO("found attention pattern at Node:%s", out_node->name().c_str());
+
+                    auto g = std::make_shared<Graph>();
+                    std::vector<std::string> in_names = {"q", "k", "v"};
+                    if (has_mask) {
+                        in_names.push_back("mask");
+                    }
+                    for (const auto &name : in_names) {
+                        g->getNodeOrCreatePlaceHolder(name);
+                    }
+                    CREATE_NODE(attention_node, g, LAYER_MULTI_HEAD_ATTENTION, in_names,
+                                {out_node->info->name + "_attention"});
+                    RETURN_VALUE_ON_NEQ(attention_node->createParam<MultiHeadAttentionLayerParam>(), TNN_OK,
+                                        nullptr);
+                    attention_node->param<MultiHeadAttentionLayerParam>()->scale        = scale;
+                    attention_node->param<MultiHeadAttentionLayerParam>()->softmax_axis = softmax_param->axis;
+
+                    return g;
+                };
+
+                RETURN_ON_FAIL(graph->rewrite(pattern, gen));
+            }
+        }
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -58,6 +58,10 @@ namespace optimizer {
         }
         adaptor_device_ = GetDevice(adaptor_device);
 
+        // x86 runs on nchw unless the blocked nc8hw8 layout is asked for
+        if (device == DEVICE_X86) {
+            return net_config.data_format == DATA_FORMAT_NC8HW8;
+        }
         return device == DEVICE_ARM || device == DEVICE_OPENCL || device == DEVICE_METAL;
     }
 
@@ -54,4 +54,10 @@ const char * kNetOptimizerDynamicRangeDequant =
 const char * kNetOptimizerConvertMatMulToConv =
     "net_optimizer_convert_matmul_to_conv";
 
+const char * kNetOptimizerFuseTransformer =
+    "net_optimizer_fuse_transformer";
+
+const char * kNetOptimizerFuseElementwise =
+    "net_optimizer_fuse_elementwise";
+
 }  // namespace TNN_NS
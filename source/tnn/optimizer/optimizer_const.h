@@ -45,6 +45,10 @@ extern const char * kNetOptimizerDynamicRangeDequant;
 
 extern const char * kNetOptimizerConvertMatMulToConv;
 
+extern const char * kNetOptimizerFuseTransformer;
+
+extern const char * kNetOptimizerFuseElementwise;
+
 }
 
 #endif // TNN_SOURCE_TNN_OPTIMIZER_OPTIMIZER_CONST_H_
@@ -18,6 +18,7 @@
 
 #include "tnn/utils/blob_converter_internal.h"
 #include "tnn/utils/dims_function_utils.h"
+#include "tnn/utils/mat_utils.h"
 
 namespace TNN_NS {
 
@@ -93,6 +94,69 @@ Status BlobConverter::ConvertFromMatAsync(Mat& image, MatConvertParam param, voi
     return impl_->ConvertFromMatAsync(image, param, command_queue);
 }
 
+Status BlobConverter::ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                                   void* command_queue) {
+    if (!impl_) {
+        return Status(TNNERR_INIT_LAYER, "image converter is nil, check device type");
+    }
+
+    Status ret = CheckScaleBiasInParam(image, param, false);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    auto& crop = preprocess.crop;
+    if (crop.width <= 0 || crop.height <= 0) {
+        crop.top_left_x = 0;
+        crop.top_left_y = 0;
+        crop.width      = image.GetWidth();
+        crop.height     = image.GetHeight();
+    }
+    RETURN_ON_NEQ(CheckCropParam(image, crop), TNN_OK);
+
+    return impl_->ConvertFromMatWithPreprocess(image, preprocess, param, command_queue);
+}
+
+Status BlobConverter::ConvertFromMatWithBoxes(Mat& image, std::vector<CropParam> boxes, InterpType interp_type,
+                                              MatConvertParam param, void* command_queue) {
+    if (!impl_) {
+        return Status(TNNERR_INIT_LAYER, "image converter is nil, check device type");
+    }
+
+    Status ret = CheckScaleBiasInParam(image, param, false);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    const int box_count = (int)boxes.size();
+    if (box_count == 0 || DimsFunctionUtils::GetDim(blob_->GetBlobDesc().dims, 0) != box_count) {
+        return Status(TNNERR_PARAM_ERR, "blob batch must equal the box count");
+    }
+    if (image.GetBatch() != 1 && image.GetBatch() != box_count) {
+        return Status(TNNERR_PARAM_ERR, "image batch must be 1 or equal to the box count");
+    }
+    for (auto& box : boxes) {
+        if (box.width <= 0 || box.height <= 0) {
+            return Status(TNNERR_PARAM_ERR, "box is empty");
+        }
+        RETURN_ON_NEQ(CheckCropParam(image, box), TNN_OK);
+    }
+
+    return impl_->ConvertFromMatWithBoxes(image, boxes, interp_type, param, command_queue);
+}
+
+Status BlobConverter::CheckCropParam(Mat& image, const CropParam& crop) {
+    if (crop.top_left_x < 0 || crop.top_left_y < 0 || crop.top_left_x + crop.width > image.GetWidth() ||
+        crop.top_left_y + crop.height > image.GetHeight()) {
+        return Status(TNNERR_PARAM_ERR, "crop region is out of the image");
+    }
+    if ((image.GetMatType() == NNV12 || image.GetMatType() == NNV21) &&
+        (crop.top_left_x % 2 || crop.top_left_y % 2 || crop.width % 2 || crop.height % 2)) {
+        return Status(TNNERR_PARAM_ERR, "corp param can not be odd");
+    }
+    return TNN_OK;
+}
+
 Status BlobConverter::CheckScaleBiasInParam(Mat& image, MatConvertParam& param, bool convert_to_mat) {
     int channel = 0;
     if (convert_to_mat) {
@@ -119,6 +183,55 @@ Status BlobConverter::CheckScaleBiasInParam(Mat& image, MatConvertParam& param,
     return TNN_OK;
 }
 
+Status BlobConverterAcc::ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess,
+                                                      MatConvertParam param, void* command_queue) {
+    CHECK_PARAM_NULL(blob_);
+    auto dims        = blob_->GetBlobDesc().dims;
+    const int height = DimsFunctionUtils::GetDim(dims, 2);
+    const int width  = DimsFunctionUtils::GetDim(dims, 3);
+    auto device_type = image.GetDeviceType();
+
+    Mat src = image;
+    if (src.GetMatType() == NNV12 || src.GetMatType() == NNV21) {
+        Mat bgr(device_type, N8UC3, src.GetDims());
+        auto cvt_type = src.GetMatType() == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+        RETURN_ON_NEQ(MatUtils::CvtColor(src, bgr, cvt_type, command_queue), TNN_OK);
+        src = bgr;
+    }
+
+    auto& crop = preprocess.crop;
+    if (crop.width != src.GetWidth() || crop.height != src.GetHeight()) {
+        Mat cropped(device_type, src.GetMatType(), {src.GetBatch(), src.GetChannel(), crop.height, crop.width});
+        RETURN_ON_NEQ(MatUtils::Crop(src, cropped, crop, command_queue), TNN_OK);
+        src = cropped;
+    }
+
+    if (width != src.GetWidth() || height != src.GetHeight()) {
+        Mat resized(device_type, src.GetMatType(), {src.GetBatch(), src.GetChannel(), height, width});
+        ResizeParam resize_param;
+        resize_param.type = preprocess.interp_type;
+        RETURN_ON_NEQ(MatUtils::Resize(src, resized, resize_param, command_queue), TNN_OK);
+        src = resized;
+    }
+
+    return ConvertFromMat(src, param, command_queue);
+}
+
+Status BlobConverterAcc::ConvertFromMatWithBoxes(Mat& image, const std::vector<CropParam>& boxes,
+                                                 InterpType interp_type, MatConvertParam param, void* command_queue) {
+    CHECK_PARAM_NULL(blob_);
+    auto dims        = blob_->GetBlobDesc().dims;
+    const int height = DimsFunctionUtils::GetDim(dims, 2);
+    const int width  = DimsFunctionUtils::GetDim(dims, 3);
+    bool is_yuv      = image.GetMatType() == NNV12 || image.GetMatType() == NNV21;
+    MatType mat_type = is_yuv ? N8UC3 : image.GetMatType();
+    int channel      = is_yuv ? 3 : image.GetChannel();
+
+    Mat resized(image.GetDeviceType(), mat_type, {(int)boxes.size(), channel, height, width});
+    RETURN_ON_NEQ(MatUtils::CropAndResize(image, resized, boxes, interp_type, command_queue), TNN_OK);
+    return ConvertFromMat(resized, param, command_queue);
+}
+
 std::shared_ptr<BlobConverterManager>& BlobConverterManager::Shared() {
     static std::once_flag once;
     static std::shared_ptr<BlobConverterManager> g_global_blob_converter_manager;
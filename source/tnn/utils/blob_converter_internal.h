@@ -34,6 +34,14 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL)      = 0;
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL) = 0;
 
+    // default implementation runs MatUtils CvtColor, Crop and Resize, then ConvertFromMat
+    virtual Status ConvertFromMatWithPreprocess(Mat& image, MatPreprocessParam preprocess, MatConvertParam param,
+                                                void* command_queue = NULL);
+
+    // default implementation runs MatUtils CropAndResize, then ConvertFromMat
+    virtual Status ConvertFromMatWithBoxes(Mat& image, const std::vector<CropParam>& boxes, InterpType interp_type,
+                                           MatConvertParam param, void* command_queue = NULL);
+
 protected:
     Blob* blob_;
 };
@@ -0,0 +1,160 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/mapped_file.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TNN_NS {
+
+MappedFile::MappedFile() {}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#if defined(_WIN32)
+
+Status MappedFile::Open(const std::string &path) {
+    Close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOGE("MappedFile open %s failed\n", path.c_str());
+        return Status(TNNERR_OPEN_FILE, "model file cannot be opened");
+    }
+    file_handle_ = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        Close();
+        return Status(TNNERR_OPEN_FILE, "get model file size failed");
+    }
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    if (size_ == 0) {
+        return TNN_OK;
+    }
+
+    mapping_handle_ = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping_handle_ == NULL) {
+        Close();
+        return Status(TNNERR_OPEN_FILE, "model file cannot be mapped");
+    }
+    data_ = static_cast<char *>(MapViewOfFile(mapping_handle_, FILE_MAP_COPY, 0, 0, 0));
+    if (data_ == NULL) {
+        Close();
+        return Status(TNNERR_OPEN_FILE, "model file cannot be mapped");
+    }
+    return TNN_OK;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_) {
+        CloseHandle(mapping_handle_);
+    }
+    if (file_handle_) {
+        CloseHandle(file_handle_);
+    }
+    data_           = nullptr;
+    size_           = 0;
+    mapping_handle_ = nullptr;
+    file_handle_    = nullptr;
+}
+
+#else
+
+Status MappedFile::Open(const std::string &path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOGE("MappedFile open %s failed\n", path.c_str());
+        return Status(TNNERR_OPEN_FILE, "model file cannot be opened");
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return Status(TNNERR_OPEN_FILE, "get model file size failed");
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (size_ == 0) {
+        close(fd);
+        return TNN_OK;
+    }
+
+    // private writable mapping, layers converting weights in place get their own pages
+    void *data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        size_ = 0;
+        return Status(TNNERR_OPEN_FILE, "model file cannot be mapped");
+    }
+    data_ = static_cast<char *>(data);
+    return TNN_OK;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+char *MappedFile::GetData() const {
+    return data_;
+}
+
+size_t MappedFile::GetSize() const {
+    return size_;
+}
+
+MemoryStreamBuf::MemoryStreamBuf(char *data, size_t size) {
+    setg(data, data, data + size);
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                                   std::ios_base::openmode which) {
+    char *base = eback();
+    if (dir == std::ios_base::cur) {
+        base = gptr();
+    } else if (dir == std::ios_base::end) {
+        base = egptr();
+    }
+    char *pos = base + off;
+    if (!(which & std::ios_base::in) || pos < eback() || pos > egptr()) {
+        return pos_type(off_type(-1));
+    }
+    setg(eback(), pos, egptr());
+    return pos_type(pos - eback());
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+}  // namespace TNN_NS
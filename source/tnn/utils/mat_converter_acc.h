@@ -38,6 +38,11 @@ public:
     virtual Status WarpAffine(Mat& src, Mat& dst, WarpAffineParam param, void* command_queue = NULL)         = 0;
     virtual Status CvtColor(Mat& src, Mat& dst, ColorConversionType type, void* command_queue = NULL)        = 0;
     virtual Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue = NULL) = 0;
+    // boxes are checked by MatUtils, dst is allocated with one batch per box
+    virtual Status CropAndResize(Mat& src, Mat& dst, const std::vector<CropParam>& boxes, InterpType type,
+                                 void* command_queue = NULL) {
+        return Status(TNNERR_PARAM_ERR, "CropAndResize is not supported on this device");
+    }
 };
 
 class MatConverterAccCreater {
@@ -213,6 +213,51 @@ Status MatUtils::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, v
     return converter->CopyMakeBorder(src, dst, param, command_queue);
 }
 
+Status MatUtils::CropAndResize(Mat& src, Mat& dst, std::vector<CropParam> boxes, InterpType type,
+                               void* command_queue) {
+    auto ret = CheckSrcAndDstMat(src, dst, true, false, true);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    const int box_count = (int)boxes.size();
+    if (box_count == 0) {
+        return Status(TNNERR_PARAM_ERR, "boxes is empty");
+    }
+    if (src.GetBatch() != 1 && src.GetBatch() != box_count) {
+        return Status(TNNERR_PARAM_ERR, "src batch must be 1 or equal to the box count");
+    }
+    if (dst.GetWidth() <= 0 || dst.GetHeight() <= 0) {
+        return Status(TNNERR_PARAM_ERR, "dst size has zero or negnative value");
+    }
+
+    bool is_yuv      = src.GetMatType() == NNV12 || src.GetMatType() == NNV21;
+    MatType dst_type = is_yuv ? N8UC3 : src.GetMatType();
+    int dst_channel  = is_yuv ? 3 : src.GetChannel();
+    if (dst.GetMatType() != dst_type) {
+        return Status(TNNERR_PARAM_ERR, "dst MatType must be src MatType, or N8UC3 for nv12 and nv21");
+    }
+    for (auto& box : boxes) {
+        if (box.width <= 0 || box.height <= 0 || box.top_left_x < 0 || box.top_left_y < 0 ||
+            box.top_left_x + box.width > src.GetWidth() || box.top_left_y + box.height > src.GetHeight()) {
+            return Status(TNNERR_PARAM_ERR, "box is empty or out of src");
+        }
+        if (is_yuv && (box.top_left_x % 2 || box.top_left_y % 2 || box.width % 2 || box.height % 2)) {
+            return Status(TNNERR_PARAM_ERR, "corp param can not be odd");
+        }
+    }
+
+    if (dst.GetBatch() != box_count || dst.GetChannel() != dst_channel) {
+        CHECK_DST_DATA_NULL;
+        // set dst batch by box count
+        DimsVector dims = {box_count, dst_channel, dst.GetHeight(), dst.GetWidth()};
+        dst = Mat(dst.GetDeviceType(), dst_type, dims);
+    }
+
+    MAT_CONVERTER_PREPARATION(src.GetDeviceType());
+    return converter->CropAndResize(src, dst, boxes, type, command_queue);
+}
+
 #undef CHECK_DST_DATA_NULL
 #undef MAT_CONVERTER_PREPARATION
 
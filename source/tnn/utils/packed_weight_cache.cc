@@ -0,0 +1,90 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/packed_weight_cache.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+typedef std::tuple<const void *, DeviceType, std::string> PackedWeightKey;
+
+struct PackedWeightEntry {
+    std::mutex mutex;
+    std::weak_ptr<char> source;
+    std::weak_ptr<RawBuffer> packed;
+};
+
+static std::mutex g_cache_mutex;
+static std::map<PackedWeightKey, std::shared_ptr<PackedWeightEntry>> g_cache;
+
+static bool IsExpired(const PackedWeightEntry &entry) {
+    return entry.source.expired() || entry.packed.expired();
+}
+
+static std::shared_ptr<PackedWeightEntry> GetEntry(const PackedWeightKey &key) {
+    std::lock_guard<std::mutex> lock(g_cache_mutex);
+    auto iter = g_cache.find(key);
+    if (iter != g_cache.end()) {
+        return iter->second;
+    }
+
+    // drop the entries released by all layers before adding a new one
+    for (auto entry = g_cache.begin(); entry != g_cache.end();) {
+        std::unique_lock<std::mutex> entry_lock(entry->second->mutex, std::try_to_lock);
+        if (entry_lock.owns_lock() && IsExpired(*entry->second)) {
+            entry_lock.unlock();
+            entry = g_cache.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+
+    auto entry    = std::make_shared<PackedWeightEntry>();
+    g_cache[key] = entry;
+    return entry;
+}
+
+Status PackedWeightCache::Get(const RawBuffer &source, DeviceType device, const std::string &tag,
+                              PackFunction pack_func, std::shared_ptr<RawBuffer> &packed) {
+    auto source_ref = source.GetWeakReference();
+    auto source_ptr = source.force_to<const void *>();
+    if (!source_ptr) {
+        // nothing identifies the weight, pack it for the caller only
+        packed = std::make_shared<RawBuffer>();
+        return pack_func(*packed);
+    }
+
+    auto entry = GetEntry(std::make_tuple(source_ptr, device, tag));
+    // layers of sibling instances wait here until the first one finishes packing
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    // the source address may be reused by a new weight once the old one is freed
+    packed = IsExpired(*entry) ? nullptr : entry->packed.lock();
+    if (packed) {
+        return TNN_OK;
+    }
+
+    auto buffer = std::make_shared<RawBuffer>();
+    RETURN_ON_NEQ(pack_func(*buffer), TNN_OK);
+    entry->source = source_ref;
+    entry->packed = buffer;
+    packed        = buffer;
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
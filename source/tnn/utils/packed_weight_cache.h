@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
+#define TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/raw_buffer.h"
+
+namespace TNN_NS {
+
+// @brief PackedWeightCache shares packed weights between instances created from the
+// same model. Instances share the layer resources of their interpreter, so a packed
+// weight is identified by the memory of its source weight, the device and a tag
+// describing the packed layout. Entries are ref-counted by the layers holding them and
+// are repacked once all of them are released.
+class PackedWeightCache {
+public:
+    typedef std::function<Status(RawBuffer &packed)> PackFunction;
+
+    // @brief get the packed weight of source, pack_func is called only if no alive layer
+    // holds a packed weight with the same key. The packed weight is read-only.
+    // @param source unpacked weight
+    // @param device device type the weight is packed for
+    // @param tag layout, isa and shape of the packed weight
+    // @param pack_func function packing the source weight
+    // @param packed the shared packed weight, hold it as long as it is used
+    static Status Get(const RawBuffer &source, DeviceType device, const std::string &tag, PackFunction pack_func,
+                      std::shared_ptr<RawBuffer> &packed);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_PACKED_WEIGHT_CACHE_H_
@@ -413,4 +413,264 @@ TEST_P(BlobConverterTest, BlobConverterTest) {
 #undef CLEANUP_AND_FAIL
 }
 
+AbstractDevice* BlobConverterPreprocessTest::cpu_;
+AbstractDevice* BlobConverterPreprocessTest::device_;
+Context* BlobConverterPreprocessTest::cpu_context_;
+Context* BlobConverterPreprocessTest::device_context_;
+
+void BlobConverterPreprocessTest::SetUpTestCase() {
+    SetUpEnvironment(&cpu_, &device_, &cpu_context_, &device_context_);
+}
+
+void BlobConverterPreprocessTest::TearDownTestCase() {
+    delete cpu_context_;
+    delete device_context_;
+}
+
+INSTANTIATE_TEST_SUITE_P(BlobConverterPreprocessTest, BlobConverterPreprocessTest,
+                         ::testing::Combine(
+                             // mat type
+                             testing::Values(N8UC4, N8UC3, NGRAY, NNV12, NNV21),
+                             // interp type
+                             testing::Values(INTERP_TYPE_NEAREST, INTERP_TYPE_LINEAR),
+                             // reverse_channel
+                             testing::Values(false, true),
+                             // crop
+                             testing::Values(false, true),
+                             // output size
+                             testing::Values(7, 16, 40)));
+
+TEST_P(BlobConverterPreprocessTest, BlobConverterPreprocessTest) {
+    MatType mat_type     = std::get<0>(GetParam());
+    InterpType interp    = std::get<1>(GetParam());
+    bool reverse_channel = std::get<2>(GetParam());
+    bool crop            = std::get<3>(GetParam());
+    int output_size      = std::get<4>(GetParam());
+
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    // the fused preprocess is implemented by x86 and arm
+    if (dev != DEVICE_X86 && dev != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+    if (mat_type == NGRAY && reverse_channel) {
+        GTEST_SKIP();
+    }
+
+    // MatUtils::CvtColor takes batched nv12/nv21 as one tall image, keep one batch for the reference
+    const int batch = (mat_type == NNV12 || mat_type == NNV21) ? 1 : 2;
+    const int input_h = 24, input_w = 32;
+    int channel     = mat_type == NGRAY ? 1 : (mat_type == N8UC4 ? 4 : 3);
+    DimsVector mat_dims  = {batch, channel, input_h, input_w};
+    DimsVector blob_dims = {batch, channel, output_size, output_size + 2};
+    int mat_size   = (mat_type == NNV12 || mat_type == NNV21) ? batch * input_h * input_w * 3 / 2
+                                                             : batch * channel * input_h * input_w;
+    int out_size   = DimsVectorUtils::Count(blob_dims);
+
+    std::vector<uint8_t> mat_data(mat_size);
+    InitRandom(mat_data.data(), mat_size, static_cast<uint8_t>(0), static_cast<uint8_t>(255));
+    std::vector<float> out_ref(out_size), out_dev(out_size);
+
+    BlobDesc blob_desc;
+    blob_desc.dims        = blob_dims;
+    blob_desc.device_type = device_->GetDeviceType();
+    blob_desc.data_type   = DATA_TYPE_FLOAT;
+    blob_desc.data_format = GetDefaultDataFormat(blob_desc.device_type);
+    Blob ref_blob(blob_desc);
+    Blob dev_blob(blob_desc);
+    BlobHandleAllocate(&ref_blob, device_);
+    BlobHandleAllocate(&dev_blob, device_);
+    void* command_queue;
+    device_context_->GetCommandQueue(&command_queue);
+
+    MatConvertParam param;
+    param.reverse_channel = reverse_channel;
+    param.scale           = {0.5f, 0.25f, 0.125f, 1.0f};
+    param.bias            = {-1.0f, 2.0f, 0.5f, 0.0f};
+
+    MatPreprocessParam preprocess;
+    preprocess.interp_type = interp;
+    if (crop) {
+        preprocess.crop.top_left_x = 4;
+        preprocess.crop.top_left_y = 2;
+        preprocess.crop.width      = 20;
+        preprocess.crop.height     = 16;
+    }
+
+    // reference: color convert, crop and resize by MatUtils, then convert the mat to the blob
+    Mat mat_in(dev, mat_type, mat_dims, mat_data.data());
+    Mat src = mat_in;
+    Status ret;
+    if (mat_type == NNV12 || mat_type == NNV21) {
+        Mat bgr(dev, N8UC3, mat_dims);
+        ret = MatUtils::CvtColor(src, bgr, mat_type == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR,
+                                 command_queue);
+        ASSERT_TRUE(ret == TNN_OK);
+        src = bgr;
+    }
+    if (crop) {
+        Mat cropped(dev, src.GetMatType(), {batch, channel, preprocess.crop.height, preprocess.crop.width});
+        ret = MatUtils::Crop(src, cropped, preprocess.crop, command_queue);
+        ASSERT_TRUE(ret == TNN_OK);
+        src = cropped;
+    }
+    Mat resized(dev, src.GetMatType(), {batch, channel, blob_dims[2], blob_dims[3]});
+    ResizeParam resize_param;
+    resize_param.type = interp;
+    ret = MatUtils::Resize(src, resized, resize_param, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+
+    BlobConverter ref_converter(&ref_blob);
+    ret = ref_converter.ConvertFromMat(resized, param, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+
+    BlobConverter dev_converter(&dev_blob);
+    ret = dev_converter.ConvertFromMatWithPreprocess(mat_in, preprocess, param, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+
+    MatConvertParam to_mat_param;
+    Mat ref_out(DEVICE_NAIVE, NCHW_FLOAT, blob_dims, out_ref.data());
+    Mat dev_out(DEVICE_NAIVE, NCHW_FLOAT, blob_dims, out_dev.data());
+    ASSERT_TRUE(ref_converter.ConvertToMat(ref_out, to_mat_param, command_queue) == TNN_OK);
+    ASSERT_TRUE(dev_converter.ConvertToMat(dev_out, to_mat_param, command_queue) == TNN_OK);
+
+    EXPECT_EQ(0, CompareData(out_ref.data(), out_dev.data(), out_size, 0.01));
+
+    BlobHandleFree(&ref_blob, device_);
+    BlobHandleFree(&dev_blob, device_);
+}
+
+AbstractDevice* BlobConverterBoxesTest::cpu_;
+AbstractDevice* BlobConverterBoxesTest::device_;
+Context* BlobConverterBoxesTest::cpu_context_;
+Context* BlobConverterBoxesTest::device_context_;
+
+void BlobConverterBoxesTest::SetUpTestCase() {
+    SetUpEnvironment(&cpu_, &device_, &cpu_context_, &device_context_);
+}
+
+void BlobConverterBoxesTest::TearDownTestCase() {
+    delete cpu_context_;
+    delete device_context_;
+}
+
+INSTANTIATE_TEST_SUITE_P(BlobConverterBoxesTest, BlobConverterBoxesTest,
+                         ::testing::Combine(
+                             // mat type
+                             testing::Values(N8UC4, N8UC3, NGRAY, NNV12, NNV21),
+                             // interp type
+                             testing::Values(INTERP_TYPE_NEAREST, INTERP_TYPE_LINEAR),
+                             // image batch
+                             testing::Values(1, 3)));
+
+TEST_P(BlobConverterBoxesTest, BlobConverterBoxesTest) {
+    MatType mat_type  = std::get<0>(GetParam());
+    InterpType interp = std::get<1>(GetParam());
+    int image_batch   = std::get<2>(GetParam());
+
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    // MatUtils::CropAndResize is implemented by naive, x86 and arm
+    if (dev != DEVICE_X86 && dev != DEVICE_ARM && dev != DEVICE_NAIVE) {
+        GTEST_SKIP();
+    }
+
+    bool is_yuv        = mat_type == NNV12 || mat_type == NNV21;
+    const int input_h  = 24, input_w = 32;
+    const int output_h = 9, output_w = 14;
+    int channel        = mat_type == NGRAY ? 1 : (mat_type == N8UC4 ? 4 : 3);
+    MatType out_type   = is_yuv ? N8UC3 : mat_type;
+    // boxes of different size, the last one is smaller than the output
+    std::vector<CropParam> boxes;
+    int box_params[3][4] = {{4, 2, 20, 16}, {0, 0, input_w, input_h}, {10, 6, 6, 4}};
+    for (auto& p : box_params) {
+        CropParam box;
+        box.top_left_x = p[0];
+        box.top_left_y = p[1];
+        box.width      = p[2];
+        box.height     = p[3];
+        boxes.push_back(box);
+    }
+
+    const int box_count     = (int)boxes.size();
+    int image_size          = is_yuv ? input_h * input_w * 3 / 2 : channel * input_h * input_w;
+    int resized_size        = channel * output_h * output_w;
+    DimsVector image_dims   = {image_batch, channel, input_h, input_w};
+    DimsVector resized_dims = {box_count, channel, output_h, output_w};
+
+    std::vector<uint8_t> image_data(image_batch * image_size);
+    InitRandom(image_data.data(), image_batch * image_size, static_cast<uint8_t>(0), static_cast<uint8_t>(255));
+    void* command_queue;
+    device_context_->GetCommandQueue(&command_queue);
+
+    // reference: crop, color convert and resize every box by MatUtils
+    Status ret;
+    std::vector<uint8_t> resized_ref(box_count * resized_size);
+    ResizeParam resize_param;
+    resize_param.type = interp;
+    for (int i = 0; i < box_count; ++i) {
+        auto& box = boxes[i];
+        Mat image_b(dev, mat_type, {1, channel, input_h, input_w},
+                    image_data.data() + (image_batch == 1 ? 0 : i) * image_size);
+        Mat cropped(dev, mat_type, {1, channel, box.height, box.width});
+        ret = MatUtils::Crop(image_b, cropped, box, command_queue);
+        ASSERT_TRUE(ret == TNN_OK);
+        if (is_yuv) {
+            Mat bgr(dev, N8UC3, {1, 3, box.height, box.width});
+            ret = MatUtils::CvtColor(cropped, bgr,
+                                     mat_type == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR,
+                                     command_queue);
+            ASSERT_TRUE(ret == TNN_OK);
+            cropped = bgr;
+        }
+        Mat resized_b(dev, out_type, {1, channel, output_h, output_w}, resized_ref.data() + i * resized_size);
+        ret = MatUtils::Resize(cropped, resized_b, resize_param, command_queue);
+        ASSERT_TRUE(ret == TNN_OK);
+    }
+
+    Mat image(dev, mat_type, image_dims, image_data.data());
+    // dst batch is set by the box count
+    Mat resized(dev, out_type, {1, channel, output_h, output_w}, nullptr);
+    ret = MatUtils::CropAndResize(image, resized, boxes, interp, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+    ASSERT_TRUE(DimsVectorUtils::Equal(resized.GetDims(), resized_dims));
+    EXPECT_EQ(0, CompareData(resized_ref.data(), (uint8_t*)resized.GetData(), channel, channel,
+                             box_count * resized_size));
+
+    // boxes scaled into the blob
+    BlobDesc blob_desc;
+    blob_desc.dims        = resized_dims;
+    blob_desc.device_type = device_->GetDeviceType();
+    blob_desc.data_type   = DATA_TYPE_FLOAT;
+    blob_desc.data_format = GetDefaultDataFormat(blob_desc.device_type);
+    Blob ref_blob(blob_desc);
+    Blob dev_blob(blob_desc);
+    BlobHandleAllocate(&ref_blob, device_);
+    BlobHandleAllocate(&dev_blob, device_);
+
+    MatConvertParam param;
+    param.scale = {0.5f, 0.25f, 0.125f, 1.0f};
+    param.bias  = {-1.0f, 2.0f, 0.5f, 0.0f};
+
+    Mat resized_ref_mat(dev, out_type, resized_dims, resized_ref.data());
+    BlobConverter ref_converter(&ref_blob);
+    ret = ref_converter.ConvertFromMat(resized_ref_mat, param, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+
+    BlobConverter dev_converter(&dev_blob);
+    ret = dev_converter.ConvertFromMatWithBoxes(image, boxes, interp, param, command_queue);
+    ASSERT_TRUE(ret == TNN_OK);
+
+    int out_size = DimsVectorUtils::Count(resized_dims);
+    std::vector<float> out_ref(out_size), out_dev(out_size);
+    MatConvertParam to_mat_param;
+    Mat ref_out(DEVICE_NAIVE, NCHW_FLOAT, resized_dims, out_ref.data());
+    Mat dev_out(DEVICE_NAIVE, NCHW_FLOAT, resized_dims, out_dev.data());
+    ASSERT_TRUE(ref_converter.ConvertToMat(ref_out, to_mat_param, command_queue) == TNN_OK);
+    ASSERT_TRUE(dev_converter.ConvertToMat(dev_out, to_mat_param, command_queue) == TNN_OK);
+
+    EXPECT_EQ(0, CompareData(out_ref.data(), out_dev.data(), out_size, 0.01));
+
+    BlobHandleFree(&ref_blob, device_);
+    BlobHandleFree(&dev_blob, device_);
+}
+
 }  // namespace TNN_NS
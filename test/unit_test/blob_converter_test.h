@@ -50,6 +50,31 @@ protected:
     static Context* device_context_;
 };
 
+class BlobConverterPreprocessTest
+    : public ::testing::TestWithParam<std::tuple<MatType, InterpType, bool, bool, int>> {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+
+protected:
+    static AbstractDevice* cpu_;
+    static AbstractDevice* device_;
+    static Context* cpu_context_;
+    static Context* device_context_;
+};
+
+class BlobConverterBoxesTest : public ::testing::TestWithParam<std::tuple<MatType, InterpType, int>> {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+
+protected:
+    static AbstractDevice* cpu_;
+    static AbstractDevice* device_;
+    static Context* cpu_context_;
+    static Context* device_context_;
+};
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_UNIT_TEST_BLOB_CONVERTER_TEST_H_
@@ -0,0 +1,203 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/blocked_layout_test.h"
+
+#include <random>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static RawBuffer RandomBuffer(std::mt19937& rng, int count) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    RawBuffer buffer(count * sizeof(float));
+    auto data = buffer.force_to<float*>();
+    for (int i = 0; i < count; ++i) {
+        data[i] = dist(rng);
+    }
+    return buffer;
+}
+
+static void AddLayer(NetStructure* net_structure, LayerType type, std::string type_str, std::string name,
+                     std::vector<std::string> inputs, std::shared_ptr<LayerParam> param) {
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = type;
+    layer_info->type_str = type_str;
+    layer_info->name     = name;
+    layer_info->inputs   = inputs;
+    layer_info->outputs  = {name};
+    param->name          = name;
+    layer_info->param    = param;
+    net_structure->layers.push_back(layer_info);
+    net_structure->blobs.insert(name);
+}
+
+static void AddConv(NetStructure* net_structure, NetResource* net_resource, std::mt19937& rng, std::string name,
+                    std::string input, int input_channel, int output_channel, int kernel, int stride, int group,
+                    int activation_type) {
+    auto param             = std::make_shared<ConvLayerParam>();
+    param->input_channel   = input_channel / group;
+    param->output_channel  = output_channel;
+    param->kernels         = {kernel, kernel};
+    param->strides         = {stride, stride};
+    param->dialations      = {1, 1};
+    param->pads            = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->group           = group;
+    param->bias            = 1;
+    param->activation_type = activation_type;
+    AddLayer(net_structure, LAYER_CONVOLUTION, "Convolution", name, {input}, param);
+
+    auto resource           = std::make_shared<ConvLayerResource>();
+    resource->filter_handle = RandomBuffer(rng, output_channel * input_channel / group * kernel * kernel);
+    resource->bias_handle   = RandomBuffer(rng, output_channel);
+    net_resource->resource_map[name] = resource;
+}
+
+static void AddElementResource(NetResource* net_resource, std::mt19937& rng, std::string name, DimsVector shape) {
+    auto resource            = std::make_shared<EltwiseLayerResource>();
+    resource->element_handle = RandomBuffer(rng, DimsVectorUtils::Count(shape));
+    resource->element_shape  = shape;
+    net_resource->resource_map[name] = resource;
+}
+
+std::shared_ptr<AbstractModelInterpreter> BlockedLayoutTest::GenerateNetInterpreter(DimsVector dims) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+
+    NetStructure* net_structure              = interpreter->GetNetStructure();
+    NetResource* net_resource                = interpreter->GetNetResource();
+    net_structure->inputs_shape_map["input"] = dims;
+    net_structure->blobs.insert("input");
+
+    std::mt19937 rng(dims[0] * 100 + dims[1]);
+    const int channel = 12;
+
+    AddConv(net_structure, net_resource, rng, "conv0", "input", dims[1], channel, 3, 1, 1, ActivationType_ReLU);
+    AddConv(net_structure, net_resource, rng, "conv1", "conv0", channel, channel, 1, 1, 1, ActivationType_None);
+    AddLayer(net_structure, LAYER_ADD, "Add", "add0", {"conv0", "conv1"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+
+    auto bn_param      = std::make_shared<BatchNormLayerParam>();
+    bn_param->channels = channel;
+    AddLayer(net_structure, LAYER_BATCH_NORM, "BatchNormCxx", "bn0", {"add0"}, bn_param);
+    auto bn_resource          = std::make_shared<BatchNormLayerResource>();
+    bn_resource->scale_handle = RandomBuffer(rng, channel);
+    bn_resource->bias_handle  = RandomBuffer(rng, channel);
+    net_resource->resource_map["bn0"] = bn_resource;
+
+    AddLayer(net_structure, LAYER_SIGMOID, "Sigmoid", "sigmoid0", {"bn0"}, std::make_shared<LayerParam>());
+    AddConv(net_structure, net_resource, rng, "dw0", "sigmoid0", channel, channel, 3, 2, channel,
+            ActivationType_ReLU6);
+
+    auto pool_param            = std::make_shared<PoolingLayerParam>();
+    pool_param->pool_type      = 0;
+    pool_param->kernels        = {2, 2};
+    pool_param->kernels_params = {2, 2};
+    pool_param->strides        = {2, 2};
+    pool_param->pads           = {0, 0, 0, 0};
+    pool_param->kernel_indexs  = {-1, -1};
+    AddLayer(net_structure, LAYER_POOLING, "Pooling", "pool0", {"sigmoid0"}, pool_param);
+
+    // softmax runs on nchw only, reformat layers are inserted around it
+    AddLayer(net_structure, LAYER_SOFTMAX, "Softmax", "softmax0", {"pool0"}, std::make_shared<SoftmaxLayerParam>());
+
+    AddLayer(net_structure, LAYER_CONCAT, "Concat", "concat0", {"dw0", "softmax0"},
+             std::make_shared<ConcatLayerParam>());
+    AddConv(net_structure, net_resource, rng, "gconv0", "concat0", 2 * channel, 20, 3, 1, 4, ActivationType_None);
+
+    // per channel broadcast runs on the blocked data, the spatial broadcast goes through nchw
+    AddLayer(net_structure, LAYER_MUL, "Mul", "mul0", {"gconv0"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddElementResource(net_resource, rng, "mul0", {1, 20, 1, 1});
+    AddLayer(net_structure, LAYER_SUB, "Sub", "output", {"mul0"}, std::make_shared<MultidirBroadcastLayerParam>());
+    AddElementResource(net_resource, rng, "output", {1, 1, (dims[2] + 1) / 2, (dims[3] + 1) / 2});
+    net_structure->outputs.insert("output");
+
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+Status BlockedLayoutTest::Run(DataFormat data_format, DimsVector dims, std::vector<float>& input_data,
+                              std::vector<float>& output_data, DimsVector& output_dims, DataFormat& output_format) {
+    auto interpreter = GenerateNetInterpreter(dims);
+    if (!interpreter) {
+        return Status(TNNERR_NET_ERR, "create interpreter failed");
+    }
+
+    NetworkConfig config;
+    config.device_type = DEVICE_X86;
+    config.precision   = PRECISION_HIGH;
+    config.data_format = data_format;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    void* command_queue;
+    instance->GetCommandQueue(&command_queue);
+
+    Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, input_data.data());
+    BlobConverter input_converter(input_blobs["input"]);
+    RETURN_ON_NEQ(input_converter.ConvertFromMat(input_mat, MatConvertParam(), command_queue), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    auto output   = output_blobs["output"];
+    output_dims   = output->GetBlobDesc().dims;
+    output_format = output->GetBlobDesc().data_format;
+    output_data.resize(DimsVectorUtils::Count(output_dims));
+    Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, output_dims, output_data.data());
+    BlobConverter output_converter(output);
+    return output_converter.ConvertToMat(output_mat, MatConvertParam(), command_queue);
+}
+
+INSTANTIATE_TEST_SUITE_P(BlockedLayoutTest, BlockedLayoutTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // channel
+                             testing::Values(3, 8, 13)));
+
+TEST_P(BlockedLayoutTest, BlockedLayoutTest) {
+    int batch   = std::get<0>(GetParam());
+    int channel = std::get<1>(GetParam());
+    if (ConvertDeviceType(FLAGS_dt) != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims = {batch, channel, 9, 9};
+    std::vector<float> input_data(DimsVectorUtils::Count(dims));
+    InitRandom(input_data.data(), input_data.size(), -1.0f, 1.0f);
+
+    std::vector<float> nchw_output, blocked_output;
+    DimsVector nchw_dims, blocked_dims;
+    DataFormat nchw_format, blocked_format;
+    ASSERT_TRUE(Run(DATA_FORMAT_NCHW, dims, input_data, nchw_output, nchw_dims, nchw_format) == TNN_OK);
+    ASSERT_TRUE(Run(DATA_FORMAT_NC8HW8, dims, input_data, blocked_output, blocked_dims, blocked_format) == TNN_OK);
+
+    EXPECT_EQ(nchw_format, DATA_FORMAT_NCHW);
+    EXPECT_EQ(blocked_format, DATA_FORMAT_NC8HW8);
+    ASSERT_TRUE(DimsVectorUtils::Equal(nchw_dims, blocked_dims));
+    for (int i = 0; i < nchw_output.size(); ++i) {
+        EXPECT_NEAR(nchw_output[i], blocked_output[i], 1e-3 * std::max(1.0f, std::fabs(nchw_output[i])));
+    }
+}
+
+}  // namespace TNN_NS
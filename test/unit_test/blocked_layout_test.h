@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TEST_UNIT_TEST_BLOCKED_LAYOUT_TEST_H_
+#define TNN_TEST_UNIT_TEST_BLOCKED_LAYOUT_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// runs a small conv net on nchw and on the blocked nc8hw8 layout, the outputs must match.
+class BlockedLayoutTest : public ::testing::TestWithParam<std::tuple<int, int>> {
+protected:
+    std::shared_ptr<AbstractModelInterpreter> GenerateNetInterpreter(DimsVector dims);
+
+    Status Run(DataFormat data_format, DimsVector dims, std::vector<float>& input_data,
+               std::vector<float>& output_data, DimsVector& output_dims, DataFormat& output_format);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_BLOCKED_LAYOUT_TEST_H_
@@ -0,0 +1,222 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/elementwise_fusion_test.h"
+
+#include <cmath>
+#include <random>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static const int kChannel = 8;
+
+static RawBuffer ElementBuffer(const std::vector<float>& values, DimsVector dims) {
+    RawBuffer buffer(values.size() * sizeof(float), (char*)values.data());
+    buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer.SetBufferDims(dims);
+    return buffer;
+}
+
+static RawBuffer RandomBuffer(std::mt19937& rng, DimsVector dims, float low, float high) {
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(DimsVectorUtils::Count(dims));
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return ElementBuffer(values, dims);
+}
+
+static void AddLayer(NetStructure* net_structure, LayerType type, std::string type_str, std::string name,
+                     std::vector<std::string> inputs, std::shared_ptr<LayerParam> param) {
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = type;
+    layer_info->type_str = type_str;
+    layer_info->name     = name;
+    layer_info->inputs   = inputs;
+    layer_info->outputs  = {name};
+    param->name          = name;
+    param->type          = type_str;
+    layer_info->param    = param;
+    net_structure->layers.push_back(layer_info);
+    net_structure->blobs.insert(name);
+}
+
+// binary layer with a constant operand kept in the layer resource, the form onnx2tnn emits
+static void AddElementLayer(NetStructure* net_structure, NetResource* net_resource, LayerType type,
+                            std::string type_str, std::string name, std::string input, RawBuffer element,
+                            int weight_input_index = 1) {
+    auto param                = std::make_shared<MultidirBroadcastLayerParam>();
+    param->weight_input_index = weight_input_index;
+    AddLayer(net_structure, type, type_str, name, {input}, param);
+
+    auto resource            = std::make_shared<EltwiseLayerResource>();
+    resource->element_shape  = element.GetBufferDims();
+    resource->element_handle = element;
+    net_resource->resource_map[name] = resource;
+}
+
+std::shared_ptr<AbstractModelInterpreter> ElementwiseFusionTest::GenerateNetInterpreter(int batch, int size) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+
+    NetStructure* net_structure = interpreter->GetNetStructure();
+    NetResource* net_resource   = interpreter->GetNetResource();
+    std::map<std::string, DimsVector> input_dims = {{"x", {batch, kChannel, size, size}},
+                                                    {"y", {batch, kChannel, size, size}}};
+    for (const auto& iter : input_dims) {
+        net_structure->inputs_shape_map[iter.first] = iter.second;
+        net_structure->blobs.insert(iter.first);
+    }
+
+    std::mt19937 rng(batch * 100 + size);
+
+    // swish of an affine transform, the last mul reads the chain input x again
+    AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "a_scale", "x",
+                    RandomBuffer(rng, {1, kChannel, 1, 1}, 0.5f, 1.5f));
+    AddElementLayer(net_structure, net_resource, LAYER_ADD, "Add", "a_shift", "a_scale", ElementBuffer({0.25f}, {1}));
+    AddLayer(net_structure, LAYER_SIGMOID, "Sigmoid", "a_sigmoid", {"a_shift"}, std::make_shared<LayerParam>());
+    AddLayer(net_structure, LAYER_MUL, "Mul", "output0", {"x", "a_sigmoid"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+
+    // normalization of the difference to y, the output0 read by the net ends the first chain
+    AddLayer(net_structure, LAYER_SUB, "Sub", "b_sub", {"output0", "y"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+    AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "b_scale", "b_sub",
+                    RandomBuffer(rng, {1, kChannel, 1, 1}, -2.0f, 2.0f));
+    AddElementLayer(net_structure, net_resource, LAYER_SUB, "Sub", "b_shift", "b_scale",
+                    RandomBuffer(rng, {1, 1, 1, size}, -1.0f, 1.0f), 0);
+    auto clip_param = std::make_shared<ClipLayerParam>();
+    clip_param->min = -1.0f;
+    clip_param->max = 2.0f;
+    AddLayer(net_structure, LAYER_CLIP, "Clip", "b_clip", {"b_shift"}, clip_param);
+    AddElementLayer(net_structure, net_resource, LAYER_DIV, "Div", "output1", "b_clip", ElementBuffer({3.0f}, {1}));
+
+    // a single layer is not a chain
+    AddLayer(net_structure, LAYER_RELU, "ReLU", "output2", {"output1"}, std::make_shared<LayerParam>());
+
+    net_structure->outputs.insert("output0");
+    net_structure->outputs.insert("output1");
+    net_structure->outputs.insert("output2");
+
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+Status ElementwiseFusionTest::Run(DeviceType device_type, std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                  std::map<std::string, std::vector<float>>& input_data,
+                                  std::map<std::string, std::vector<float>>& output_data) {
+    NetworkConfig config;
+    config.device_type = device_type;
+    config.precision   = PRECISION_HIGH;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    void* command_queue;
+    instance->GetCommandQueue(&command_queue);
+
+    for (auto& iter : input_data) {
+        auto blob = input_blobs[iter.first];
+        if (!blob) {
+            return Status(TNNERR_NULL_PARAM, "input blob not found");
+        }
+        Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, blob->GetBlobDesc().dims, iter.second.data());
+        BlobConverter input_converter(blob);
+        RETURN_ON_NEQ(input_converter.ConvertFromMat(input_mat, MatConvertParam(), command_queue), TNN_OK);
+    }
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    for (auto& iter : output_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        auto& data = output_data[iter.first];
+        data.resize(DimsVectorUtils::Count(dims));
+        Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, data.data());
+        BlobConverter output_converter(iter.second);
+        RETURN_ON_NEQ(output_converter.ConvertToMat(output_mat, MatConvertParam(), command_queue), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+INSTANTIATE_TEST_SUITE_P(ElementwiseFusionTest, ElementwiseFusionTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // spatial size, the larger one spans several tiles
+                             testing::Values(5, 24)));
+
+TEST_P(ElementwiseFusionTest, ElementwiseFusionTest) {
+    const int batch = std::get<0>(GetParam());
+    const int size  = std::get<1>(GetParam());
+    if (ConvertDeviceType(FLAGS_dt) != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    // each chain is replaced by one fused layer
+    {
+        auto interpreter = GenerateNetInterpreter(batch, size);
+        ASSERT_TRUE(interpreter != nullptr);
+        auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+        auto optimizer = optimizer::NetOptimizerManager::GetNetOptimizerByName(kNetOptimizerFuseElementwise);
+        ASSERT_TRUE(optimizer != nullptr);
+        ASSERT_TRUE(optimizer->Optimize(default_interpreter->GetNetStructure(), default_interpreter->GetNetResource()) ==
+                    TNN_OK);
+
+        std::map<LayerType, int> layer_count;
+        for (auto layer : default_interpreter->GetNetStructure()->layers) {
+            layer_count[layer->type]++;
+        }
+        EXPECT_EQ(layer_count[LAYER_FUSED_ELEMENTWISE], 2);
+        EXPECT_EQ(layer_count[LAYER_RELU], 1);
+        EXPECT_EQ(layer_count[LAYER_SIGMOID], 0);
+        EXPECT_EQ(layer_count[LAYER_CLIP], 0);
+        EXPECT_EQ(layer_count[LAYER_MUL], 0);
+        EXPECT_EQ(layer_count[LAYER_DIV], 0);
+    }
+
+    std::map<std::string, std::vector<float>> input_data;
+    input_data["x"] = std::vector<float>(batch * kChannel * size * size);
+    input_data["y"] = std::vector<float>(batch * kChannel * size * size);
+    for (auto& iter : input_data) {
+        InitRandom(iter.second.data(), iter.second.size(), -2.0f, 2.0f);
+    }
+
+    std::map<std::string, std::vector<float>> fused_output, reference_output;
+    ASSERT_TRUE(Run(DEVICE_X86, GenerateNetInterpreter(batch, size), input_data, fused_output) == TNN_OK);
+    ASSERT_TRUE(Run(DEVICE_NAIVE, GenerateNetInterpreter(batch, size), input_data, reference_output) == TNN_OK);
+
+    for (const std::string name : {"output0", "output1", "output2"}) {
+        auto& fused     = fused_output[name];
+        auto& reference = reference_output[name];
+        ASSERT_EQ(fused.size(), reference.size());
+        ASSERT_FALSE(fused.empty());
+        for (int i = 0; i < reference.size(); ++i) {
+            EXPECT_NEAR(fused[i], reference[i], 1e-4 * std::max(1.0f, std::fabs(reference[i])));
+        }
+    }
+}
+
+}  // namespace TNN_NS
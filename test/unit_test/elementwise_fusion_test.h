@@ -0,0 +1,43 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TEST_UNIT_TEST_ELEMENTWISE_FUSION_TEST_H_
+#define TNN_TEST_UNIT_TEST_ELEMENTWISE_FUSION_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// builds chains of activation and binary elementwise layers, the x86 network fuses each chain
+// into one FusedElementwise layer and must match the unfused naive network.
+class ElementwiseFusionTest : public ::testing::TestWithParam<std::tuple<int, int>> {
+protected:
+    std::shared_ptr<AbstractModelInterpreter> GenerateNetInterpreter(int batch, int size);
+
+    Status Run(DeviceType device_type, std::shared_ptr<AbstractModelInterpreter> interpreter,
+               std::map<std::string, std::vector<float>>& input_data,
+               std::map<std::string, std::vector<float>>& output_data);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_ELEMENTWISE_FUSION_TEST_H_
@@ -0,0 +1,125 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/forward_dispatch_test.h"
+
+#include <chrono>
+#include <sstream>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+std::shared_ptr<AbstractModelInterpreter> ForwardDispatchTest::GenerateChainInterpreter(int layer_count,
+                                                                                        DimsVector dims) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+
+    NetStructure* net_structure              = interpreter->GetNetStructure();
+    net_structure->inputs_shape_map["input"] = dims;
+    net_structure->blobs.insert("input");
+
+    std::string input = "input";
+    for (int i = 0; i < layer_count; ++i) {
+        std::ostringstream output;
+        output << "relu" << i;
+
+        auto param  = std::make_shared<LayerParam>();
+        param->name = output.str();
+
+        auto layer_info      = std::make_shared<LayerInfo>();
+        layer_info->type     = LAYER_RELU;
+        layer_info->type_str = "ReLU";
+        layer_info->name     = output.str();
+        layer_info->inputs   = {input};
+        layer_info->outputs  = {output.str()};
+        layer_info->param    = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(output.str());
+        input = output.str();
+    }
+    net_structure->outputs.insert(input);
+
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+INSTANTIATE_TEST_SUITE_P(ForwardDispatchTest, ForwardDispatchTest, testing::Values(1, 16, 256));
+
+TEST_P(ForwardDispatchTest, ForwardDispatchTest) {
+    int layer_count = GetParam();
+    DeviceType dev  = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_NAIVE && dev != DEVICE_X86 && dev != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+
+    DimsVector dims  = {1, 4, 2, 2};
+    auto interpreter = GenerateChainInterpreter(layer_count, dims);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    NetworkConfig config;
+    config.device_type = dev;
+    config.precision   = PRECISION_HIGH;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(config, model_config);
+    Status ret    = instance->Init(interpreter, InputShapesMap());
+    ASSERT_TRUE(ret == TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    ASSERT_EQ(input_blobs.size(), 1);
+    ASSERT_EQ(output_blobs.size(), 1);
+    void* command_queue;
+    instance->GetCommandQueue(&command_queue);
+
+    int count = DimsVectorUtils::Count(dims);
+    std::vector<float> input_data(count), output_data(count);
+    for (int i = 0; i < count; ++i) {
+        input_data[i] = (float)(i - count / 2);
+    }
+    Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, input_data.data());
+    Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, output_data.data());
+    BlobConverter input_converter(input_blobs.begin()->second);
+    BlobConverter output_converter(output_blobs.begin()->second);
+    ASSERT_TRUE(input_converter.ConvertFromMat(input_mat, MatConvertParam(), command_queue) == TNN_OK);
+
+    // warm up, then time the forward of the whole chain
+    ret = instance->Forward();
+    ASSERT_TRUE(ret == TNN_OK);
+    const int iterations = std::max(FLAGS_ic, 1);
+    auto start           = std::chrono::system_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        ret = instance->Forward();
+        ASSERT_TRUE(ret == TNN_OK);
+    }
+    auto stop = std::chrono::system_clock::now();
+
+    ASSERT_TRUE(output_converter.ConvertToMat(output_mat, MatConvertParam(), command_queue) == TNN_OK);
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ(output_data[i], std::max(input_data[i], 0.0f));
+    }
+
+    if (FLAGS_ub) {
+        float us = std::chrono::duration_cast<std::chrono::microseconds>(stop - start).count() / (float)iterations;
+        LOGI("device %-8s layers %-6d forward = %8.3f us  |  per layer = %6.3f us\n", FLAGS_dt.c_str(), layer_count,
+             us, us / layer_count);
+    }
+}
+
+}  // namespace TNN_NS
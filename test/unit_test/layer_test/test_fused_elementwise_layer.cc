@@ -0,0 +1,96 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static bool TestFilter(DeviceType device_type) {
+    if (device_type == DEVICE_NAIVE || device_type == DEVICE_X86) {
+        return true;
+    }
+    return false;
+}
+
+static FusedElementwiseStep Step(LayerType type, int operand = -1, bool operand_first = false, float alpha = 0.0f,
+                                 float beta = 0.0f) {
+    FusedElementwiseStep step;
+    step.type          = type;
+    step.operand       = operand;
+    step.operand_first = operand_first;
+    step.alpha         = alpha;
+    step.beta          = beta;
+    return step;
+}
+
+class FusedElementwiseLayerTest : public LayerTest,
+                                  public ::testing::WithParamInterface<std::tuple<int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, FusedElementwiseLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),        // batch
+                                            testing::Values(3, 8, 13),    // channel
+                                            testing::Values(1, 5, 32),    // input size
+                                            testing::Values(0, 1, 2, 3)   // program
+                                            ));
+
+TEST_P(FusedElementwiseLayerTest, FusedElementwiseLayer) {
+    // get param
+    int batch      = std::get<0>(GetParam());
+    int channel    = std::get<1>(GetParam());
+    int input_size = std::get<2>(GetParam());
+    int program    = std::get<3>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+
+    if (!TestFilter(dev)) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<FusedElementwiseLayerParam> param(new FusedElementwiseLayerParam());
+    param->name = "FusedElementwise";
+
+    DimsVector dims = {batch, channel, input_size, input_size};
+    std::vector<std::vector<int>> inputs_dims;
+    if (program == 0) {
+        // swish: x * sigmoid(x)
+        inputs_dims  = {dims};
+        param->steps = {Step(LAYER_SIGMOID), Step(LAYER_MUL, 0, true)};
+    } else if (program == 1) {
+        // normalization: relu6((x - mean) * scale + bias) with per channel and per column operands
+        inputs_dims  = {dims, {1, channel, 1, 1}, {1, channel, 1, 1}, {1, 1, 1, input_size}};
+        param->steps = {Step(LAYER_SUB, 1), Step(LAYER_MUL, 2), Step(LAYER_ADD, 3, true), Step(LAYER_RELU6)};
+    } else if (program == 2) {
+        // clip, divide and saturate, a scalar operand on the left
+        inputs_dims  = {dims, {1}, dims};
+        param->steps = {Step(LAYER_CLIP, -1, false, -0.5f, 0.75f), Step(LAYER_SUB, 1, true), Step(LAYER_DIV, 2),
+                        Step(LAYER_TANH), Step(LAYER_HARDSIGMOID, -1, false, 0.2f, 0.5f)};
+        ensure_input_positive_ = 1;
+    } else {
+        // input 0 broadcast to the other inputs
+        inputs_dims  = {{batch, channel, 1, 1}, dims, {1, 1, input_size, input_size}};
+        param->steps = {Step(LAYER_ADD, 1),     Step(LAYER_ABS),      Step(LAYER_NEG),  Step(LAYER_EXP),
+                        Step(LAYER_MAXIMUM, 2), Step(LAYER_MINIMUM, 1), Step(LAYER_SWISH), Step(LAYER_RELU)};
+    }
+
+    // generate interpreter
+    auto interpreter = GenerateInterpreter("FusedElementwise", inputs_dims, param);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
@@ -48,8 +48,8 @@ TEST_P(GLULayerTest, GLULayer) {
     if (CheckDataTypeSkip(data_type)) {
         GTEST_SKIP();
     }
-    if (DEVICE_ARM != dev) {
-        // only arm device support glu layer
+    if (DEVICE_ARM != dev && DEVICE_X86 != dev) {
+        // only arm and x86 device support glu layer
         GTEST_SKIP();
     }
     if (data_type == DATA_TYPE_BFP16) {
@@ -62,8 +62,8 @@ TEST_P(GridSampleLayerTest, GridSampleLayer) {
     if (CheckDataTypeSkip(data_type)) {
         GTEST_SKIP();
     }
-    if (!(DEVICE_NAIVE == dev || DEVICE_ARM == dev || DEVICE_CUDA == dev || DEVICE_OPENCL == dev ||
-          DEVICE_METAL == dev)) {
+    if (!(DEVICE_NAIVE == dev || DEVICE_ARM == dev || DEVICE_X86 == dev || DEVICE_CUDA == dev ||
+          DEVICE_OPENCL == dev || DEVICE_METAL == dev)) {
         GTEST_SKIP();
     }
 
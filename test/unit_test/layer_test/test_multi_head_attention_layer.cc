@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static bool TestFilter(DeviceType device_type) {
+    if (device_type == DEVICE_NAIVE || device_type == DEVICE_X86) {
+        return true;
+    }
+    return false;
+}
+
+class MultiHeadAttentionLayerTest : public LayerTest,
+                                    public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, MultiHeadAttentionLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),         // batch
+                                            testing::Values(1, 4),         // heads
+                                            testing::Values(1, 7, 16),     // seq_q
+                                            testing::Values(5, 16),        // seq_k
+                                            testing::Values(3, 8, 13, 64), // head_dim
+                                            // mask, 0: none, 1: [batch, 1, 1, seq_k], 2: [batch, 1, seq_q, seq_k]
+                                            testing::Values(0, 1, 2)));
+
+TEST_P(MultiHeadAttentionLayerTest, MultiHeadAttentionLayer) {
+    // get param
+    int batch      = std::get<0>(GetParam());
+    int heads      = std::get<1>(GetParam());
+    int seq_q      = std::get<2>(GetParam());
+    int seq_k      = std::get<3>(GetParam());
+    int head_dim   = std::get<4>(GetParam());
+    int mask_type  = std::get<5>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+
+    if (!TestFilter(dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<MultiHeadAttentionLayerParam> param(new MultiHeadAttentionLayerParam());
+    param->name         = "MultiHeadAttention";
+    param->scale        = 1.0f / std::sqrt((float)head_dim);
+    param->softmax_axis = 3;
+
+    // generate interpreter
+    std::vector<std::vector<int>> inputs_dims = {{batch, heads, seq_q, head_dim},
+                                                 {batch, heads, head_dim, seq_k},
+                                                 {batch, heads, seq_k, head_dim}};
+    if (mask_type == 1) {
+        inputs_dims.push_back({batch, 1, 1, seq_k});
+    } else if (mask_type == 2) {
+        inputs_dims.push_back({batch, 1, seq_q, seq_k});
+    }
+    auto interpreter = GenerateInterpreter("MultiHeadAttention", inputs_dims, param);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,65 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class ScatterElementsLayerTest : public LayerTest,
+                                 public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, ScatterElementsLayerTest,
+                         ::testing::Combine(testing::Values(1, 2), testing::Values(3, 16),
+                                            testing::Values(9, 16),
+                                            // axis
+                                            testing::Values(0, 1, 2, 3),
+                                            // op: 0 eq, 1 add
+                                            testing::Values(0, 1),
+                                            // dtype
+                                            testing::Values(DATA_TYPE_FLOAT)));
+
+TEST_P(ScatterElementsLayerTest, ScatterElementsLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int channel        = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int axis           = std::get<3>(GetParam());
+    int op             = std::get<4>(GetParam());
+    DataType data_type = std::get<5>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (!(DEVICE_NAIVE == dev || DEVICE_X86 == dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<ScatterElementsLayerParam> param(new ScatterElementsLayerParam());
+    param->name = "ScatterElements";
+    param->axis = axis;
+    param->op   = op;
+
+    // indices and updates cover a part of data
+    std::vector<int> data_dims    = {batch, channel, input_size, input_size};
+    std::vector<int> indices_dims = {batch, channel, input_size - 2, input_size / 2};
+    integer_input_max_            = data_dims[axis];
+    std::vector<DataType> input_dtype = {data_type, DATA_TYPE_INT32, data_type};
+    auto interpreter = GenerateInterpreter("ScatterElements", {data_dims, indices_dims, indices_dims}, param, nullptr,
+                                           1, input_dtype);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
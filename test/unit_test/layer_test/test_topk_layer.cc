@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class TopKLayerTest : public LayerTest,
+                      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int, DataType>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, TopKLayerTest,
+                         ::testing::Combine(testing::Values(1, 2), testing::Values(3, 16, 33),
+                                            testing::Values(9, 16),
+                                            // axis
+                                            testing::Values(1, 2, 3),
+                                            // k
+                                            testing::Values(1, 5, 16),
+                                            // largest
+                                            testing::Values(0, 1),
+                                            // sorted
+                                            testing::Values(0, 1),
+                                            // dtype
+                                            testing::Values(DATA_TYPE_FLOAT)));
+
+TEST_P(TopKLayerTest, TopKLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int channel        = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int axis           = std::get<3>(GetParam());
+    int k              = std::get<4>(GetParam());
+    int largest        = std::get<5>(GetParam());
+    int sorted         = std::get<6>(GetParam());
+    DataType data_type = std::get<7>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (CheckDataTypeSkip(data_type)) {
+        GTEST_SKIP();
+    }
+    if (!(DEVICE_NAIVE == dev || DEVICE_X86 == dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<TopKLayerParam> param(new TopKLayerParam());
+    param->name    = "TopK";
+    param->axis    = axis;
+    param->k       = k;
+    param->largest = largest;
+    param->sorted  = sorted;
+
+    // random inputs are continuous so that no ties make the order of indices ambiguous
+    ensure_input_positive_ = 1;
+
+    // generate interpreter
+    std::vector<int> input_dims = {batch, channel, input_size, input_size};
+    auto interpreter            = GenerateInterpreter("TopK", {input_dims}, param, nullptr, 2);
+    Run(interpreter);
+}
+
+}  // namespace TNN_NS
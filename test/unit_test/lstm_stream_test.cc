@@ -0,0 +1,102 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/lstm_stream_test.h"
+
+#include <cmath>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+Status LSTMStreamTest::ForwardChunk(std::shared_ptr<Instance> instance, const float* x, float* y) {
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    Blob* input  = input_blobs["input0"];
+    Blob* output = output_blobs["output0"];
+    if (!input || !output) {
+        return Status(TNNERR_NULL_PARAM, "blob not found");
+    }
+
+    // x86 blobs live in host memory
+    memcpy(input->GetHandle().base, x, DimsVectorUtils::Count(input->GetBlobDesc().dims) * sizeof(float));
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+    memcpy(y, output->GetHandle().base, DimsVectorUtils::Count(output->GetBlobDesc().dims) * sizeof(float));
+    return TNN_OK;
+}
+
+INSTANTIATE_TEST_SUITE_P(LSTMStreamTest, LSTMStreamTest,
+                         ::testing::Combine(testing::Values(1, 2, 8),    // batch, the small ones run the gemv
+                                            testing::Values(3, 16)));   // hidden_size
+
+TEST_P(LSTMStreamTest, LSTMStreamTest) {
+    const int batch       = std::get<0>(GetParam());
+    const int hidden_size = std::get<1>(GetParam());
+    const int seq_len     = 8;
+    const int input_size  = 5;
+    DeviceType dev        = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<LSTMONNXLayerParam> param(new LSTMONNXLayerParam());
+    param->name        = "LSTMONNX";
+    param->hidden_size = hidden_size;
+    param->direction   = 0;
+    DimsVector x_dims  = {seq_len, batch, input_size};
+    auto interpreter   = GenerateInterpreter("LSTMONNX",
+                                             {x_dims, {1, 4 * hidden_size, input_size},
+                                              {1, 4 * hidden_size, hidden_size}, {1, 8 * hidden_size}},
+                                             param, nullptr, 3);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    ModelConfig model_config;
+    NetworkConfig config;
+    config.device_type = dev;
+    config.precision   = PRECISION_HIGH;
+    auto instance_full = std::make_shared<Instance>(config, model_config);
+    ASSERT_TRUE(instance_full->Init(interpreter, InputShapesMap()) == TNN_OK);
+
+    // the stream instance shares the weights generated for the full instance
+    config.enable_stateful_recurrence = true;
+    DimsVector chunk_dims             = {seq_len / 2, batch, input_size};
+    auto instance_stream              = std::make_shared<Instance>(config, model_config);
+    ASSERT_TRUE(instance_stream->Init(instance_full->GetInterpreter(), {{"input0", chunk_dims}}) == TNN_OK);
+
+    const int x_count     = DimsVectorUtils::Count(x_dims);
+    const int y_count     = seq_len * batch * hidden_size;
+    std::vector<float> x(x_count), y_full(y_count), y_stream(y_count), y_reset(y_count / 2);
+    for (int i = 0; i < x_count; ++i) {
+        x[i] = sin(0.37f * i);
+    }
+
+    ASSERT_TRUE(ForwardChunk(instance_full, x.data(), y_full.data()) == TNN_OK);
+    ASSERT_TRUE(ForwardChunk(instance_stream, x.data(), y_stream.data()) == TNN_OK);
+    ASSERT_TRUE(ForwardChunk(instance_stream, x.data() + x_count / 2, y_stream.data() + y_count / 2) == TNN_OK);
+    for (int i = 0; i < y_count; ++i) {
+        EXPECT_NEAR(y_stream[i], y_full[i], 1e-4);
+    }
+
+    // a new stream starts from zero state again
+    ASSERT_TRUE(instance_stream->ResetRecurrentState() == TNN_OK);
+    ASSERT_TRUE(ForwardChunk(instance_stream, x.data(), y_reset.data()) == TNN_OK);
+    for (int i = 0; i < y_count / 2; ++i) {
+        EXPECT_NEAR(y_reset[i], y_full[i], 1e-4);
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,185 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/reshape_cache_test.h"
+
+#include <algorithm>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static const int kChannel = 4;
+
+std::shared_ptr<AbstractModelInterpreter> ReshapeCacheTest::GenerateNetInterpreter() {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+
+    NetStructure* net_structure          = interpreter->GetNetStructure();
+    net_structure->inputs_shape_map["x"] = {1, kChannel, 8, 8};
+    net_structure->blobs.insert("x");
+
+    // SAME padding is computed from the input shape when the layer is reshaped
+    auto pool_param            = std::make_shared<PoolingLayerParam>();
+    pool_param->name           = "pool";
+    pool_param->type           = "Pooling";
+    pool_param->pool_type      = 0;
+    pool_param->pad_type       = 0;
+    pool_param->kernels_params = {3, 3};
+    pool_param->kernels        = {3, 3};
+    pool_param->strides        = {2, 2};
+    pool_param->pads           = {0, 0, 0, 0};
+    pool_param->kernel_indexs  = {-1, -1};
+
+    auto pool_info      = std::make_shared<LayerInfo>();
+    pool_info->type     = LAYER_POOLING;
+    pool_info->type_str = "Pooling";
+    pool_info->name     = "pool";
+    pool_info->inputs   = {"x"};
+    pool_info->outputs  = {"pool"};
+    pool_info->param    = pool_param;
+    net_structure->layers.push_back(pool_info);
+    net_structure->blobs.insert("pool");
+
+    auto sigmoid_param  = std::make_shared<LayerParam>();
+    sigmoid_param->name = "output";
+    sigmoid_param->type = "Sigmoid";
+
+    auto sigmoid_info      = std::make_shared<LayerInfo>();
+    sigmoid_info->type     = LAYER_SIGMOID;
+    sigmoid_info->type_str = "Sigmoid";
+    sigmoid_info->name     = "output";
+    sigmoid_info->inputs   = {"pool"};
+    sigmoid_info->outputs  = {"output"};
+    sigmoid_info->param    = sigmoid_param;
+    net_structure->layers.push_back(sigmoid_info);
+    net_structure->blobs.insert("output");
+    net_structure->outputs.insert("output");
+
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+Status ReshapeCacheTest::Forward(std::shared_ptr<Instance> instance, std::vector<float>& input,
+                                 std::vector<float>& output) {
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    void* command_queue;
+    instance->GetCommandQueue(&command_queue);
+
+    auto input_blob = input_blobs["x"];
+    Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, input_blob->GetBlobDesc().dims, input.data());
+    BlobConverter input_converter(input_blob);
+    RETURN_ON_NEQ(input_converter.ConvertFromMat(input_mat, MatConvertParam(), command_queue), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    auto output_blob = output_blobs["output"];
+    auto dims        = output_blob->GetBlobDesc().dims;
+    output.resize(DimsVectorUtils::Count(dims));
+    Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, output.data());
+    BlobConverter output_converter(output_blob);
+    return output_converter.ConvertToMat(output_mat, MatConvertParam(), command_queue);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReshapeCacheTest, ReshapeCacheTest, testing::Values(1, 2, 8));
+
+TEST_P(ReshapeCacheTest, ReshapeCacheTest) {
+    const int capacity = GetParam();
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86 && dev != DEVICE_NAIVE && dev != DEVICE_ARM) {
+        GTEST_SKIP();
+    }
+
+    auto interpreter = GenerateNetInterpreter();
+    ASSERT_TRUE(interpreter != nullptr);
+
+    // odd and even sizes pad differently
+    std::vector<DimsVector> shapes = {{2, kChannel, 24, 24}, {1, kChannel, 7, 9}, {2, kChannel, 16, 11}};
+    std::vector<int> sequence      = {1, 0, 2, 1, 2, 2};
+
+    ModelConfig model_config;
+    NetworkConfig config;
+    config.device_type            = dev;
+    config.precision              = PRECISION_HIGH;
+    config.reshape_cache_capacity = capacity;
+    auto instance                 = std::make_shared<Instance>(config, model_config);
+    ASSERT_TRUE(instance->Init(interpreter, {{"x", {1, kChannel, 4, 4}}}, {{"x", shapes[0]}}) == TNN_OK);
+
+    config.reshape_cache_capacity = 0;
+    std::vector<std::shared_ptr<Instance>> references;
+    for (const auto& shape : shapes) {
+        auto reference = std::make_shared<Instance>(config, model_config);
+        ASSERT_TRUE(reference->Init(interpreter, {{"x", shape}}) == TNN_OK);
+        references.push_back(reference);
+    }
+
+    // the instance starts with the max shape
+    for (int index : sequence) {
+        ASSERT_TRUE(instance->Reshape({{"x", shapes[index]}}) == TNN_OK);
+
+        std::vector<float> input(DimsVectorUtils::Count(shapes[index]));
+        InitRandom(input.data(), input.size(), -2.0f, 2.0f);
+        std::vector<float> output, expected;
+        ASSERT_TRUE(Forward(instance, input, output) == TNN_OK);
+        ASSERT_TRUE(Forward(references[index], input, expected) == TNN_OK);
+        ASSERT_EQ(output.size(), expected.size());
+        for (int i = 0; i < expected.size(); ++i) {
+            EXPECT_FLOAT_EQ(output[i], expected[i]);
+        }
+    }
+
+    // replay the lru order to get the expected counters, reshaping to the current shape is a no-op
+    std::vector<int> order = {0};
+    std::vector<int> hits(shapes.size(), 0), misses(shapes.size(), 0);
+    misses[0]   = 1;
+    int current = 0;
+    for (int index : sequence) {
+        if (index == current) {
+            continue;
+        }
+        current   = index;
+        auto iter = std::find(order.begin(), order.end(), index);
+        if (iter != order.end()) {
+            hits[index]++;
+            order.erase(iter);
+        } else {
+            misses[index]++;
+        }
+        order.insert(order.begin(), index);
+        if (order.size() > capacity) {
+            order.pop_back();
+        }
+    }
+
+    std::vector<ReshapeCacheStat> stats;
+    ASSERT_TRUE(instance->GetReshapeCacheStats(stats) == TNN_OK);
+    ASSERT_EQ(stats.size(), shapes.size());
+    for (int s = 0; s < shapes.size(); ++s) {
+        auto iter = std::find_if(stats.begin(), stats.end(), [&](const ReshapeCacheStat& stat) {
+            return DimsVectorUtils::Equal(stat.shapes.at("x"), shapes[s]);
+        });
+        ASSERT_TRUE(iter != stats.end());
+        EXPECT_EQ(iter->hits, hits[s]);
+        EXPECT_EQ(iter->misses, misses[s]);
+        EXPECT_EQ(iter->cached, std::find(order.begin(), order.end(), s) != order.end());
+    }
+}
+
+}  // namespace TNN_NS
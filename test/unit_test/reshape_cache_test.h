@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_TEST_UNIT_TEST_RESHAPE_CACHE_TEST_H_
+#define TNN_TEST_UNIT_TEST_RESHAPE_CACHE_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// reshapes a network with SAME padded pooling between a few input shapes with the reshape cache
+// enabled, each forward must match a network initialized with that shape. params: capacity
+class ReshapeCacheTest : public ::testing::TestWithParam<int> {
+protected:
+    std::shared_ptr<AbstractModelInterpreter> GenerateNetInterpreter();
+
+    Status Forward(std::shared_ptr<Instance> instance, std::vector<float>& input, std::vector<float>& output);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_RESHAPE_CACHE_TEST_H_
@@ -0,0 +1,300 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "test/unit_test/transformer_fusion_test.h"
+
+#include <cmath>
+#include <random>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+static const int kSeqLen   = 6;
+static const int kHidden   = 16;
+static const int kHeads    = 2;
+static const int kHeadSize = 8;
+
+static RawBuffer ElementBuffer(const std::vector<float>& values, DimsVector dims) {
+    RawBuffer buffer(values.size() * sizeof(float), (char*)values.data());
+    buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer.SetBufferDims(dims);
+    return buffer;
+}
+
+static RawBuffer RandomBuffer(std::mt19937& rng, DimsVector dims, float low, float high) {
+    std::uniform_real_distribution<float> dist(low, high);
+    std::vector<float> values(DimsVectorUtils::Count(dims));
+    for (auto& value : values) {
+        value = dist(rng);
+    }
+    return ElementBuffer(values, dims);
+}
+
+static void AddLayer(NetStructure* net_structure, LayerType type, std::string type_str, std::string name,
+                     std::vector<std::string> inputs, std::shared_ptr<LayerParam> param) {
+    auto layer_info      = std::make_shared<LayerInfo>();
+    layer_info->type     = type;
+    layer_info->type_str = type_str;
+    layer_info->name     = name;
+    layer_info->inputs   = inputs;
+    layer_info->outputs  = {name};
+    param->name          = name;
+    param->type          = type_str;
+    layer_info->param    = param;
+    net_structure->layers.push_back(layer_info);
+    net_structure->blobs.insert(name);
+}
+
+// binary layer with a constant operand kept in the layer resource, the form onnx2tnn emits
+static void AddElementLayer(NetStructure* net_structure, NetResource* net_resource, LayerType type,
+                            std::string type_str, std::string name, std::string input, RawBuffer element,
+                            int weight_input_index = 1) {
+    auto param                = std::make_shared<MultidirBroadcastLayerParam>();
+    param->weight_input_index = weight_input_index;
+    AddLayer(net_structure, type, type_str, name, {input}, param);
+
+    auto resource            = std::make_shared<EltwiseLayerResource>();
+    resource->element_shape  = element.GetBufferDims();
+    resource->element_handle = element;
+    net_resource->resource_map[name] = resource;
+}
+
+static void AddReduceMean(NetStructure* net_structure, std::string name, std::string input) {
+    auto param       = std::make_shared<ReduceLayerParam>();
+    param->axis      = {-1};
+    param->keep_dims = 1;
+    AddLayer(net_structure, LAYER_REDUCE_MEAN, "ReduceMean", name, {input}, param);
+}
+
+std::shared_ptr<AbstractModelInterpreter> TransformerFusionTest::GenerateNetInterpreter(int batch, bool has_mask,
+                                                                                        int variant) {
+    auto interpreter = dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    if (!interpreter) {
+        return nullptr;
+    }
+
+    NetStructure* net_structure = interpreter->GetNetStructure();
+    NetResource* net_resource   = interpreter->GetNetResource();
+    std::map<std::string, DimsVector> input_dims = {{"x", {batch, kSeqLen, kHidden}},
+                                                    {"q", {batch, kHeads, kSeqLen, kHeadSize}},
+                                                    {"k", {batch, kHeads, kHeadSize, kSeqLen}}};
+    if (has_mask) {
+        input_dims["mask"] = {batch, 1, 1, kSeqLen};
+    }
+    for (const auto& iter : input_dims) {
+        net_structure->inputs_shape_map[iter.first] = iter.second;
+        net_structure->blobs.insert(iter.first);
+    }
+
+    std::mt19937 rng(batch * 10 + variant);
+
+    // layer norm over the hidden axis
+    AddReduceMean(net_structure, "ln_mean", "x");
+    AddLayer(net_structure, LAYER_SUB, "Sub", "ln_sub", {"x", "ln_mean"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+    if (variant == 0) {
+        auto pow_param      = std::make_shared<PowLayerParam>();
+        pow_param->exponent = 2.0f;
+        AddLayer(net_structure, LAYER_POWER, "Power", "ln_pow", {"ln_sub"}, pow_param);
+    } else {
+        AddLayer(net_structure, LAYER_MUL, "Mul", "ln_pow", {"ln_sub", "ln_sub"},
+                 std::make_shared<MultidirBroadcastLayerParam>());
+    }
+    AddReduceMean(net_structure, "ln_var", "ln_pow");
+    AddElementLayer(net_structure, net_resource, LAYER_ADD, "Add", "ln_eps", "ln_var", ElementBuffer({1e-5f}, {1}));
+    AddLayer(net_structure, LAYER_SQRT, "Sqrt", "ln_std", {"ln_eps"}, std::make_shared<LayerParam>());
+    AddLayer(net_structure, LAYER_DIV, "Div", "ln_div", {"ln_sub", "ln_std"},
+             std::make_shared<MultidirBroadcastLayerParam>());
+    AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "ln_gamma", "ln_div",
+                    RandomBuffer(rng, {kHidden}, 0.5f, 1.5f));
+    AddElementLayer(net_structure, net_resource, LAYER_ADD, "Add", "ln_out", "ln_gamma",
+                    RandomBuffer(rng, {kHidden}, -0.5f, 0.5f));
+
+    // erf gelu, x * 0.5 * (1 + erf(x / sqrt(2)))
+    if (variant == 0) {
+        AddElementLayer(net_structure, net_resource, LAYER_DIV, "Div", "gelu_scale", "ln_out",
+                        ElementBuffer({1.4142135f}, {1}));
+    } else {
+        AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "gelu_scale", "ln_out",
+                        ElementBuffer({0.70710678f}, {1}));
+    }
+    AddLayer(net_structure, LAYER_ERF, "Erf", "gelu_erf", {"gelu_scale"}, std::make_shared<LayerParam>());
+    AddElementLayer(net_structure, net_resource, LAYER_ADD, "Add", "gelu_shift", "gelu_erf",
+                    ElementBuffer({1.0f}, {1}));
+    if (variant == 0) {
+        AddLayer(net_structure, LAYER_MUL, "Mul", "gelu_mul", {"ln_out", "gelu_shift"},
+                 std::make_shared<MultidirBroadcastLayerParam>());
+        AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "output0", "gelu_mul",
+                        ElementBuffer({0.5f}, {1}));
+    } else {
+        AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "gelu_half", "ln_out",
+                        ElementBuffer({0.5f}, {1}));
+        AddLayer(net_structure, LAYER_MUL, "Mul", "output0", {"gelu_shift", "gelu_half"},
+                 std::make_shared<MultidirBroadcastLayerParam>());
+    }
+
+    // the gelu output split into heads is the value of the attention
+    auto reshape_param      = std::make_shared<ReshapeLayerParam>();
+    reshape_param->shape    = {0, 0, kHeads, kHeadSize};
+    reshape_param->num_axes = 4;
+    AddLayer(net_structure, LAYER_RESHAPE, "Reshape", "v_reshape", {"output0"}, reshape_param);
+    auto permute_param    = std::make_shared<PermuteLayerParam>();
+    permute_param->orders = {0, 2, 1, 3};
+    AddLayer(net_structure, LAYER_PERMUTE, "Permute", "v", {"v_reshape"}, permute_param);
+
+    // scaled dot-product attention
+    AddLayer(net_structure, LAYER_MATMUL, "MatMul", "attn_scores", {"q", "k"}, std::make_shared<MatMulLayerParam>());
+    if (variant == 0) {
+        AddElementLayer(net_structure, net_resource, LAYER_DIV, "Div", "attn_scaled", "attn_scores",
+                        ElementBuffer({std::sqrt((float)kHeadSize)}, {1}));
+    } else {
+        AddElementLayer(net_structure, net_resource, LAYER_MUL, "Mul", "attn_scaled", "attn_scores",
+                        ElementBuffer({1.0f / std::sqrt((float)kHeadSize)}, {1}));
+    }
+    std::string softmax_input = "attn_scaled";
+    if (has_mask) {
+        AddLayer(net_structure, LAYER_ADD, "Add", "attn_masked", {"attn_scaled", "mask"},
+                 std::make_shared<MultidirBroadcastLayerParam>());
+        softmax_input = "attn_masked";
+    }
+    auto softmax_param  = std::make_shared<SoftmaxLayerParam>();
+    softmax_param->axis = 3;
+    AddLayer(net_structure, LAYER_SOFTMAX, "SoftmaxCaffe", "attn_probs", {softmax_input}, softmax_param);
+    AddLayer(net_structure, LAYER_MATMUL, "MatMul", "output1", {"attn_probs", "v"},
+             std::make_shared<MatMulLayerParam>());
+
+    net_structure->outputs.insert("output0");
+    net_structure->outputs.insert("output1");
+
+    return std::shared_ptr<AbstractModelInterpreter>(interpreter);
+}
+
+Status TransformerFusionTest::Run(DeviceType device_type, std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                  std::map<std::string, std::vector<float>>& input_data,
+                                  std::map<std::string, std::vector<float>>& output_data) {
+    NetworkConfig config;
+    config.device_type = device_type;
+    config.precision   = PRECISION_HIGH;
+    ModelConfig model_config;
+    auto instance = std::make_shared<Instance>(config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    void* command_queue;
+    instance->GetCommandQueue(&command_queue);
+
+    for (auto& iter : input_data) {
+        auto blob = input_blobs[iter.first];
+        if (!blob) {
+            return Status(TNNERR_NULL_PARAM, "input blob not found");
+        }
+        Mat input_mat(DEVICE_NAIVE, NCHW_FLOAT, blob->GetBlobDesc().dims, iter.second.data());
+        BlobConverter input_converter(blob);
+        RETURN_ON_NEQ(input_converter.ConvertFromMat(input_mat, MatConvertParam(), command_queue), TNN_OK);
+    }
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    for (auto& iter : output_blobs) {
+        auto dims = iter.second->GetBlobDesc().dims;
+        auto& data = output_data[iter.first];
+        data.resize(DimsVectorUtils::Count(dims));
+        Mat output_mat(DEVICE_NAIVE, NCHW_FLOAT, dims, data.data());
+        BlobConverter output_converter(iter.second);
+        RETURN_ON_NEQ(output_converter.ConvertToMat(output_mat, MatConvertParam(), command_queue), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+INSTANTIATE_TEST_SUITE_P(TransformerFusionTest, TransformerFusionTest,
+                         ::testing::Combine(
+                             // batch
+                             testing::Values(1, 2),
+                             // mask
+                             testing::Values(false, true),
+                             // variant of the decomposed ops
+                             testing::Values(0, 1)));
+
+TEST_P(TransformerFusionTest, TransformerFusionTest) {
+    const int batch     = std::get<0>(GetParam());
+    const bool has_mask = std::get<1>(GetParam());
+    const int variant   = std::get<2>(GetParam());
+    if (ConvertDeviceType(FLAGS_dt) != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    // the decomposed subgraphs are replaced by the fused layers
+    {
+        auto interpreter = GenerateNetInterpreter(batch, has_mask, variant);
+        ASSERT_TRUE(interpreter != nullptr);
+        auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+        auto optimizer = optimizer::NetOptimizerManager::GetNetOptimizerByName(kNetOptimizerFuseTransformer);
+        ASSERT_TRUE(optimizer != nullptr);
+        ASSERT_TRUE(optimizer->Optimize(default_interpreter->GetNetStructure(), default_interpreter->GetNetResource()) ==
+                    TNN_OK);
+
+        std::map<LayerType, int> layer_count;
+        for (auto layer : default_interpreter->GetNetStructure()->layers) {
+            layer_count[layer->type]++;
+        }
+        EXPECT_EQ(layer_count[LAYER_LAYER_NORM], 1);
+        EXPECT_EQ(layer_count[LAYER_GELU], 1);
+        EXPECT_EQ(layer_count[LAYER_MULTI_HEAD_ATTENTION], 1);
+        EXPECT_EQ(layer_count[LAYER_REDUCE_MEAN], 0);
+        EXPECT_EQ(layer_count[LAYER_ERF], 0);
+        EXPECT_EQ(layer_count[LAYER_SOFTMAX], 0);
+        EXPECT_EQ(layer_count[LAYER_MATMUL], 0);
+    }
+
+    std::map<std::string, std::vector<float>> input_data;
+    input_data["x"] = std::vector<float>(batch * kSeqLen * kHidden);
+    input_data["q"] = std::vector<float>(batch * kHeads * kSeqLen * kHeadSize);
+    input_data["k"] = std::vector<float>(batch * kHeads * kHeadSize * kSeqLen);
+    if (has_mask) {
+        input_data["mask"] = std::vector<float>(batch * kSeqLen);
+    }
+    for (auto& iter : input_data) {
+        InitRandom(iter.second.data(), iter.second.size(), -2.0f, 2.0f);
+    }
+    if (has_mask) {
+        // padded keys of an attention mask
+        input_data["mask"][kSeqLen - 1] = -10000.0f;
+    }
+
+    std::map<std::string, std::vector<float>> fused_output, reference_output;
+    ASSERT_TRUE(Run(DEVICE_X86, GenerateNetInterpreter(batch, has_mask, variant), input_data, fused_output) == TNN_OK);
+    ASSERT_TRUE(Run(DEVICE_NAIVE, GenerateNetInterpreter(batch, has_mask, variant), input_data, reference_output) ==
+                TNN_OK);
+
+    for (const std::string name : {"output0", "output1"}) {
+        auto& fused     = fused_output[name];
+        auto& reference = reference_output[name];
+        ASSERT_EQ(fused.size(), reference.size());
+        ASSERT_FALSE(fused.empty());
+        for (int i = 0; i < reference.size(); ++i) {
+            EXPECT_NEAR(fused[i], reference[i], 1e-3 * std::max(1.0f, std::fabs(reference[i])));
+        }
+    }
+}
+
+}  // namespace TNN_NS
@@ -14,8 +14,10 @@
 
 #include "calibration.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <random>
+#include <thread>
 #include "file_reader.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/tnn.h"
@@ -98,13 +100,14 @@ Calibration::Calibration() {}
 Calibration::~Calibration() {}
 
 Status Calibration::Init(NetworkConfig& net_config, ModelConfig& model_config, InputShapesMap inputs_shape) {
-    TNN tnn;
-    Status status = tnn.Init(model_config);
+    tnn_          = std::make_shared<TNN>();
+    Status status = tnn_->Init(model_config);
     if (status != TNN_OK) {
         LOGE("tnn init failed!\n");
         return TNNERR_INVALID_MODEL;
     }
-    instance_ = tnn.CreateInst(net_config, status);
+    net_config_ = net_config;
+    instance_   = tnn_->CreateInst(net_config, status);
     if (status != TNN_OK) {
         LOGE("tnn create instance failed!\n");
         return TNNERR_INST_ERR;
@@ -186,37 +189,53 @@ int Calibration::CalBlobScale(DataSet& dataset) {
     printf("Start to calculate blob scale ...\n");
     NetResource* net_resource = interpreter_->GetNetResource();
 
-    Status status = instance_->Reshape(dataset.input_shape);
-    if (status != TNN_OK) {
-        LOGE("instance reshape failed!\n");
-        return -1;
+    int ret = InitInstances(dataset);
+    if (ret != 0) {
+        LOGE("init calibration instances failed!\n");
+        return ret;
     }
 
     // Init Feature map
-    int ret = InitFeatureMap();
-    if (ret != 0) {
-        LOGE("init feautre map for quantize failed!\n");
-        return ret;
+    feature_maps_.clear();
+    feature_maps_.resize(instances_.size());
+    for (int i = 0; i < instances_.size(); ++i) {
+        ret = InitFeatureMap(instances_[i], feature_maps_[i]);
+        if (ret != 0) {
+            LOGE("init feautre map for quantize failed!\n");
+            return ret;
+        }
     }
+    feature_map_ = feature_maps_[0];
     printf("\tInit Feature Map done!\n");
 
-    // Collect the Range of Feature map
-    ret = UpdateBlobRange(dataset);
-    if (ret != 0) {
-        LOGE("collect feautre map range failed!\n");
-        return ret;
-    }
-    printf("\tCollect Blob Range done!\n");
+    if (cali_params_.single_pass) {
+        // Collect the Range and Distribute of Feature map at once
+        ret = UpdateBlobRangeAndDistribute(dataset);
+        if (ret != 0) {
+            LOGE("collect feautre map range and distribute failed!\n");
+            return ret;
+        }
+        printf("\tCollect Blob Range and Distribution done!\n");
+    } else {
+        // Collect the Range of Feature map
+        ret = UpdateBlobRange(dataset);
+        if (ret != 0) {
+            LOGE("collect feautre map range failed!\n");
+            return ret;
+        }
+        printf("\tCollect Blob Range done!\n");
 
-    // Calculate Distribute of Feature map
-    ret = UpdateBlobDistribute(dataset);
-    if (ret != 0) {
-        LOGE("update feautre map distribute failed!\n");
-        return ret;
+        // Calculate Distribute of Feature map
+        ret = UpdateBlobDistribute(dataset);
+        if (ret != 0) {
+            LOGE("update feautre map distribute failed!\n");
+            return ret;
+        }
+        printf("\tCollect Blob Distribution done!\n");
     }
-    printf("\tCollect Blob Distribution done!\n");
 
     // Compute Scale of Feature map and save to resource map
+    int blob_index = 0;
     for (auto& item : feature_map_) {
         std::vector<float> scale_vec;
         std::vector<int8_t> zero_point_vec;
@@ -230,50 +249,77 @@ int Calibration::CalBlobScale(DataSet& dataset) {
         LayerResource* blob_scale_res;
         blob_scale_res = CreateIntScale(scale_vec, zero_point_vec);
         net_resource->resource_map[input_scale_name] = std::shared_ptr<LayerResource>(blob_scale_res);
-        printf("\t====> Calculate (%s) done!\n", input_scale_name.c_str());
+        printf("\t====> Calculate (%s) done! (%d / %d)\n", input_scale_name.c_str(), ++blob_index,
+               (int)feature_map_.size());
+    }
+
+    return 0;
+}
+
+int Calibration::InitInstances(DataSet& dataset) {
+    // more instances than files would stay idle
+    int num_instances = std::max(1, std::min(cali_params_.num_threads, (int)dataset.file_list.size()));
+
+    instances_.clear();
+    instances_.push_back(instance_);
+    for (int i = 1; i < num_instances; ++i) {
+        Status status;
+        auto instance = tnn_->CreateInst(net_config_, status);
+        if (status != TNN_OK || instance == nullptr) {
+            LOGE("tnn create instance failed!\n");
+            return -1;
+        }
+        instances_.push_back(instance);
     }
 
+    for (auto instance : instances_) {
+        Status status = instance->Reshape(dataset.input_shape);
+        if (status != TNN_OK) {
+            LOGE("instance reshape failed!\n");
+            return -1;
+        }
+    }
     return 0;
 }
 
-int Calibration::InitFeatureMap() {
-    feature_map_.clear();
+int Calibration::InitFeatureMap(std::shared_ptr<Instance> instance, FeatureMap& feature_map) {
+    feature_map.clear();
 
     BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
         LayerType layer_type = info->type;
         if (kQuantizedLayerTypeStr.find(layer_type) != kQuantizedLayerTypeStr.end() ||
             kBlobScaleMergeLayerTypeStr.find(layer_type) != kBlobScaleMergeLayerTypeStr.end()) {
             for (auto blob : blobs) {
-                if (feature_map_.find(blob) == feature_map_.end()) {
+                if (feature_map.find(blob) == feature_map.end()) {
                     std::shared_ptr<ScaleCalculator> scale_cal(new ScaleCalculator());
                     if (scale_cal->Init(blob, cali_params_.merge_blob_channel, cali_params_.blob_quantize_method) ==
                         0) {
-                        feature_map_[blob] = scale_cal;
+                        feature_map[blob] = scale_cal;
                     }
                 }
 
                 // set FC layer input and output blob to merge channel
                 if (layer_type == LAYER_INNER_PRODUCT) {
-                    if (feature_map_.find(blob) != feature_map_.end()) {
-                        feature_map_[blob]->SetMergeChannel(true);
+                    if (feature_map.find(blob) != feature_map.end()) {
+                        feature_map[blob]->SetMergeChannel(true);
                     }
                 }
             }
         }
     };
 
-    instance_->ForwardWithCallback(func, func);
+    instance->ForwardWithCallback(func, func);
 
     // set input blob quantize method to MIN_MAX
     BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
+    Status status = instance->GetAllInputBlobs(input_blobs);
     if (status != TNN_OK) {
         LOGE("instance get input blobs failed!\n");
         return -1;
     }
     for (auto item : input_blobs) {
-        if (feature_map_.find(item.second) != feature_map_.end()) {
-            feature_map_[item.second]->SetQuantizeMethod(MIN_MAX);
+        if (feature_map.find(item.second) != feature_map.end()) {
+            feature_map[item.second]->SetQuantizeMethod(MIN_MAX);
         }
     }
 
@@ -281,49 +327,91 @@ int Calibration::InitFeatureMap() {
 }
 
 int Calibration::UpdateBlobRange(DataSet& dataset) {
-    BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
-    if (status != TNN_OK) {
-        LOGE("instance get input blobs failed!\n");
-        return -1;
+    int ret = RunDataSet(dataset, STAGE_RANGE);
+    if (ret != 0) {
+        return ret;
     }
-    Blob* input_blob = input_blobs.begin()->second;
+    return MergeFeatureMaps(STAGE_RANGE);
+}
 
-    BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
-        for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateRange();
-            }
+int Calibration::UpdateBlobDistribute(DataSet& dataset) {
+    bool need_distribute = false;
+    for (auto& feature_map : feature_maps_) {
+        for (auto& item : feature_map) {
+            item.second->ResetDistribute();
+            need_distribute |= item.second->NeedDistribute();
         }
-    };
+    }
 
-    FileReader file_reader;
-    file_reader.SetBiasValue(cali_params_.input_bias);
-    file_reader.SetScaleValue(cali_params_.input_scale);
-    file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto item : feature_map_) {
-            item.second->ClearRangeFlag();
-        }
+    // the scales of min max methods only depend on the range
+    if (!need_distribute) {
+        return 0;
+    }
 
-        status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
-        if (status != TNN_OK) {
-            LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+    int ret = RunDataSet(dataset, STAGE_DISTRIBUTE);
+    if (ret != 0) {
+        return ret;
+    }
+    return MergeFeatureMaps(STAGE_DISTRIBUTE);
+}
+
+int Calibration::UpdateBlobRangeAndDistribute(DataSet& dataset) {
+    for (auto& feature_map : feature_maps_) {
+        for (auto& item : feature_map) {
+            item.second->SetAdaptiveDistribute(item.second->NeedDistribute());
+            item.second->ResetDistribute();
         }
-        instance_->ForwardWithCallback(func, func);
     }
 
+    int ret = RunDataSet(dataset, STAGE_RANGE_AND_DISTRIBUTE);
+    if (ret != 0) {
+        return ret;
+    }
+    ret = MergeFeatureMaps(STAGE_RANGE_AND_DISTRIBUTE);
+    if (ret != 0) {
+        return ret;
+    }
+
+    // the scales of min max methods are computed on the exact range
+    for (auto& item : feature_map_) {
+        if (!item.second->NeedDistribute()) {
+            item.second->ResetDistribute();
+        }
+    }
     return 0;
 }
 
-int Calibration::UpdateBlobDistribute(DataSet& dataset) {
-    for (auto& item : feature_map_) {
-        item.second->ResetDistribute();
+int Calibration::RunDataSet(DataSet& dataset, CalibrationStage stage) {
+    progress_count_ = 0;
+    auto start      = std::chrono::steady_clock::now();
+
+    std::vector<int> results(instances_.size(), 0);
+    std::vector<std::thread> workers;
+    for (int i = 1; i < instances_.size(); ++i) {
+        workers.emplace_back([&, i]() { results[i] = RunShard(dataset, stage, i); });
     }
+    results[0] = RunShard(dataset, stage, 0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto result : results) {
+        if (result != 0) {
+            return result;
+        }
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("\t\t%d files in %.2f s, %.2f files/s with %d instances\n", (int)dataset.file_list.size(), seconds,
+           dataset.file_list.size() / std::max(seconds, 1e-6), (int)instances_.size());
+    return 0;
+}
+
+int Calibration::RunShard(DataSet& dataset, CalibrationStage stage, int worker_index) {
+    auto instance     = instances_[worker_index];
+    auto& feature_map = feature_maps_[worker_index];
 
     BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
+    Status status = instance->GetAllInputBlobs(input_blobs);
     if (status != TNN_OK) {
         LOGE("instance get input blobs failed!\n");
         return -1;
@@ -332,8 +420,15 @@ int Calibration::UpdateBlobDistribute(DataSet& dataset) {
 
     BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
         for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateDistribute();
+            auto iter = feature_map.find(blob);
+            if (iter == feature_map.end()) {
+                continue;
+            }
+            if (stage != STAGE_DISTRIBUTE) {
+                iter->second->UpdateRange();
+            }
+            if (stage != STAGE_RANGE && iter->second->NeedDistribute()) {
+                iter->second->UpdateDistribute();
             }
         }
     };
@@ -342,22 +437,67 @@ int Calibration::UpdateBlobDistribute(DataSet& dataset) {
     file_reader.SetBiasValue(cali_params_.input_bias);
     file_reader.SetScaleValue(cali_params_.input_scale);
     file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto& item : feature_map_) {
+
+    const int file_count      = dataset.file_list.size();
+    const int report_interval = std::max(1, file_count / 20);
+    for (int i = worker_index; i < file_count; i += instances_.size()) {
+        auto& file_pack = dataset.file_list[i];
+        for (auto& item : feature_map) {
+            item.second->ClearRangeFlag();
             item.second->ClearDistributeFlag();
         }
 
         status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
         if (status != TNN_OK) {
             LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+        } else {
+            instance->ForwardWithCallback(func, func);
+        }
+
+        std::lock_guard<std::mutex> guard(progress_mutex_);
+        progress_count_++;
+        if (progress_count_ % report_interval == 0 || progress_count_ == file_count) {
+            printf("\t\t%d / %d files\n", progress_count_, file_count);
         }
-        instance_->ForwardWithCallback(func, func);
     }
 
     return 0;
 }
 
+int Calibration::MergeFeatureMaps(CalibrationStage stage) {
+    std::map<std::string, std::shared_ptr<ScaleCalculator>> merged;
+    for (auto& item : feature_map_) {
+        merged[item.first->GetBlobDesc().name] = item.second;
+    }
+
+    for (int i = 1; i < feature_maps_.size(); ++i) {
+        for (auto& item : feature_maps_[i]) {
+            auto iter = merged.find(item.first->GetBlobDesc().name);
+            if (iter == merged.end()) {
+                LOGE("blob (%s) is not calibrated by the first instance!\n", item.first->GetBlobDesc().name.c_str());
+                return -1;
+            }
+            if (stage != STAGE_DISTRIBUTE && iter->second->MergeRange(*item.second) != 0) {
+                return -1;
+            }
+            if (stage != STAGE_RANGE && item.second->NeedDistribute() &&
+                iter->second->MergeDistribute(*item.second) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    // the distribute of every instance is collected on the merged range
+    if (stage == STAGE_RANGE) {
+        for (int i = 1; i < feature_maps_.size(); ++i) {
+            for (auto& item : feature_maps_[i]) {
+                item.second->CopyRange(*merged[item.first->GetBlobDesc().name]);
+            }
+        }
+    }
+    return 0;
+}
+
 IntScaleResource* Calibration::CreateIntScale(std::vector<float> scale_vec, std::vector<int8_t> zero_point_vec) {
     IntScaleResource* int8scale = new IntScaleResource();
     // scale
@@ -16,10 +16,12 @@
 #define TNN_TOOLS_QUANTIZATION_CALIBRATION_H_
 
 #include <memory>
+#include <mutex>
 #include "tnn/core/blob.h"
 #include "tnn/core/instance.h"
 #include "tnn/core/layer_type.h"
 #include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 
 #include "calibration_common.h"
@@ -56,10 +58,25 @@ public:
     Status Serialize(std::string proto_path, std::string model_path);
 
 private:
+    typedef std::map<Blob*, std::shared_ptr<ScaleCalculator>> FeatureMap;
+
+    enum CalibrationStage {
+        STAGE_RANGE                = 0,
+        STAGE_DISTRIBUTE           = 1,
+        STAGE_RANGE_AND_DISTRIBUTE = 2,
+    };
+
     int CalBlobScale(DataSet& dataset);
-    int InitFeatureMap();
+    int InitInstances(DataSet& dataset);
+    int InitFeatureMap(std::shared_ptr<Instance> instance, FeatureMap& feature_map);
     int UpdateBlobRange(DataSet& dataset);
     int UpdateBlobDistribute(DataSet& dataset);
+    int UpdateBlobRangeAndDistribute(DataSet& dataset);
+    // run every instance over its shard of the dataset, worker i takes the files i, i + n, ...
+    int RunDataSet(DataSet& dataset, CalibrationStage stage);
+    int RunShard(DataSet& dataset, CalibrationStage stage, int worker_index);
+    // merge the statistics of the other instances into feature_map_
+    int MergeFeatureMaps(CalibrationStage stage);
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec);
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec, std::vector<int8_t> zero_point_vec);
 
@@ -76,10 +93,18 @@ private:
     void MergeBlobScaleRecursion(LayerInfo* layer_info, NetStructure* net_struct, NetResource* net_resource);
     LayerInfo* GetLayerInfoFromOutpubBlobName(std::string blob_name, NetStructure* net_struct);
 
+    std::shared_ptr<TNN> tnn_;
+    NetworkConfig net_config_;
     std::shared_ptr<DefaultModelInterpreter> interpreter_;
     std::shared_ptr<Instance> instance_;
-    std::map<Blob*, std::shared_ptr<ScaleCalculator>> feature_map_;
+    FeatureMap feature_map_;
+    // the instances and feature maps of all workers, the first ones are instance_ and feature_map_
+    std::vector<std::shared_ptr<Instance>> instances_;
+    std::vector<FeatureMap> feature_maps_;
     CalibrationParam cali_params_;
+
+    std::mutex progress_mutex_;
+    int progress_count_ = 0;
 };
 
 }  // namespace TNN_NS
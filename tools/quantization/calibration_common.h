@@ -54,6 +54,11 @@ struct CalibrationParam {
     std::vector<float> input_bias             = {0, 0, 0, 0};
     std::vector<float> input_scale            = {1.0f, 1.0f, 1.0f, 1.0f};
     bool reverse_channel                      = false;
+    // instances calibrating shards of the dataset in parallel
+    int num_threads                           = 1;
+    // collect range and distribute in one pass over the dataset, the distribute range
+    // grows in powers of two, so the histogram may use half of its bins
+    bool single_pass                          = false;
 };
 
 }  // namespace TNN_NS
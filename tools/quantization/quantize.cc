@@ -178,7 +178,7 @@ bool CheckFileName(std::string name) {
 void PrintConfig() {
     printf(
         "usage:\n./quantization_cmd [-h] [-p] <proto file> [-m] <model file> [-i] <input folder> [-b] <val> [-w] <val> "
-        "[-n] <val> [-s] <val> [-t] <val> [-o] <output_name>\n"
+        "[-n] <val> [-s] <val> [-t] <val> [-j] <val> [-a] <val> [-o] <output_name>\n"
         "\t-h, --help        \t show this message\n"
         "\t-p, --proto       \t(require) tnn proto file name\n"
         "\t-m, --model       \t(require) tnn model file name\n"
@@ -207,6 +207,11 @@ void PrintConfig() {
         "\t\t0: per-channel mode  (default)\n"
         "\t\t1: mix mode          weight: per-channel  blob: per-tensor\n"
         "\t\t2: per-tensor mode\n"
+        "\t-j, --threads      \t(optional) number of instances calibrating the input files in parallel, "
+        "default 1\n"
+        "\t-a, --single_pass  \t(optional) collect blob range and distribution in one pass over the input files\n"
+        "\t\t0: two passes, the distribution is collected on the final range  (default)\n"
+        "\t\t1: one pass, the distribution range grows in powers of two\n"
         "\t-o, --output       \t(optional) specify the name of output\n");
 }
 
@@ -228,11 +233,13 @@ int main(int argc, char* argv[]) {
                                     {"bias", required_argument, 0, 'n'},
                                     {"scale", required_argument, 0, 's'},
                                     {"merge_type", required_argument, 0, 't'},
+                                    {"threads", required_argument, 0, 'j'},
+                                    {"single_pass", required_argument, 0, 'a'},
                                     {"output", required_argument, 0, 'o'},
                                     {"help", no_argument, 0, 'h'},
                                     {0, 0, 0, 0}};
 
-    const char* optstring = "p:m:i:b:w:r:n:s:t:o:h";
+    const char* optstring = "p:m:i:b:w:r:n:s:t:j:a:o:h";
 
     if (argc == 1) {
         PrintConfig();
@@ -317,6 +324,14 @@ int main(int argc, char* argv[]) {
                     cali_params.merge_weights_channel = false;
                 }
             } break;
+            case 'j':
+                printf("threads: %s\n", optarg);
+                cali_params.num_threads = std::max(1, atoi(optarg));
+                break;
+            case 'a':
+                printf("single pass: %s\n", optarg);
+                cali_params.single_pass = atoi(optarg) != 0;
+                break;
             case 'o':
                 printf("output name: %s\n", optarg);
                 output_name = optarg;
@@ -41,8 +41,32 @@ static float KlDivergence(const std::vector<float>& dis_ref, const std::vector<f
     return result;
 }
 
+// sum every factor bins into one, the distribute then covers factor times the range
+static void RebinDistribute(std::vector<float>& distribute, int factor) {
+    const int size     = distribute.size();
+    const int new_size = std::max(1, size / factor);
+    for (int j = 0; j < new_size; ++j) {
+        float sum = 0.0f;
+        for (int k = j * factor; k < std::min(size, (j + 1) * factor); ++k) {
+            sum += distribute[k];
+        }
+        distribute[j] = sum;
+    }
+    std::fill(distribute.begin() + new_size, distribute.end(), 1.0e-7);
+}
+
+// the ratio of two distribute ranges, which must be a power of two
+static int RangeFactor(float large_range, float small_range) {
+    int factor = 1;
+    while (small_range * factor < large_range) {
+        factor *= 2;
+    }
+    return small_range * factor == large_range ? factor : -1;
+}
+
 ScaleCalculator::ScaleCalculator() {
     origin_blob_          = nullptr;
+    adaptive_distribute_  = false;
     range_done_flag_      = false;
     distribute_done_flag_ = false;
     bin_nums_             = 2048;
@@ -170,6 +194,14 @@ int ScaleCalculator::UpdateRange() {
 
 int ScaleCalculator::ResetDistribute() {
     for (unsigned int i = 0; i < interval_per_channel_.size(); ++i) {
+        if (adaptive_distribute_) {
+            // the range grows with the data in UpdateDistribute
+            valid_channel_[i]        = false;
+            interval_per_channel_[i] = 0.0f;
+            if (merge_channel_)
+                break;
+            continue;
+        }
         float max_val     = std::max(std::abs(range_per_channel_[i].first), std::abs(range_per_channel_[i].second));
         valid_channel_[i] = max_val > 0.00001;
         if (valid_channel_[i]) {
@@ -204,11 +236,19 @@ int ScaleCalculator::UpdateDistribute() {
             if (merge_channel_) {
                 channel_idx = 0;
             }
+
+            float* p = data_ptr + b * channel * hxw + c * hxw;
+            if (adaptive_distribute_) {
+                float max_val = 0.0f;
+                std::for_each(p, p + hxw, [&](float n) { max_val = std::max(max_val, std::abs(n)); });
+                if (max_val > 0.00001) {
+                    GrowDistribute(channel_idx, max_val);
+                }
+            }
             if (!valid_channel_[channel_idx]) {
                 continue;
             }
 
-            float* p               = data_ptr + b * channel * hxw + c * hxw;
             float* distribute_data = distribute_per_channel_[channel_idx].data();
             for (int i = 0; i < hxw; ++i) {
                 float val = p[i];
@@ -227,6 +267,107 @@ int ScaleCalculator::UpdateDistribute() {
     return 0;
 }
 
+void ScaleCalculator::GrowDistribute(int channel_index, float max_val) {
+    if (!valid_channel_[channel_index]) {
+        valid_channel_[channel_index]        = true;
+        interval_per_channel_[channel_index] = bin_nums_ / std::pow(2.0f, std::ceil(std::log2(max_val)));
+        return;
+    }
+
+    float range = bin_nums_ / interval_per_channel_[channel_index];
+    if (max_val <= range) {
+        return;
+    }
+    int factor = 1;
+    while (range * factor < max_val) {
+        factor *= 2;
+    }
+    RebinDistribute(distribute_per_channel_[channel_index], factor);
+    interval_per_channel_[channel_index] = bin_nums_ / (range * factor);
+}
+
+bool ScaleCalculator::NeedDistribute() {
+    return cali_method_ == KL_DIVERGENCE;
+}
+
+void ScaleCalculator::SetAdaptiveDistribute(bool adaptive) {
+    adaptive_distribute_ = adaptive;
+}
+
+int ScaleCalculator::MergeRange(const ScaleCalculator& other) {
+    if (other.range_per_channel_.size() != range_per_channel_.size()) {
+        LOGE("merge range of different channels!\n");
+        return -1;
+    }
+
+    for (unsigned int c = 0; c < range_per_channel_.size(); ++c) {
+        range_per_channel_[c].first  = std::min(range_per_channel_[c].first, other.range_per_channel_[c].first);
+        range_per_channel_[c].second = std::max(range_per_channel_[c].second, other.range_per_channel_[c].second);
+
+        int index       = index_image_per_channel_[c];
+        int other_index = other.index_image_per_channel_[c];
+        if (index + other_index > 0) {
+            mean_per_channel_[c] =
+                (mean_per_channel_[c] * index + other.mean_per_channel_[c] * other_index) / (index + other_index);
+            mean_abs_per_channel_[c] =
+                (mean_abs_per_channel_[c] * index + other.mean_abs_per_channel_[c] * other_index) /
+                (index + other_index);
+            index_image_per_channel_[c] = index + other_index;
+        }
+    }
+    return 0;
+}
+
+void ScaleCalculator::CopyRange(const ScaleCalculator& other) {
+    range_per_channel_       = other.range_per_channel_;
+    mean_per_channel_        = other.mean_per_channel_;
+    mean_abs_per_channel_    = other.mean_abs_per_channel_;
+    index_image_per_channel_ = other.index_image_per_channel_;
+}
+
+int ScaleCalculator::MergeDistribute(const ScaleCalculator& other) {
+    if (other.distribute_per_channel_.size() != distribute_per_channel_.size()) {
+        LOGE("merge distribute of different channels!\n");
+        return -1;
+    }
+
+    for (unsigned int c = 0; c < distribute_per_channel_.size(); ++c) {
+        if (!other.valid_channel_[c]) {
+            continue;
+        }
+        if (!valid_channel_[c]) {
+            valid_channel_[c]          = true;
+            interval_per_channel_[c]   = other.interval_per_channel_[c];
+            distribute_per_channel_[c] = other.distribute_per_channel_[c];
+            continue;
+        }
+
+        // bring both distributes to the larger range
+        std::vector<float> other_distribute = other.distribute_per_channel_[c];
+        float range       = bin_nums_ / interval_per_channel_[c];
+        float other_range = bin_nums_ / other.interval_per_channel_[c];
+        if (range != other_range) {
+            int factor = range < other_range ? RangeFactor(other_range, range) : RangeFactor(range, other_range);
+            if (factor < 0) {
+                LOGE("merge distribute of incompatible ranges (%f vs %f)!\n", range, other_range);
+                return -1;
+            }
+            if (range < other_range) {
+                RebinDistribute(distribute_per_channel_[c], factor);
+                interval_per_channel_[c] = other.interval_per_channel_[c];
+            } else {
+                RebinDistribute(other_distribute, factor);
+            }
+        }
+
+        auto& distribute = distribute_per_channel_[c];
+        for (int i = 0; i < bin_nums_; ++i) {
+            distribute[i] += other_distribute[i];
+        }
+    }
+    return 0;
+}
+
 int ScaleCalculator::CalculateScale(std::vector<float>& val, std::vector<int8_t>& bias) {
     val.clear();
     bias.clear();
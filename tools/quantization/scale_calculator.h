@@ -64,6 +64,22 @@ public:
     // @brief: update distribute.
     int UpdateDistribute();
 
+    // @brief: true if the scale is searched on the distribute, false if the range is enough.
+    bool NeedDistribute();
+
+    // @brief: grow the distribute range in powers of two while updating, re-binning the
+    // collected distribute, so range and distribute are collected in a single pass.
+    void SetAdaptiveDistribute(bool adaptive);
+
+    // @brief: merge the range collected by another calculator of the same blob.
+    int MergeRange(const ScaleCalculator& other);
+
+    // @brief: replace the range with the one of another calculator of the same blob.
+    void CopyRange(const ScaleCalculator& other);
+
+    // @brief: merge the distribute collected by another calculator of the same blob.
+    int MergeDistribute(const ScaleCalculator& other);
+
     // @brief: get the per-channel scale of the given blob
     int CalculateScale(std::vector<float>& val);
     int CalculateScale(std::vector<float>& val, std::vector<int8_t>& bias);
@@ -74,8 +90,12 @@ private:
     // @brief: analytical-based methods
     int CalculateScaleAnalysis(int channel_index, float& blob_scale, int8_t& bias);
 
+    // @brief: grow the distribute range of channel to cover max_val
+    void GrowDistribute(int channel_index, float max_val);
+
     Blob* origin_blob_;
     bool merge_channel_;
+    bool adaptive_distribute_;
     CalibrationMethod cali_method_;
     int bin_nums_;
     bool range_done_flag_;